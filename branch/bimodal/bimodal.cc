@@ -1,5 +1,7 @@
 #include "bimodal.h"
 
+#include "msl/checkpoint.h"
+
 bool bimodal::predict_branch(champsim::address ip)
 {
   auto value = bimodal_table[hash(ip)];
@@ -10,3 +12,7 @@ void bimodal::last_branch_result(champsim::address ip, champsim::address branch_
 {
   bimodal_table[hash(ip)] += taken ? 1 : -1;
 }
+
+void bimodal::checkpoint_branch_predictor(std::ostream& stream) const { champsim::msl::checkpoint(stream, bimodal_table); }
+
+void bimodal::restore_branch_predictor(std::istream& stream) { champsim::msl::restore(stream, bimodal_table); }
@@ -2,6 +2,8 @@
 #define BRANCH_BIMODAL_H
 
 #include <array>
+#include <istream>
+#include <ostream>
 
 #include "address.h"
 #include "modules.h"
@@ -23,6 +25,8 @@ public:
   // void initialize_branch_predictor();
   bool predict_branch(champsim::address ip);
   void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void checkpoint_branch_predictor(std::ostream& stream) const;
+  void restore_branch_predictor(std::istream& stream);
 };
 
 #endif
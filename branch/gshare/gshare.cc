@@ -1,5 +1,7 @@
 #include "gshare.h"
 
+#include "msl/checkpoint.h"
+
 std::size_t gshare::gs_table_hash(champsim::address ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector)
 {
   constexpr champsim::data::bits LOG2_HISTORY_TABLE_SIZE{champsim::lg2(GS_HISTORY_TABLE_SIZE)};
@@ -29,3 +31,15 @@ void gshare::last_branch_result(champsim::address ip, champsim::address branch_t
   branch_history_vector <<= 1;
   branch_history_vector[0] = taken;
 }
+
+void gshare::checkpoint_branch_predictor(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, branch_history_vector);
+  champsim::msl::checkpoint(stream, gs_history_table);
+}
+
+void gshare::restore_branch_predictor(std::istream& stream)
+{
+  champsim::msl::restore(stream, branch_history_vector);
+  champsim::msl::restore(stream, gs_history_table);
+}
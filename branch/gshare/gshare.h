@@ -3,6 +3,8 @@
 
 #include <array>
 #include <bitset>
+#include <istream>
+#include <ostream>
 
 #include "modules.h"
 #include "msl/fwcounter.h"
@@ -20,6 +22,8 @@ struct gshare : champsim::modules::branch_predictor {
   static std::size_t gs_table_hash(champsim::address ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector);
   bool predict_branch(champsim::address ip);
   void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void checkpoint_branch_predictor(std::ostream& stream) const;
+  void restore_branch_predictor(std::istream& stream);
 };
 
 #endif
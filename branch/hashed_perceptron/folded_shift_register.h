@@ -5,6 +5,7 @@
 
 #include "modules.h"
 #include "msl/bits.h"
+#include "msl/checkpoint.h"
 #include "msl/fwcounter.h"
 #include "util/bit_enum.h"
 
@@ -39,6 +40,9 @@ public:
    *  Insert this value into the shift register
    **/
   void push_back(bool ins);
+
+  void checkpoint(std::ostream& stream) const { champsim::msl::checkpoint(stream, words); }
+  void restore(std::istream& stream) { champsim::msl::restore(stream, words); }
 };
 
 template <champsim::data::bits WORD_LEN>
@@ -100,3 +100,21 @@ void hashed_perceptron::adjust_threshold(bool correct)
     }
   }
 }
+
+void hashed_perceptron::checkpoint_branch_predictor(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, tables);
+  champsim::msl::checkpoint(stream, ghist_words);
+  champsim::msl::checkpoint(stream, theta);
+  champsim::msl::checkpoint(stream, tc);
+  champsim::msl::checkpoint(stream, last_result);
+}
+
+void hashed_perceptron::restore_branch_predictor(std::istream& stream)
+{
+  champsim::msl::restore(stream, tables);
+  champsim::msl::restore(stream, ghist_words);
+  champsim::msl::restore(stream, theta);
+  champsim::msl::restore(stream, tc);
+  champsim::msl::restore(stream, last_result);
+}
@@ -3,6 +3,8 @@
 
 #include <array>
 #include <cstdint>
+#include <istream>
+#include <ostream>
 #include <tuple>
 #include <vector>
 
@@ -51,6 +53,8 @@ public:
   bool predict_branch(champsim::address pc);
   void last_branch_result(champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type);
   void adjust_threshold(bool correct);
+  void checkpoint_branch_predictor(std::ostream& stream) const;
+  void restore_branch_predictor(std::istream& stream);
 };
 
 #endif
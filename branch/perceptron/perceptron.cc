@@ -40,6 +40,8 @@
 
 #include <cmath>
 
+#include "msl/checkpoint.h"
+
 bool perceptron::predict_branch(champsim::address ip)
 {
   // hash the address to get an index into the table of perceptrons
@@ -86,3 +88,19 @@ void perceptron::last_branch_result(champsim::address ip, champsim::address bran
     perceptrons[index].update(taken, history);
   }
 }
+
+void perceptron::checkpoint_branch_predictor(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, perceptrons);
+  champsim::msl::checkpoint(stream, perceptron_state_buf);
+  champsim::msl::checkpoint(stream, spec_global_history);
+  champsim::msl::checkpoint(stream, global_history);
+}
+
+void perceptron::restore_branch_predictor(std::istream& stream)
+{
+  champsim::msl::restore(stream, perceptrons);
+  champsim::msl::restore(stream, perceptron_state_buf);
+  champsim::msl::restore(stream, spec_global_history);
+  champsim::msl::restore(stream, global_history);
+}
@@ -4,6 +4,8 @@
 #include <array>
 #include <bitset>
 #include <deque>
+#include <istream>
+#include <ostream>
 
 #include "modules.h"
 #include "msl/fwcounter.h"
@@ -49,6 +51,8 @@ struct perceptron : champsim::modules::branch_predictor {
 
   bool predict_branch(champsim::address ip);
   void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void checkpoint_branch_predictor(std::ostream& stream) const;
+  void restore_branch_predictor(std::istream& stream);
 };
 
 template <std::size_t HISTLEN, std::size_t BITS>
@@ -9,6 +9,7 @@
 #include "basic_btb.h"
 
 #include "instruction.h"
+#include "msl/checkpoint.h"
 
 std::pair<champsim::address, bool> basic_btb::btb_prediction(champsim::address ip)
 {
@@ -46,3 +47,21 @@ void basic_btb::update_btb(champsim::address ip, champsim::address branch_target
 
   direct.update(ip, branch_target, branch_type);
 }
+
+void basic_btb::checkpoint_btb(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, ras.stack);
+  champsim::msl::checkpoint(stream, ras.call_size_trackers);
+  champsim::msl::checkpoint(stream, indirect.predictor);
+  champsim::msl::checkpoint(stream, indirect.conditional_history);
+  champsim::msl::checkpoint(stream, direct.BTB);
+}
+
+void basic_btb::restore_btb(std::istream& stream)
+{
+  champsim::msl::restore(stream, ras.stack);
+  champsim::msl::restore(stream, ras.call_size_trackers);
+  champsim::msl::restore(stream, indirect.predictor);
+  champsim::msl::restore(stream, indirect.conditional_history);
+  champsim::msl::restore(stream, direct.BTB);
+}
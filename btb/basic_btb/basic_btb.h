@@ -1,6 +1,9 @@
 #ifndef BTB_BASIC_BTB_H
 #define BTB_BASIC_BTB_H
 
+#include <istream>
+#include <ostream>
+
 #include "address.h"
 #include "direct_predictor.h"
 #include "indirect_predictor.h"
@@ -20,6 +23,8 @@ public:
   // void initialize_btb();
   std::pair<champsim::address, bool> btb_prediction(champsim::address ip);
   void update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void checkpoint_btb(std::ostream& stream) const;
+  void restore_btb(std::istream& stream);
 };
 
 #endif
@@ -79,6 +79,7 @@ cache_builder_parts = {
     'fill_latency': '.fill_latency({fill_latency})',
     'max_tag_check': '.tag_bandwidth(champsim::bandwidth::maximum_type{{{max_tag_check}}})',
     'max_fill': '.fill_bandwidth(champsim::bandwidth::maximum_type{{{max_fill}}})',
+    'mrc': '.stack_distance_sample_rate({mrc})',
     '_offset_bits': '.offset_bits(champsim::data::bits{{{_offset_bits}}})',
     'prefetch_activate': '.prefetch_activate({^prefetch_activate_string})',
     '_replacement_data': '.replacement<{^replacement_string}>()',
@@ -152,17 +153,21 @@ def get_cache_builder(elem, ul_pairs):
         ('virtual_prefetch', False): '.reset_virtual_prefetch()'
     }
 
-    uppers = (v for v in ul_pairs if v[0] == elem.get('name'))
+    # Shadows are sized as if they had the upper levels of the cache they shadow
+    uppers = (v for v in ul_pairs if v[0] == elem.get('_shadow_of', elem.get('name')))
     local_params = {
         '^defaults': elem.get('_defaults', ''),
         '^upper_levels_string': vector_string(f'&channels.at({ul_pairs.index(v)})' for v in uppers),
         '^prefetch_activate_string': ', '.join('access_type::'+t for t in elem.get('prefetch_activate',[])),
         '^replacement_string': ', '.join(f'class {k["class"]}' for k in elem.get('_replacement_data',[])),
-        '^prefetcher_string': ', '.join(f'class {k["class"]}' for k in elem.get('_prefetcher_data',[])),
-        '^lower_level_queues': f'channels.at({ul_pairs.index((elem.get("lower_level"), elem.get("name")))})'
+        '^prefetcher_string': ', '.join(f'class {k["class"]}' for k in elem.get('_prefetcher_data',[]))
     }
     if 'frequency' in elem:
         local_params['^clock_period'] = int(1000000/elem['frequency'])
+    if 'lower_level' in elem:
+        local_params.update({
+            '^lower_level_queues': f'channels.at({ul_pairs.index((elem.get("lower_level"), elem.get("name")))})'
+        })
     if 'lower_translate' in elem:
         local_params.update({
             '^lower_translate_queues': f'channels.at({ul_pairs.index((elem.get("lower_translate"), elem.get("name")))})'
@@ -317,14 +322,16 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     Generate the lines for a C++ file that instantiates a configuration.
     '''
     classname = f'champsim::configured::generated_environment<0x{build_id}>'
+    shadows = [c for c in caches if '_shadow_of' in c]
+    caches = [c for c in caches if '_shadow_of' not in c]
     ul_pairs = get_upper_levels(cores, caches, ptws)
     queues = get_queue_info(ul_pairs, decorate_queues(caches, ptws, pmem))
 
     datas = itertools.filterfalse(operator.methodcaller('get', 'legacy', False), itertools.chain(
         *(c['_branch_predictor_data'] for c in cores),
         *(c['_btb_data'] for c in cores),
-        *(c['_prefetcher_data'] for c in caches),
-        *(c['_replacement_data'] for c in caches)
+        *(c['_prefetcher_data'] for c in itertools.chain(caches, shadows)),
+        *(c['_replacement_data'] for c in itertools.chain(caches, shadows))
     ))
     yield from module_include_files(datas)
 
@@ -374,6 +381,24 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
         '},'
     )
 
+    if shadows:
+        shadow_instantiation_body = (
+            'shadow_caches {',
+            *get_builder_function_call('CACHE', map(functools.partial(get_cache_builder, ul_pairs=ul_pairs), shadows)),
+            '},'
+        )
+    else:
+        shadow_instantiation_body = ('shadow_caches {},',)
+
+    # build() places each element at the front of its list, so the elements are in reverse order
+    def reversed_index(elements, name):
+        return len(elements) - 1 - [e['name'] for e in elements].index(name)
+
+    shadow_attachment_body = (
+        f'(*std::next(std::begin(caches), {reversed_index(caches, s["_shadow_of"])})).add_shadow(*std::next(std::begin(shadow_caches), {reversed_index(shadows, s["name"])}));'
+        for s in shadows
+    )
+
     core_instantiation_body = (
         'cores {',
         *get_builder_function_call('O3_CPU',
@@ -389,15 +414,23 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     yield from vmem_instantiation_body
     yield from ptw_instantiation_body
     yield from cache_instantiation_body
+    yield from shadow_instantiation_body
     yield from core_instantiation_body
     yield '{'
+    yield from ('  '+l for l in shadow_attachment_body)
     yield '}'
     yield ''
 
     yield from get_ref_vector_function('O3_CPU', f'{classname}::cpu_view', 'cores')
     yield ''
 
-    yield from get_ref_vector_function('CACHE', f'{classname}::cache_view', 'caches')
+    yield from cxx.function(f'{classname}::cache_view', (
+        'std::vector<std::reference_wrapper<CACHE>> retval{};',
+        'auto make_ref = [](auto& x){ return std::ref(x); };',
+        'std::transform(std::begin(caches), std::end(caches), std::back_inserter(retval), make_ref);',
+        'std::transform(std::begin(shadow_caches), std::end(shadow_caches), std::back_inserter(retval), make_ref);',
+        'return retval;'
+    ), rtype='std::vector<std::reference_wrapper<CACHE>>')
     yield ''
 
     yield from get_ref_vector_function('PageTableWalker', f'{classname}::ptw_view', 'ptws')
@@ -417,6 +450,9 @@ def get_instantiation_lines(cores, caches, ptws, pmem, vmem, build_id):
     yield from cxx.function(f'{classname}::dram_view', [f'return {pmem["name"]};'], rtype='MEMORY_CONTROLLER&')
     yield ''
 
+    yield from cxx.function(f'{classname}::vmem_view', ['return vmem;'], rtype='VirtualMemory&')
+    yield ''
+
 def get_instantiation_header(num_cpus, env, build_id):
     yield '#include "environment.h"'
     yield '#include "vmem.h"'
@@ -429,6 +465,7 @@ def get_instantiation_header(num_cpus, env, build_id):
         'VirtualMemory vmem;',
         'std::forward_list<PageTableWalker> ptws;',
         'std::forward_list<CACHE> caches;',
+        'std::forward_list<CACHE> shadow_caches;',
         'std::forward_list<O3_CPU> cores;',
 
         'public:',
@@ -441,6 +478,7 @@ def get_instantiation_header(num_cpus, env, build_id):
         'std::vector<std::reference_wrapper<CACHE>> cache_view() final;',
         'std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final;',
         'MEMORY_CONTROLLER& dram_view() final;',
+        'VirtualMemory& vmem_view() final;',
         'std::vector<std::reference_wrapper<operable>> operable_view() final;'
     )
     struct_name = f'champsim::configured::generated_environment<0x{build_id}> final'
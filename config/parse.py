@@ -119,6 +119,15 @@ def int_or_prefixed_size(val):
         return int(val)
     return val
 
+def mrc_sample_rate(val):
+    '''
+    Convert the value of a cache's "mrc" key to the fraction of blocks to profile.
+    A value of true profiles one block in a hundred, and false disables the profile.
+    '''
+    if isinstance(val, bool):
+        return 0.01 if val else 0
+    return val
+
 def core_default_names(cpu):
     """ Apply defaults to a cpu with the given index """
     default_element_names = {n: f'{cpu["name"]}_{n}' for n in ('L1I', 'L1D', 'ITLB', 'DTLB', 'L2C', 'STLB', 'PTW')}
@@ -380,6 +389,7 @@ class NormalizedConfiguration:
 
             # Unfold suffixed strings
             ({'name': c['name'], **transform_for_keys(c, ('size',), int_or_prefixed_size)} for c in caches.values()),
+            ({'name': c['name'], **transform_for_keys(c, ('mrc',), mrc_sample_rate)} for c in caches.values()),
 
             caches.values(),
 
@@ -408,6 +418,35 @@ class NormalizedConfiguration:
             } for k,cache in caches.items())
         )
 
+        # Shadow caches replay the accesses of another cache, with their own geometry or modules
+        def shadow_parse(cache):
+            # Lists are joined as the defaults are chained, so the shadows are read from the configuration
+            for i, shadow in enumerate(self.caches.get(cache['name'], {}).get('shadows', [])):
+                shadow = util.chain(
+                    transform_for_keys(shadow, ('size',), int_or_prefixed_size),
+                    transform_for_keys(shadow, ('prefetch_activate',), split_string_or_list),
+                    transform_for_keys(shadow, ('mrc',), mrc_sample_rate),
+                    shadow
+                )
+
+                # A shadow that sets its size derives its number of sets from the size
+                dropped_keys = ('name', 'lower_level', 'lower_translate', 'shadows', 'mrc', '_replacement_data', '_prefetcher_data')
+                if 'size' in shadow or 'log2_size' in shadow:
+                    dropped_keys = (*dropped_keys, 'sets', 'log2_sets')
+
+                yield util.chain(
+                    shadow,
+                    {
+                        'name': f'{cache["name"]}_shadow{i}',
+                        '_shadow_of': cache['name'],
+                        '_replacement_data': list(map(replacement_parse, util.wrap_list(shadow.get('replacement', cache.get('replacement', 'lru'))))),
+                        '_prefetcher_data': [*map(functools.partial(prefetcher_parse, cache=cache), util.wrap_list(shadow.get('prefetcher', cache.get('prefetcher', 'no'))))]
+                    },
+                    {k:v for k,v in cache.items() if k not in dropped_keys and k not in shadow}
+                )
+
+        caches = util.combine_named(caches.values(), *map(shadow_parse, caches.values()))
+
         ptws = util.combine_named(
             ptws.values(),
 
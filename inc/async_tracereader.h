@@ -0,0 +1,261 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASYNC_TRACEREADER_H
+#define ASYNC_TRACEREADER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "instruction.h"
+#include "util/detect.h"
+
+namespace champsim
+{
+/**
+ * A reader that runs another reader on a thread of its own, so that decompressing and decoding the trace overlaps with simulation.
+ *
+ * The instructions are passed from the producing thread to the simulation thread in batches, through a single-producer, single-consumer ring.
+ * Neither thread takes a lock unless the ring is full or empty. The instructions, and the point at which ``eof()`` becomes true,
+ * are the same as those of the wrapped reader.
+ */
+template <typename R>
+class async_tracereader
+{
+  constexpr static std::size_t batch_size = 128;
+  constexpr static std::size_t ring_size = 16;
+
+  struct batch_type {
+    uint64_t skipped = 0; // the instructions skipped in the wrapped reader before these
+    std::vector<ooo_model_instr> instrs{};
+    bool last = false;
+    std::exception_ptr failure{};
+  };
+
+  template <typename U>
+  using has_eof = decltype(std::declval<U>().eof());
+
+  template <typename U>
+  using has_skip = decltype(std::declval<U&>().skip(uint64_t{}));
+
+  struct shared_state {
+    R reader;
+    std::array<batch_type, ring_size> ring{};
+    std::atomic<std::size_t> head{0}; // the next batch to be consumed, written only by the consumer
+    std::atomic<std::size_t> tail{0}; // the next batch to be produced, written only by the producer
+    std::atomic<bool> producer_waiting{false};
+    std::atomic<bool> consumer_waiting{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> skip_target{0}; // the consumer has no use for the instructions before this one
+    uint64_t produced = 0;                 // the instructions taken from the wrapped reader, written only by the producer
+    std::mutex mutex{};
+    std::condition_variable ring_changed{};
+
+    explicit shared_state(R&& reader_) : reader(std::move(reader_)) {}
+
+    // Wake the other thread, if it is blocked on the ring
+    void notify(const std::atomic<bool>& waiting)
+    {
+      if (waiting.load()) {
+        std::lock_guard lock{mutex};
+        ring_changed.notify_all();
+      }
+    }
+
+    bool push(batch_type&& batch)
+    {
+      auto index = tail.load();
+      if (index - head.load() == ring_size) {
+        std::unique_lock lock{mutex};
+        producer_waiting.store(true);
+        ring_changed.wait(lock, [&] { return stopping.load() || index - head.load() < ring_size; });
+        producer_waiting.store(false);
+      }
+
+      if (stopping.load()) {
+        return false;
+      }
+
+      ring.at(index % ring_size) = std::move(batch);
+      tail.store(index + 1);
+      notify(consumer_waiting);
+      return true;
+    }
+
+    batch_type pop()
+    {
+      auto index = head.load();
+      if (tail.load() == index) {
+        std::unique_lock lock{mutex};
+        consumer_waiting.store(true);
+        ring_changed.wait(lock, [&] { return tail.load() != index; });
+        consumer_waiting.store(false);
+      }
+
+      auto batch = std::move(ring.at(index % ring_size));
+      head.store(index + 1);
+      notify(producer_waiting);
+      return batch;
+    }
+
+    bool reader_eof() const
+    {
+      if constexpr (champsim::is_detected_v<has_eof, R>) {
+        return reader.eof();
+      }
+      return false;
+    }
+
+    // Skip the wrapped reader ahead to the instruction the consumer wants next
+    uint64_t skip_requested()
+    {
+      auto target = skip_target.load();
+      if (target <= produced) {
+        return 0;
+      }
+
+      uint64_t skipped = 0;
+      if constexpr (champsim::is_detected_v<has_skip, R>) {
+        skipped = reader.skip(target - produced);
+      } else {
+        for (; produced + skipped < target && !reader_eof(); ++skipped) {
+          reader();
+        }
+      }
+      produced += skipped;
+      return skipped;
+    }
+
+    void produce()
+    {
+      bool last = false;
+      while (!last && !stopping.load()) {
+        batch_type batch;
+        batch.instrs.reserve(batch_size);
+        try {
+          batch.skipped = skip_requested();
+          last = reader_eof();
+          while (!last && std::size(batch.instrs) < batch_size) {
+            batch.instrs.push_back(reader());
+            ++produced;
+            last = reader_eof();
+          }
+        } catch (...) {
+          // The instructions read before the failure are delivered before it
+          batch.failure = std::current_exception();
+          last = true;
+        }
+
+        batch.last = last;
+        if (!push(std::move(batch))) {
+          return;
+        }
+      }
+    }
+  };
+
+  std::unique_ptr<shared_state> state;
+  std::thread producer;
+  mutable batch_type current{};
+  mutable std::size_t current_index = 0;
+  mutable uint64_t consumed = 0; // the position in the wrapped reader's instructions
+
+  // Make an instruction available in the current batch, unless the trace has ended
+  void fill() const
+  {
+    while (current_index == std::size(current.instrs) && !current.last) {
+      current = state->pop();
+      current_index = 0;
+      consumed += current.skipped;
+    }
+  }
+
+public:
+  explicit async_tracereader(R&& reader) : state(std::make_unique<shared_state>(std::move(reader)))
+  {
+    producer = std::thread{[s = state.get()] { s->produce(); }};
+  }
+
+  ~async_tracereader()
+  {
+    if (producer.joinable()) {
+      {
+        std::lock_guard lock{state->mutex};
+        state->stopping.store(true);
+      }
+      state->ring_changed.notify_all();
+      producer.join();
+    }
+  }
+
+  async_tracereader(const async_tracereader&) = delete;
+  async_tracereader& operator=(const async_tracereader&) = delete;
+  async_tracereader(async_tracereader&&) noexcept = default;
+  async_tracereader& operator=(async_tracereader&&) = delete;
+
+  ooo_model_instr operator()()
+  {
+    fill();
+    if (current_index == std::size(current.instrs) && current.failure) {
+      std::rethrow_exception(current.failure);
+    }
+    ++consumed;
+    return std::move(current.instrs.at(current_index++));
+  }
+
+  /**
+   * Discard up to ``count`` instructions, stopping early if the trace ends. Those already decoded are dropped, and the producing thread
+   * skips the rest in the wrapped reader, with its ``skip()`` if it has one.
+   *
+   * \return the number of instructions skipped.
+   */
+  uint64_t skip(uint64_t count)
+  {
+    const auto start = consumed;
+    const auto target = start + count;
+    state->skip_target.store(target);
+    while (consumed < target) {
+      fill();
+      auto available = std::size(current.instrs) - current_index;
+      if (available == 0) {
+        break; // The trace has ended
+      }
+      auto dropped = std::min<uint64_t>(available, target - consumed);
+      current_index += dropped;
+      consumed += dropped;
+    }
+    return consumed - start;
+  }
+
+  [[nodiscard]] bool eof() const
+  {
+    fill();
+    return current_index == std::size(current.instrs) && current.last && !current.failure;
+  }
+};
+} // namespace champsim
+
+#endif
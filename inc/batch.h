@@ -0,0 +1,94 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "environment.h"
+#include "shared_trace.h"
+
+namespace champsim
+{
+/**
+ * One simulation in a batch, run in an environment of its own.
+ */
+struct batch_job {
+  std::string name;
+  std::vector<std::string> trace_names;
+  long long skip_instructions = 0;
+  long long warmup_instructions = 0;
+  long long simulation_instructions = std::numeric_limits<long long>::max();
+  bool repeat = false;            // Whether the traces restart from the beginning when they end
+  bool cloudsuite = false;        // Whether the traces are in the cloudsuite format
+  bool functional_warmup = false; // Whether the warmup bypasses the timing model
+  std::string output_file;        // The file to receive the statistics, or empty for the standard output
+  std::string json_file;          // The file to receive the statistics as JSON, or empty for none
+};
+
+/**
+ * Read a list of jobs, given as a JSON array of objects. Each object must have a "traces" list with a trace for each CPU, and may have
+ * "name", "skip_instructions", "warmup_instructions", "simulation_instructions", "cloudsuite", "functional_warmup", "output", and "json" members,
+ * which have the same meanings and defaults as the command-line options.
+ *
+ * \throws std::invalid_argument if a job is malformed or one of its traces cannot be opened.
+ */
+std::vector<batch_job> read_batch_jobs(std::istream& stream);
+
+/**
+ * The trace files being read by the running jobs. Jobs that begin reading a file while another job still holds its beginning share its decompression.
+ */
+class shared_trace_registry
+{
+  std::mutex mutex{};
+  std::map<std::tuple<std::string, bool, bool>, std::weak_ptr<shared_trace_source>> sources{};
+  unsigned decoder_threads = 1;
+
+public:
+  shared_trace_registry() = default;
+
+  /**
+   * Files in a format that can be decoded in parallel are decoded by up to ``threads`` threads each.
+   */
+  explicit shared_trace_registry(unsigned threads) : decoder_threads(threads) {}
+
+  shared_trace_source::reader join(const std::string& fname, bool is_cloudsuite, bool repeat);
+};
+
+/**
+ * Run the jobs, up to ``threads`` at a time, each in an environment produced by ``make_environment``. Each trace is decoded by up to
+ * ``decoder_threads`` threads, if its format allows it. Every job simulates the configuration that ``make_environment`` builds; a job cannot
+ * choose its own, because the configuration is compiled into the binary.
+ * A job that throws is reported and does not stop the others.
+ *
+ * \return the number of jobs that failed.
+ */
+std::size_t run_batch(const std::vector<batch_job>& jobs, std::size_t threads, unsigned decoder_threads,
+                      const std::function<std::unique_ptr<environment>()>& make_environment);
+} // namespace champsim
+
+#endif
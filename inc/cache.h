@@ -26,12 +26,16 @@
 #include <cstddef> // for size_t
 #include <cstdint> // for uint64_t, uint32_t, uint8_t
 #include <deque>
+#include <istream>
 #include <iterator> // for size
 #include <limits>   // for numeric_limits
 #include <memory>
+#include <ostream>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "address.h"
@@ -43,7 +47,11 @@
 #include "channel.h"
 #include "chrono.h"
 #include "modules.h"
+#include "msl/checkpoint.h"
 #include "operable.h"
+#include "stack_distance.h"
+#include "tag_array.h"
+#include "util/circular_buffer.h"
 #include "util/to_underlying.h" // for to_underlying
 #include "waitable.h"
 
@@ -115,6 +123,8 @@ public:
 private:
   bool try_hit(const tag_lookup_type& handle_pkt);
   bool handle_fill(const mshr_type& fill_mshr);
+  template <typename F>
+  bool do_fill(const mshr_type& fill_mshr, F&& issue_writeback);
   bool handle_miss(const tag_lookup_type& handle_pkt);
   bool handle_write(const tag_lookup_type& handle_pkt);
   void finish_packet(const response_type& packet);
@@ -122,6 +132,15 @@ private:
 
   void issue_translation(tag_lookup_type& q_entry) const;
 
+  champsim::address functional_lookup(const tag_lookup_type& handle_pkt, const champsim::functional_forward_type& forward);
+  champsim::address functional_operate(tag_lookup_type handle_pkt, const champsim::functional_forward_type& forward);
+
+  std::vector<CACHE*> shadows{};
+  void replay_to_shadows(const tag_lookup_type& handle_pkt);
+
+  std::vector<champsim::stack_distance_profiler> stack_distance_profilers{};
+  void record_stack_distance(const tag_lookup_type& handle_pkt);
+
 public:
   using BLOCK = champsim::cache_block;
 
@@ -142,13 +161,20 @@ private:
   template <typename T>
   champsim::address module_address(const T& element) const;
 
-  auto matches_address(champsim::address address) const;
+  [[nodiscard]] uint64_t block_key(champsim::address address) const;
+  void update_tags(long set, long way);
   std::pair<mshr_type, request_type> mshr_and_forward_packet(const tag_lookup_type& handle_pkt);
 
   std::deque<tag_lookup_type> internal_PQ{};
   std::deque<tag_lookup_type> inflight_tag_check{};
   std::deque<tag_lookup_type> translation_stash{};
 
+  // positions in the MSHR of the entry for each block
+  std::unordered_map<uint64_t, uint64_t> mshr_index{};
+
+  // the MSHR entries whose data has returned are kept at its front, in the order they returned
+  std::size_t mshr_returned = 0;
+
 public:
   std::vector<channel_type*> upper_levels;
   channel_type* lower_level;
@@ -161,24 +187,40 @@ public:
   champsim::chrono::clock::duration HIT_LATENCY;
   champsim::chrono::clock::duration FILL_LATENCY;
   champsim::data::bits OFFSET_BITS;
-  set_type block{static_cast<typename set_type::size_type>(NUM_SET * NUM_WAY)};
   champsim::bandwidth::maximum_type MAX_TAG, MAX_FILL;
   bool prefetch_as_load;
   bool match_offset_bits;
   bool virtual_prefetch;
   std::vector<access_type> pref_activate_mask;
+  double stack_distance_sample_rate;
 
   using stats_type = cache_stats;
 
   stats_type sim_stats, roi_stats;
 
-  std::deque<mshr_type> MSHR;
+private:
+  // The blocks and the MSHR are only changed by the cache itself, because tags and mshr_index are derived from them
+  set_type block{static_cast<typename set_type::size_type>(NUM_SET * NUM_WAY)};
+  champsim::tag_array tags{NUM_SET, NUM_WAY};  // mirrors the tags and state bits of block, for lookups
+  champsim::circular_buffer<mshr_type> MSHR{}; // grows to its high-water mark, since the default MSHR_SIZE of a large cache can be very large
+
+  [[nodiscard]] bool tags_match_blocks() const;
+  [[nodiscard]] bool mshr_index_matches_mshr() const;
+
+public:
+  [[nodiscard]] const set_type& get_blocks() const { return block; }
+  [[nodiscard]] const champsim::circular_buffer<mshr_type>& get_mshr() const { return MSHR; }
+
   std::deque<mshr_type> inflight_writes;
 
   long operate() final;
   void initialize() final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
+  void skip_cycles(long cycles) final;
+  void checkpoint(std::ostream& stream) const final;
+  void restore(std::istream& stream) final;
 
   [[deprecated]] std::size_t get_occupancy(uint8_t queue_type, champsim::address address) const;
   [[deprecated]] std::size_t get_size(uint8_t queue_type, champsim::address address) const;
@@ -210,6 +252,21 @@ public:
   [[deprecated("This function should not be used to access the blocks directly.")]] [[nodiscard]] uint64_t get_way(uint64_t address, uint64_t set) const;
 
   long invalidate_entry(champsim::address inval_addr);
+
+  /**
+   * Warm the cache with the given access, without modelling its timing or using any queues.
+   * Translations, misses, writebacks, and the prefetches this access issues are sent through ``forward``.
+   *
+   * \returns the data of the accessed block
+   */
+  champsim::address functional_access(request_type pkt, const champsim::functional_forward_type& forward);
+
+  /**
+   * Replay every access this cache checks into the given cache, which keeps its own contents and statistics.
+   * The shadow has no queues or lower level of its own, and is initialized, checkpointed, and begins and ends its phases along with this cache.
+   */
+  void add_shadow(CACHE& shadow);
+
   bool prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
 
   [[deprecated]] bool prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata);
@@ -232,8 +289,11 @@ public:
     virtual uint32_t impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                                 uint32_t metadata_in) = 0;
     virtual void impl_prefetcher_cycle_operate() = 0;
+    [[nodiscard]] virtual bool impl_prefetcher_has_cycle_operate() const = 0;
     virtual void impl_prefetcher_final_stats() = 0;
     virtual void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) = 0;
+    virtual void impl_prefetcher_checkpoint(std::ostream& stream) = 0;
+    virtual bool impl_prefetcher_restore(std::istream& stream) = 0;
   };
 
   struct replacement_module_concept {
@@ -249,6 +309,8 @@ public:
     virtual void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                              champsim::address victim_addr, access_type type) = 0;
     virtual void impl_replacement_final_stats() = 0;
+    virtual void impl_replacement_checkpoint(std::ostream& stream) = 0;
+    virtual bool impl_replacement_restore(std::istream& stream) = 0;
   };
 
   template <typename... Ps>
@@ -266,8 +328,11 @@ public:
     [[nodiscard]] uint32_t impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                                       uint32_t metadata_in) final;
     void impl_prefetcher_cycle_operate() final;
+    [[nodiscard]] bool impl_prefetcher_has_cycle_operate() const final;
     void impl_prefetcher_final_stats() final;
     void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) final;
+    void impl_prefetcher_checkpoint(std::ostream& stream) final;
+    [[nodiscard]] bool impl_prefetcher_restore(std::istream& stream) final;
   };
 
   template <typename... Rs>
@@ -290,6 +355,8 @@ public:
     void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                      champsim::address victim_addr, access_type type) final;
     void impl_replacement_final_stats() final;
+    void impl_replacement_checkpoint(std::ostream& stream) final;
+    [[nodiscard]] bool impl_replacement_restore(std::istream& stream) final;
   };
 
   std::unique_ptr<prefetcher_module_concept> pref_module_pimpl;
@@ -302,8 +369,11 @@ public:
   [[nodiscard]] uint32_t impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                                     uint32_t metadata_in) const;
   void impl_prefetcher_cycle_operate() const;
+  [[nodiscard]] bool impl_prefetcher_has_cycle_operate() const;
   void impl_prefetcher_final_stats() const;
   void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) const;
+  void impl_prefetcher_checkpoint(std::ostream& stream) const;
+  [[nodiscard]] bool impl_prefetcher_restore(std::istream& stream) const;
 
   void impl_initialize_replacement() const;
   [[nodiscard]] long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip,
@@ -313,6 +383,8 @@ public:
   void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
                                    champsim::address victim_addr, access_type type) const;
   void impl_replacement_final_stats() const;
+  void impl_replacement_checkpoint(std::ostream& stream) const;
+  [[nodiscard]] bool impl_replacement_restore(std::istream& stream) const;
   // NOLINTEND(readability-make-member-function-const)
 
   template <typename... Ps, typename... Rs>
@@ -321,6 +393,7 @@ public:
         NUM_WAY(b.get_num_ways()), MSHR_SIZE(b.get_num_mshrs()), PQ_SIZE(b.m_pq_size), HIT_LATENCY(b.get_hit_latency() * b.m_clock_period),
         FILL_LATENCY(b.get_fill_latency() * b.m_clock_period), OFFSET_BITS(b.m_offset_bits), MAX_TAG(b.get_tag_bandwidth()), MAX_FILL(b.get_fill_bandwidth()),
         prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), pref_activate_mask(b.m_pref_act_mask),
+        stack_distance_sample_rate(b.m_sd_rate),
         pref_module_pimpl(std::make_unique<prefetcher_module_model<Ps...>>(this)), repl_module_pimpl(std::make_unique<replacement_module_model<Rs...>>(this))
   {
   }
@@ -397,6 +470,13 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_cycle_operate()
   std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
 }
 
+template <typename... Ps>
+bool CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_has_cycle_operate() const
+{
+  using namespace champsim::modules;
+  return (false || ... || prefetcher::has_cycle_operate<Ps>);
+}
+
 template <typename... Ps>
 void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_final_stats()
 {
@@ -423,6 +503,36 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champ
   std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
 }
 
+template <typename... Ps>
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_checkpoint(std::ostream& stream)
+{
+  [[maybe_unused]] auto process_one = [&](auto& p) {
+    using namespace champsim::modules;
+    champsim::msl::checkpoint_block(stream, typeid(p).name(), [&](std::ostream& block) {
+      if constexpr (prefetcher::has_checkpoint<decltype(p), std::ostream&>)
+        p.prefetcher_checkpoint(block);
+    });
+  };
+
+  std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
+}
+
+template <typename... Ps>
+bool CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_restore(std::istream& stream)
+{
+  [[maybe_unused]] auto process_one = [&](auto& p) {
+    using namespace champsim::modules;
+    return champsim::msl::restore_block(stream, typeid(p).name(), [&](std::istream& block) {
+      if constexpr (prefetcher::has_restore<decltype(p), std::istream&>)
+        p.prefetcher_restore(block);
+    });
+  };
+
+  bool restored_all = true;
+  std::apply([&](auto&... p) { (..., (restored_all = process_one(p) && restored_all)); }, intern_);
+  return restored_all;
+}
+
 template <typename... Rs>
 void CACHE::replacement_module_model<Rs...>::impl_initialize_replacement()
 {
@@ -530,6 +640,36 @@ void CACHE::replacement_module_model<Rs...>::impl_replacement_final_stats()
   std::apply([&](auto&... r) { (..., process_one(r)); }, intern_);
 }
 
+template <typename... Rs>
+void CACHE::replacement_module_model<Rs...>::impl_replacement_checkpoint(std::ostream& stream)
+{
+  [[maybe_unused]] auto process_one = [&](auto& r) {
+    using namespace champsim::modules;
+    champsim::msl::checkpoint_block(stream, typeid(r).name(), [&](std::ostream& block) {
+      if constexpr (replacement::has_checkpoint<decltype(r), std::ostream&>)
+        r.replacement_checkpoint(block);
+    });
+  };
+
+  std::apply([&](auto&... r) { (..., process_one(r)); }, intern_);
+}
+
+template <typename... Rs>
+bool CACHE::replacement_module_model<Rs...>::impl_replacement_restore(std::istream& stream)
+{
+  [[maybe_unused]] auto process_one = [&](auto& r) {
+    using namespace champsim::modules;
+    return champsim::msl::restore_block(stream, typeid(r).name(), [&](std::istream& block) {
+      if constexpr (replacement::has_restore<decltype(r), std::istream&>)
+        r.replacement_restore(block);
+    });
+  };
+
+  bool restored_all = true;
+  std::apply([&](auto&... r) { (..., (restored_all = process_one(r) && restored_all)); }, intern_);
+  return restored_all;
+}
+
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
 #undef SET_ASIDE_CHAMPSIM_MODULE
 #define CHAMPSIM_MODULE
@@ -57,6 +57,7 @@ struct cache_builder_base {
   bool m_pref_load{};
   bool m_wq_full_addr{};
   bool m_va_pref{};
+  double m_sd_rate{};
 
   std::vector<access_type> m_pref_act_mask{access_type::LOAD, access_type::PREFETCH};
   std::vector<champsim::channel*> m_uls{};
@@ -212,6 +213,12 @@ public:
    */
   self_type& reset_virtual_prefetch();
 
+  /**
+   * Specify the fraction of blocks whose LRU stack distances are profiled to report a miss ratio curve.
+   * A rate of 0 disables the profile.
+   */
+  self_type& stack_distance_sample_rate(double rate_);
+
   /**
    * Specify the ``access_type`` values that should activate the prefetcher.
    */
@@ -485,6 +492,13 @@ auto champsim::cache_builder<P, R>::reset_virtual_prefetch() -> self_type&
   return *this;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::stack_distance_sample_rate(double rate_) -> self_type&
+{
+  m_sd_rate = rate_;
+  return *this;
+}
+
 template <typename P, typename R>
 template <typename... Elems>
 auto champsim::cache_builder<P, R>::prefetch_activate(Elems... pref_act_elems) -> self_type&
@@ -23,9 +23,14 @@ struct cache_stats {
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_merge = {};
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_return = {};
 
+  // The number of sampled accesses by the smallest fully-associative LRU cache size, in bytes, at which they would hit
+  champsim::stats::event_counter<std::pair<long, std::remove_cv_t<decltype(NUM_CPUS)>>> stack_distances = {};
+
   long total_miss_latency_cycles{};
 };
 
 cache_stats operator-(cache_stats lhs, cache_stats rhs);
+cache_stats operator+(cache_stats lhs, cache_stats rhs);
+cache_stats operator*(cache_stats lhs, double factor);
 
 #endif
@@ -39,6 +39,9 @@ struct deadlock : public std::exception {
   explicit deadlock(uint32_t cpu) : which(cpu) {}
 };
 
+// The number of cycles without progress after which the simulation is considered deadlocked
+constexpr long deadlock_cycles = 500;
+
 #ifdef DEBUG_PRINT
 constexpr bool debug_print = true;
 #else
@@ -20,13 +20,17 @@
 #include <array>
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <limits>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "access_type.h"
 #include "address.h"
 #include "champsim.h"
+#include "util/circular_buffer.h"
 
 namespace champsim
 {
@@ -83,6 +87,25 @@ class channel
     explicit response(request req) : response(req.address, req.v_address, req.data, req.pf_metadata, req.instr_depend_on_me) {}
   };
 
+  using queue_type = champsim::circular_buffer<request>;
+
+  /**
+   * The packets of a queue that have been checked for collisions, by block, so that a packet can find the first earlier packet to its
+   * block without searching the queue. Packets are taken from the front of the queue by its consumer, which does not update the index,
+   * so the index forgets them when it is next pruned.
+   */
+  class queue_index
+  {
+    std::unordered_map<uint64_t, std::vector<uint64_t>> positions_by_block{}; // oldest first
+    std::deque<std::pair<uint64_t, uint64_t>> checked{};                       // position and block, in queue order
+
+  public:
+    void prune(const queue_type& queue);
+    void add(uint64_t position, uint64_t block);
+    [[nodiscard]] queue_type::iterator first_unchecked(queue_type& queue) const;
+    [[nodiscard]] queue_type::iterator find(queue_type& queue, uint64_t block) const;
+  };
+
   template <typename R>
   bool do_add_queue(R& queue, std::size_t queue_size, const typename R::value_type& packet);
 
@@ -92,12 +115,14 @@ class channel
   champsim::data::bits OFFSET_BITS{};
   bool match_offset_bits = false;
 
+  queue_index rq_index{}, pq_index{}, wq_index{};
+
 public:
   using response_type = response;
   using request_type = request;
   using stats_type = cache_queue_stats;
 
-  std::deque<request_type> RQ{}, PQ{}, WQ{};
+  queue_type RQ{}, PQ{}, WQ{};
   std::deque<response_type> returned{};
 
   stats_type sim_stats{}, roi_stats{};
@@ -119,6 +144,12 @@ public:
 
   void check_collision();
 };
+
+/**
+ * Delivers a request to the component that reads from the given channel, bypassing the channel and the timing model, and returns the data of its response.
+ * This is used to warm the hierarchy functionally.
+ */
+using functional_forward_type = std::function<champsim::address(channel*, const channel::request_type&)>;
 } // namespace champsim
 
 #endif
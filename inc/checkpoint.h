@@ -0,0 +1,70 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "tracereader.h"
+
+namespace champsim
+{
+struct environment;
+
+/**
+ * Options for saving the state of the simulation after warmup, and for resuming from it.
+ */
+struct checkpoint_options {
+  /**
+   * If not empty, the state after the last warmup phase is written to this file.
+   */
+  std::string save_file{};
+
+  /**
+   * If not empty, the state is read from this file and the warmup phases are skipped.
+   */
+  std::string restore_file{};
+
+  /**
+   * The number of instructions skipped at the beginning of each trace, before the warmup. It is recorded in a saved checkpoint,
+   * and a checkpoint can only be restored with the same number, so that the restored state is paired with the same trace position.
+   */
+  uint64_t skip_instructions = 0;
+};
+
+/**
+ * Write the warmed state of the environment, including the number of instructions each core has retired and the number that were
+ * skipped before the warmup. Instructions that are in flight are not saved.
+ */
+void save_checkpoint(std::ostream& stream, environment& env, uint64_t skip_instructions);
+
+/**
+ * Read the state written by save_checkpoint() into the environment, which must have the same configuration.
+ * Each trace is advanced past the instructions its core retired before the checkpoint was taken.
+ *
+ * \throws std::runtime_error if the checkpoint is malformed or truncated, does not match the environment, or was saved after
+ * skipping a different number of instructions.
+ */
+void restore_checkpoint(std::istream& stream, environment& env, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index,
+                        uint64_t skip_instructions);
+} // namespace champsim
+
+#endif
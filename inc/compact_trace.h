@@ -0,0 +1,418 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPACT_TRACE_H
+#define COMPACT_TRACE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "skip_stream.h"
+#include "trace_instruction.h"
+#include "util/detect.h"
+
+namespace champsim
+{
+/**
+ * A compact encoding of traces in the ``input_instr`` format.
+ *
+ * A compact trace begins with ``magic``, followed by one variable-length record per instruction:
+ *
+ * - A flags byte: bit 0 is set for branches, bit 1 for taken branches, and bit 2 if the registers are given literally.
+ *   If bit 3 is set, the branch bytes are given literally after the presence byte, and bits 0 and 1 are ignored.
+ * - A presence byte: bits 0 and 1 mark the destination memory operands that are present, and bits 2 through 5 the source memory operands.
+ * - The difference from the previous instruction pointer, as a zigzag-encoded varint.
+ * - The register set: either its six bytes (the destinations, then the sources), or a one-byte index into a dictionary of the
+ *   recently seen register sets. Each literal register set is added to the dictionary, replacing the oldest entry once it is full.
+ * - Each present memory operand, in order, as the zigzag-encoded varint difference from the previous memory operand in the trace.
+ *
+ * The decoded records are identical to the originals, including the positions of empty memory operands.
+ */
+namespace compact_trace
+{
+constexpr std::array<char, 8> magic{'C', 'S', 'C', 'T', 'R', 'C', '\x01', '\x00'};
+constexpr std::size_t dictionary_size = 255;
+
+using register_set = std::array<unsigned char, NUM_INSTR_DESTINATIONS + NUM_INSTR_SOURCES>;
+
+enum flag : unsigned char { BRANCH = 1, TAKEN = 2, LITERAL_REGISTERS = 4, LITERAL_BRANCH = 8 };
+
+/**
+ * The state shared by the encoder and decoder, which each update identically.
+ */
+struct coding_state {
+  uint64_t prev_ip = 0;
+  uint64_t prev_address = 0;
+  std::vector<register_set> dictionary{};
+  std::size_t oldest = 0;
+
+  // Add a register set, and return the index it replaced, if any
+  std::pair<std::size_t, bool> add(const register_set& regs)
+  {
+    if (std::size(dictionary) < dictionary_size) {
+      dictionary.push_back(regs);
+      return {std::size(dictionary) - 1, false};
+    }
+    auto index = oldest;
+    dictionary.at(index) = regs;
+    oldest = (oldest + 1) % dictionary_size;
+    return {index, true};
+  }
+};
+
+inline uint64_t zigzag(uint64_t delta) { return (delta << 1) ^ static_cast<uint64_t>(-static_cast<int64_t>(delta >> 63)); }
+inline uint64_t unzigzag(uint64_t value) { return (value >> 1) ^ static_cast<uint64_t>(-static_cast<int64_t>(value & 1)); }
+
+inline register_set get_registers(const input_instr& instr)
+{
+  register_set regs{};
+  std::copy(std::begin(instr.destination_registers), std::end(instr.destination_registers), std::begin(regs));
+  std::copy(std::begin(instr.source_registers), std::end(instr.source_registers), std::next(std::begin(regs), NUM_INSTR_DESTINATIONS));
+  return regs;
+}
+
+/**
+ * Write instructions to a stream in the compact encoding.
+ */
+class encoder
+{
+  std::ostream& out;
+  coding_state state{};
+  std::map<register_set, std::size_t> index{};
+  std::vector<char> record{};
+
+  void put_varint(uint64_t value)
+  {
+    while (value >= 0x80) {
+      record.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    record.push_back(static_cast<char>(value));
+  }
+
+public:
+  explicit encoder(std::ostream& out_) : out(out_) { out.write(std::data(magic), std::size(magic)); }
+
+  void write(const input_instr& instr)
+  {
+    record.clear();
+
+    unsigned char flags = 0;
+    if (instr.is_branch > 1 || instr.branch_taken > 1) {
+      flags |= LITERAL_BRANCH;
+    } else {
+      flags |= (instr.is_branch != 0 ? BRANCH : 0) | (instr.branch_taken != 0 ? TAKEN : 0);
+    }
+
+    auto regs = get_registers(instr);
+    auto found = index.find(regs);
+    if (found == std::end(index)) {
+      flags |= LITERAL_REGISTERS;
+    }
+
+    unsigned char presence = 0;
+    for (std::size_t i = 0; i < NUM_INSTR_DESTINATIONS; ++i) {
+      presence |= static_cast<unsigned char>((instr.destination_memory[i] != 0 ? 1 : 0) << i);
+    }
+    for (std::size_t i = 0; i < NUM_INSTR_SOURCES; ++i) {
+      presence |= static_cast<unsigned char>((instr.source_memory[i] != 0 ? 1 : 0) << (NUM_INSTR_DESTINATIONS + i));
+    }
+
+    record.push_back(static_cast<char>(flags));
+    record.push_back(static_cast<char>(presence));
+    if ((flags & LITERAL_BRANCH) != 0) {
+      record.push_back(static_cast<char>(instr.is_branch));
+      record.push_back(static_cast<char>(instr.branch_taken));
+    }
+
+    put_varint(zigzag(instr.ip - state.prev_ip));
+    state.prev_ip = instr.ip;
+
+    if (found == std::end(index)) {
+      record.insert(std::end(record), std::begin(regs), std::end(regs));
+      auto [slot, replaced] = state.add(regs);
+      if (replaced) {
+        index.erase(std::find_if(std::begin(index), std::end(index), [slot = slot](const auto& entry) { return entry.second == slot; }));
+      }
+      index.insert_or_assign(regs, slot);
+    } else {
+      record.push_back(static_cast<char>(found->second));
+    }
+
+    auto put_address = [this](uint64_t address) {
+      if (address != 0) {
+        put_varint(zigzag(address - state.prev_address));
+        state.prev_address = address;
+      }
+    };
+    std::for_each(std::begin(instr.destination_memory), std::end(instr.destination_memory), put_address);
+    std::for_each(std::begin(instr.source_memory), std::end(instr.source_memory), put_address);
+
+    out.write(std::data(record), static_cast<std::streamsize>(std::size(record)));
+  }
+};
+
+/**
+ * Decode compact records from bytes given by a callable, which returns the next byte, or a negative value at the end of the input.
+ */
+class decoder
+{
+  coding_state state{};
+
+  template <typename F>
+  static unsigned char get(F& next_byte)
+  {
+    auto byte = next_byte();
+    if (byte < 0) {
+      throw std::runtime_error{"The compact trace ends in the middle of an instruction"};
+    }
+    return static_cast<unsigned char>(byte);
+  }
+
+  template <typename F>
+  static uint64_t get_varint(F& next_byte)
+  {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      auto byte = get(next_byte);
+      value |= uint64_t{byte & 0x7fu} << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    throw std::runtime_error{"The compact trace has a malformed number"};
+  }
+
+public:
+  /**
+   * Decode the next instruction.
+   *
+   * \return false if the input ended before the instruction began.
+   * \throws std::runtime_error if the input ends within an instruction, or is malformed.
+   */
+  template <typename F>
+  bool read(F&& next_byte, input_instr& instr)
+  {
+    auto first = next_byte();
+    if (first < 0) {
+      return false;
+    }
+
+    instr = input_instr{};
+    auto flags = static_cast<unsigned char>(first);
+    auto presence = get(next_byte);
+    if ((flags & LITERAL_BRANCH) != 0) {
+      instr.is_branch = get(next_byte);
+      instr.branch_taken = get(next_byte);
+    } else {
+      instr.is_branch = (flags & BRANCH) != 0 ? 1 : 0;
+      instr.branch_taken = (flags & TAKEN) != 0 ? 1 : 0;
+    }
+
+    state.prev_ip += unzigzag(get_varint(next_byte));
+    instr.ip = state.prev_ip;
+
+    register_set regs{};
+    if ((flags & LITERAL_REGISTERS) != 0) {
+      std::generate(std::begin(regs), std::end(regs), [&] { return get(next_byte); });
+      state.add(regs);
+    } else {
+      auto slot = get(next_byte);
+      if (slot >= std::size(state.dictionary)) {
+        throw std::runtime_error{"The compact trace refers to a register set it has not defined"};
+      }
+      regs = state.dictionary.at(slot);
+    }
+    std::copy_n(std::begin(regs), NUM_INSTR_DESTINATIONS, std::begin(instr.destination_registers));
+    std::copy_n(std::next(std::begin(regs), NUM_INSTR_DESTINATIONS), NUM_INSTR_SOURCES, std::begin(instr.source_registers));
+
+    auto get_address = [&](std::size_t bit) -> unsigned long long {
+      if ((presence & (1u << bit)) == 0) {
+        return 0;
+      }
+      state.prev_address += unzigzag(get_varint(next_byte));
+      return state.prev_address;
+    };
+    for (std::size_t i = 0; i < NUM_INSTR_DESTINATIONS; ++i) {
+      instr.destination_memory[i] = get_address(i);
+    }
+    for (std::size_t i = 0; i < NUM_INSTR_SOURCES; ++i) {
+      instr.source_memory[i] = get_address(NUM_INSTR_DESTINATIONS + i);
+    }
+    return true;
+  }
+};
+} // namespace compact_trace
+
+/**
+ * A stream of ``input_instr`` records, which decodes the underlying stream if it holds a compact trace, and otherwise passes it through.
+ * A compact trace is recognized by its leading ``compact_trace::magic``, whatever compression the underlying stream removed.
+ */
+template <typename F>
+class compact_istream
+{
+  constexpr static std::size_t input_size = 1 << 16;
+
+  template <typename U>
+  using has_take = decltype(std::declval<U&>().take(std::size_t{}));
+
+  F underlying;
+  bool compact = false;
+  std::vector<char> prefix{}; // bytes read while checking for the magic, not yet passed through
+  std::vector<char> input{};
+  std::size_t input_offset = 0;
+  std::vector<char> output{};
+  compact_trace::decoder decoder{};
+  std::streamsize gcount_ = 0;
+  bool eof_ = false;
+
+  void detect()
+  {
+    prefix.resize(std::size(compact_trace::magic));
+    underlying.read(std::data(prefix), static_cast<std::streamsize>(std::size(prefix)));
+    prefix.resize(static_cast<std::size_t>(underlying.gcount()));
+    compact = std::equal(std::begin(prefix), std::end(prefix), std::begin(compact_trace::magic), std::end(compact_trace::magic));
+    if (compact) {
+      prefix.clear();
+    }
+  }
+
+  // Whether the underlying stream has no more bytes, reading more of them if need be
+  bool input_exhausted()
+  {
+    if (input_offset == std::size(input)) {
+      input.resize(input_size);
+      underlying.read(std::data(input), static_cast<std::streamsize>(input_size));
+      input.resize(static_cast<std::size_t>(underlying.gcount()));
+      input_offset = 0;
+    }
+    return std::empty(input);
+  }
+
+  int next_byte()
+  {
+    if (input_exhausted()) {
+      return -1;
+    }
+    return static_cast<unsigned char>(input.at(input_offset++));
+  }
+
+  // Decode whole records into the buffer, up to the given number of bytes
+  void decode(char* s, std::streamsize count)
+  {
+    gcount_ = 0;
+    input_instr instr;
+    while (gcount_ + static_cast<std::streamsize>(sizeof(input_instr)) <= count) {
+      if (!decoder.read([this] { return next_byte(); }, instr)) {
+        eof_ = true;
+        return;
+      }
+      std::memcpy(std::next(s, gcount_), &instr, sizeof(input_instr));
+      gcount_ += static_cast<std::streamsize>(sizeof(input_instr));
+    }
+
+    // As with a file, asking for more than remains reaches the end
+    eof_ = gcount_ < count && input_exhausted();
+  }
+
+public:
+  explicit compact_istream(F&& underlying_) : underlying(std::move(underlying_)) { detect(); }
+  template <typename... Args, std::enable_if_t<std::is_constructible_v<F, Args...>, bool> = true>
+  explicit compact_istream(Args&&... args) : underlying(std::forward<Args>(args)...)
+  {
+    detect();
+  }
+
+  compact_istream& read(char* s, std::streamsize count)
+  {
+    if (compact) {
+      decode(s, count);
+      return *this;
+    }
+
+    auto from_prefix = std::min(static_cast<std::size_t>(count), std::size(prefix));
+    std::copy_n(std::begin(prefix), from_prefix, s);
+    prefix.erase(std::begin(prefix), std::next(std::begin(prefix), static_cast<long>(from_prefix)));
+    underlying.read(std::next(s, static_cast<long>(from_prefix)), count - static_cast<std::streamsize>(from_prefix));
+    gcount_ = static_cast<std::streamsize>(from_prefix) + underlying.gcount();
+    eof_ = underlying.eof();
+    return *this;
+  }
+
+  /**
+   * Give up to ``count`` bytes of records in place, if the underlying stream can. The range is valid until the next read.
+   */
+  template <typename U = F, std::enable_if_t<champsim::is_detected_v<has_take, U>, bool> = true>
+  std::pair<const char*, const char*> take(std::size_t count)
+  {
+    if (compact || !std::empty(prefix)) {
+      output.resize(count);
+      read(std::data(output), static_cast<std::streamsize>(count));
+      return {std::data(output), std::next(std::data(output), gcount_)};
+    }
+
+    auto retval = underlying.take(count);
+    gcount_ = std::distance(retval.first, retval.second);
+    eof_ = underlying.eof();
+    return retval;
+  }
+
+  /**
+   * Pass over up to ``count`` bytes of records. A compact trace is decoded without copying out the records, and any other trace
+   * is skipped in the underlying stream.
+   *
+   * \return the number of bytes skipped.
+   */
+  uint64_t skip(uint64_t count)
+  {
+    gcount_ = 0;
+    uint64_t skipped = 0;
+    if (compact) {
+      input_instr instr;
+      while (skipped + sizeof(input_instr) <= count) {
+        if (!decoder.read([this] { return next_byte(); }, instr)) {
+          eof_ = true;
+          break;
+        }
+        skipped += sizeof(input_instr);
+      }
+      eof_ = eof_ || (skipped < count && input_exhausted());
+      return skipped;
+    }
+
+    skipped = std::min<uint64_t>(count, std::size(prefix));
+    prefix.erase(std::begin(prefix), std::next(std::begin(prefix), static_cast<long>(skipped)));
+    skipped += skip_stream(underlying, count - skipped);
+    eof_ = underlying.eof();
+    return skipped;
+  }
+
+  [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+  [[nodiscard]] bool eof() const { return eof_; }
+};
+} // namespace champsim
+
+#endif
@@ -23,5 +23,7 @@ struct cpu_stats {
 };
 
 cpu_stats operator-(cpu_stats lhs, cpu_stats rhs);
+cpu_stats operator+(cpu_stats lhs, cpu_stats rhs);
+cpu_stats operator*(cpu_stats lhs, double factor);
 
 #endif
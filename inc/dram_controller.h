@@ -170,6 +170,7 @@ struct DRAM_CHANNEL final : public champsim::operable {
   void check_read_collision();
   long finish_dbus_request();
   long schedule_refresh();
+  [[nodiscard]] bool should_swap_write_mode() const;
   void swap_write_mode();
   long populate_dbus();
   DRAM_CHANNEL::queue_type::iterator schedule_packet();
@@ -180,6 +181,7 @@ struct DRAM_CHANNEL final : public champsim::operable {
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
   void print_deadlock() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
 
   std::size_t bank_request_capacity() const;
   std::size_t bankgroup_request_capacity() const;
@@ -216,6 +218,8 @@ public:
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
   void print_deadlock() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
+  void skip_cycles(long cycles) final;
 
   [[nodiscard]] champsim::data::bytes size() const;
 };
@@ -13,5 +13,7 @@ struct dram_stats {
 };
 
 dram_stats operator-(dram_stats lhs, dram_stats rhs);
+dram_stats operator+(dram_stats lhs, dram_stats rhs);
+dram_stats operator*(dram_stats lhs, double factor);
 
 #endif
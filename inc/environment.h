@@ -25,14 +25,17 @@
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "ptw.h"
+#include "vmem.h"
 
 namespace champsim
 {
 struct environment {
+  virtual ~environment() = default;
   virtual std::vector<std::reference_wrapper<O3_CPU>> cpu_view() = 0;
   virtual std::vector<std::reference_wrapper<CACHE>> cache_view() = 0;
   virtual std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() = 0;
   virtual MEMORY_CONTROLLER& dram_view() = 0;
+  virtual VirtualMemory& vmem_view() = 0;
   virtual std::vector<std::reference_wrapper<operable>> operable_view() = 0;
 };
 
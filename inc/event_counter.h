@@ -2,6 +2,7 @@
 #define EVENT_COUNTER_H
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <numeric>
 #include <type_traits>
@@ -86,6 +87,9 @@ public:
 
   event_counter<key_type>& operator+=(const event_counter<key_type>& rhs)
   {
+    for (auto key : rhs.keys) {
+      allocate(key);
+    }
     std::transform(std::begin(values), std::end(values), std::cbegin(keys), std::begin(values),
                    [&rhs](auto val, auto key) { return val + rhs.value_or(key, value_type{}); });
     return *this;
@@ -109,6 +113,18 @@ public:
     lhs -= rhs;
     return lhs;
   }
+
+  event_counter<key_type>& operator*=(double factor)
+  {
+    std::transform(std::begin(values), std::end(values), std::begin(values), [factor](auto val) { return std::lround(static_cast<double>(val) * factor); });
+    return *this;
+  }
+
+  friend auto operator*(event_counter<key_type> lhs, double factor)
+  {
+    lhs *= factor;
+    return lhs;
+  }
 };
 } // namespace champsim::stats
 
@@ -17,12 +17,19 @@
 #ifndef INF_STREAM_H
 #define INF_STREAM_H
 
+#include <array>
 #include <bzlib.h>
 #include <cassert>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <lzma.h>
 #include <memory>
 #include <zlib.h>
+#include <zstd.h>
+
+#include "util/detect.h"
 
 namespace champsim
 {
@@ -171,15 +178,116 @@ struct lzma_tag_t {
     return state;
   }
 
-  static inflate_state_type new_inflate_state()
+  static inflate_state_type new_inflate_state(unsigned threads = 1)
   {
     inflate_state_type state{new state_type};
     *state = LZMA_STREAM_INIT;
+#if LZMA_VERSION >= 50040002
+    // Files with several blocks, as written by xz -T, have their blocks decoded in parallel
+    if (threads > 1) {
+      lzma_mt options{};
+      options.flags = flags;
+      options.threads = threads;
+      options.memlimit_threading = ::lzma_physmem() / 4;
+      options.memlimit_stop = std::numeric_limits<uint64_t>::max();
+      auto ret = ::lzma_stream_decoder_mt(state.get(), &options);
+      assert(ret == LZMA_OK);
+      return state;
+    }
+#endif
     auto ret = ::lzma_stream_decoder(state.get(), std::numeric_limits<uint64_t>::max(), flags);
     assert(ret == LZMA_OK);
     return state;
   }
 };
+namespace detail
+{
+/**
+ * Zstandard keeps its buffer positions apart from its context, so they are gathered here in the shape of the other libraries' streams.
+ */
+template <typename Context>
+struct zstd_stream {
+  const unsigned char* next_in = nullptr;
+  std::size_t avail_in = 0;
+  unsigned char* next_out = nullptr;
+  std::size_t avail_out = 0;
+  uint64_t total_out = 0;
+  Context* context = nullptr;
+
+  // Run the given step over the current buffers, and advance them past what it consumed and produced
+  template <typename F>
+  std::size_t step(F&& func)
+  {
+    ZSTD_inBuffer input{next_in, avail_in, 0};
+    ZSTD_outBuffer output{next_out, avail_out, 0};
+    auto ret = func(context, &output, &input);
+    std::advance(next_in, input.pos);
+    avail_in -= input.pos;
+    std::advance(next_out, output.pos);
+    avail_out -= output.pos;
+    total_out += output.pos;
+    return ret;
+  }
+};
+
+inline std::size_t zstd_free(zstd_stream<ZSTD_CCtx>* s) { return ::ZSTD_freeCCtx(s->context); }
+inline std::size_t zstd_free(zstd_stream<ZSTD_DCtx>* s) { return ::ZSTD_freeDCtx(s->context); }
+} // namespace detail
+
+template <int compression = ZSTD_CLEVEL_DEFAULT>
+struct zstd_tag_t {
+  using state_type = detail::zstd_stream<ZSTD_DCtx>;
+  using in_char_type = std::remove_const_t<std::remove_pointer_t<decltype(state_type::next_in)>>;
+  using out_char_type = std::remove_pointer_t<decltype(state_type::next_out)>;
+  using deflate_state_type = std::unique_ptr<detail::zstd_stream<ZSTD_CCtx>,
+                                             detail::end_deleter<detail::zstd_stream<ZSTD_CCtx>, std::size_t, detail::zstd_free>>;
+  using inflate_state_type = std::unique_ptr<state_type, detail::end_deleter<state_type, std::size_t, detail::zstd_free>>;
+  using status_type = status_t;
+
+  static status_type deflate(deflate_state_type& x, bool flush)
+  {
+    auto ret = x->step([flush](auto* cctx, auto* output, auto* input) {
+      return ::ZSTD_compressStream2(cctx, output, input, flush ? ZSTD_e_end : ZSTD_e_continue);
+    });
+    if (::ZSTD_isError(ret)) {
+      return status_type::ERROR;
+    }
+    if (flush && ret == 0) {
+      return status_type::END;
+    }
+    return status_type::CAN_CONTINUE;
+  }
+
+  static status_type inflate(inflate_state_type& x)
+  {
+    // Concatenated frames are decoded one after another
+    auto ret = x->step([](auto* dctx, auto* output, auto* input) { return ::ZSTD_decompressStream(dctx, output, input); });
+    if (::ZSTD_isError(ret)) {
+      return status_type::ERROR;
+    }
+    if (ret == 0) {
+      return status_type::END;
+    }
+    return status_type::CAN_CONTINUE;
+  }
+
+  static deflate_state_type new_deflate_state()
+  {
+    deflate_state_type state{new detail::zstd_stream<ZSTD_CCtx>};
+    state->context = ::ZSTD_createCCtx();
+    auto ret = ::ZSTD_CCtx_setParameter(state->context, ZSTD_c_compressionLevel, compression);
+    assert(!::ZSTD_isError(ret));
+    return state;
+  }
+
+  static inflate_state_type new_inflate_state()
+  {
+    inflate_state_type state{new state_type};
+    state->context = ::ZSTD_createDCtx();
+    assert(state->context != nullptr);
+    return state;
+  }
+};
 } // namespace decomp_tags
 
 template <typename Tag, typename StreamType = std::ifstream>
@@ -196,13 +304,26 @@ struct inf_istream {
 
     constexpr static std::size_t CHUNK = (1 << 16);
 
+    template <typename T>
+    using has_threaded_inflate = decltype(T::new_inflate_state(1u));
+
+    // Formats that cannot be decoded in parallel do not take a number of threads
+    static typename Tag::inflate_state_type new_inflate_state(unsigned threads)
+    {
+      if constexpr (champsim::is_detected_v<has_threaded_inflate, Tag>) {
+        return Tag::new_inflate_state(threads);
+      } else {
+        return Tag::new_inflate_state();
+      }
+    }
+
     std::array<strm_in_buf_type, CHUNK> in_buf;
     std::array<char_type, CHUNK> out_buf;
-    typename Tag::inflate_state_type strm = Tag::new_inflate_state();
+    typename Tag::inflate_state_type strm;
     typename std::add_pointer<IStrm>::type src;
 
   public:
-    explicit inf_streambuf(IStrm* in) : src(in) {}
+    explicit inf_streambuf(IStrm* in, unsigned decoder_threads = 1) : strm(new_inflate_state(decoder_threads)), src(in) {}
     explicit inf_streambuf(Tag /*tag*/, IStrm* in) : inf_streambuf(in) {}
 
     [[nodiscard]] std::size_t bytes_read() const { return strm->total_out - (this->egptr() - this->gptr()); }
@@ -212,7 +333,7 @@ struct inf_istream {
   };
 
   std::unique_ptr<StreamType> underlying;
-  std::unique_ptr<inf_streambuf<StreamType>> buffer = std::make_unique<inf_streambuf<StreamType>>(underlying.get());
+  std::unique_ptr<inf_streambuf<StreamType>> buffer;
   std::streamsize gcount_ = 0;
   bool eof_ = false;
 
@@ -228,8 +349,17 @@ struct inf_istream {
   [[nodiscard]] bool eof() const { return eof_; }
   [[nodiscard]] std::streamsize gcount() const { return gcount_; }
 
-  explicit inf_istream(std::string s) : underlying(std::make_unique<StreamType>(s)) {}
-  explicit inf_istream(StreamType&& str) : underlying(std::make_unique<StreamType>(std::move(str))) {}
+  /**
+   * Open the named file. If its format can be decoded in parallel, up to ``decoder_threads`` threads decode it.
+   */
+  explicit inf_istream(std::string s, unsigned decoder_threads = 1)
+      : underlying(std::make_unique<StreamType>(s)), buffer(std::make_unique<inf_streambuf<StreamType>>(underlying.get(), decoder_threads))
+  {
+  }
+  explicit inf_istream(StreamType&& str, unsigned decoder_threads = 1)
+      : underlying(std::make_unique<StreamType>(std::move(str))), buffer(std::make_unique<inf_streambuf<StreamType>>(underlying.get(), decoder_threads))
+  {
+  }
 };
 
 template <typename T, typename S>
@@ -241,14 +371,8 @@ auto inf_istream<T, S>::inf_streambuf<I>::underflow() -> int_type
   strm->avail_out = uns_out_buf.size();
   strm->next_out = uns_out_buf.data();
   do {
-    // Check to see if we have consumed all available input
-    if (strm->avail_in == 0) {
-      // Check to see if the input stream is sane
-      if (src->fail()) {
-        this->setg(this->out_buf.data(), this->out_buf.data(), this->out_buf.data());
-        return base_type::underflow();
-      }
-
+    // Check to see if we have consumed all available input, and if the input stream has more
+    if (strm->avail_in == 0 && !src->fail()) {
       // Read data from the stream and convert to zlib-appropriate format
       std::array<char_type, std::tuple_size<decltype(in_buf)>::value> sig_in_buf;
       src->read(sig_in_buf.data(), sig_in_buf.size());
@@ -259,17 +383,21 @@ auto inf_istream<T, S>::inf_streambuf<I>::underflow() -> int_type
       // Record that bytes are available in in_buf
       strm->avail_in = static_cast<unsigned>(src->gcount());
       strm->next_in = in_buf.data();
-
-      // If we failed to get any data
-      if (strm->avail_in == 0) {
-        this->setg(this->out_buf.data(), this->out_buf.data(), this->out_buf.data());
-        return base_type::underflow();
-      }
     }
 
     // Perform inflation
+    auto avail_out_before = strm->avail_out;
     auto result = T::inflate(strm);
     assert(result == T::status_type::CAN_CONTINUE || result == T::status_type::END);
+
+    // Once the input is exhausted, the decoder may still hold output, which is drained until it makes no progress
+    if (strm->avail_in == 0 && src->fail() && strm->avail_out == avail_out_before) {
+      if (strm->avail_out == uns_out_buf.size()) {
+        this->setg(this->out_buf.data(), this->out_buf.data(), this->out_buf.data());
+        return base_type::underflow();
+      }
+      break;
+    }
   }
   // Repeat until we actually get new output
   while (strm->avail_out == uns_out_buf.size());
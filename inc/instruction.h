@@ -29,6 +29,7 @@
 #include "champsim.h"
 #include "chrono.h"
 #include "trace_instruction.h"
+#include "util/inline_vector.h"
 
 // branch types
 enum branch_type {
@@ -119,14 +120,19 @@ struct ooo_model_instr : champsim::program_ordered<ooo_model_instr> {
   unsigned completed_mem_ops = 0;
   int num_reg_dependent = 0;
 
-  std::vector<PHYSICAL_REGISTER_ID> destination_registers = {}; // output registers
-  std::vector<PHYSICAL_REGISTER_ID> source_registers = {};      // input registers
+  // The operands are held inline, bounded by the largest trace format, so that decoding and copying an instruction does not allocate
+  champsim::inline_vector<PHYSICAL_REGISTER_ID, std::max(NUM_INSTR_DESTINATIONS, NUM_INSTR_DESTINATIONS_SPARC)> destination_registers = {}; // output registers
+  champsim::inline_vector<PHYSICAL_REGISTER_ID, NUM_INSTR_SOURCES> source_registers = {};                                                   // input registers
 
-  std::vector<champsim::address> destination_memory = {};
-  std::vector<champsim::address> source_memory = {};
+  champsim::inline_vector<champsim::address, std::max(NUM_INSTR_DESTINATIONS, NUM_INSTR_DESTINATIONS_SPARC)> destination_memory = {};
+  champsim::inline_vector<champsim::address, NUM_INSTR_SOURCES> source_memory = {};
 
-  // these are indices of instructions in the ROB that depend on me
-  std::vector<std::reference_wrapper<ooo_model_instr>> registers_instrs_depend_on_me;
+  // these are the indices of my loads in the LQ, and the position in the SQ of my first store
+  champsim::inline_vector<std::size_t, NUM_INSTR_SOURCES> lq_entries = {};
+  uint64_t sq_position = std::numeric_limits<uint64_t>::max();
+
+  // these are the positions in the ROB of the instructions that wait on my destination registers
+  std::vector<uint64_t> registers_instrs_depend_on_me;
 
 private:
   template <typename T>
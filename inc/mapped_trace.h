@@ -0,0 +1,66 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MAPPED_TRACE_H
+#define MAPPED_TRACE_H
+
+#include <cstddef>
+#include <ios>
+#include <string>
+#include <utility>
+
+namespace champsim
+{
+/**
+ * An uncompressed trace file, mapped into memory and read front to back.
+ *
+ * Readers that know of it can decode records in place with ``take()``. It can also be read like an ``std::istream``,
+ * which copies the bytes out.
+ */
+class mapped_trace
+{
+  const char* begin_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t position = 0;
+  std::streamsize gcount_ = 0;
+  bool eof_ = false;
+
+public:
+  /**
+   * Map the named file.
+   *
+   * \throws std::system_error if the file cannot be opened or mapped.
+   */
+  explicit mapped_trace(const std::string& fname);
+  ~mapped_trace();
+  mapped_trace(const mapped_trace&) = delete;
+  mapped_trace& operator=(const mapped_trace&) = delete;
+  mapped_trace(mapped_trace&& other) noexcept;
+  mapped_trace& operator=(mapped_trace&& other) noexcept;
+
+  /**
+   * Consume up to ``count`` bytes, and return the range they occupy in the mapping.
+   * The range remains valid for the lifetime of this object.
+   */
+  std::pair<const char*, const char*> take(std::size_t count);
+
+  mapped_trace& read(char* s, std::streamsize count);
+  [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+  [[nodiscard]] bool eof() const { return eof_; }
+};
+} // namespace champsim
+
+#endif
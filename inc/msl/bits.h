@@ -61,6 +61,25 @@ constexpr bool is_power_of_2(T n)
   return (n == T{1} << lg2(n));
 }
 
+/**
+ * A backport of ``std::countr_zero()`` for 64-bit integers.
+ */
+constexpr int countr_zero(uint64_t n)
+{
+  if (n == 0) {
+    return std::numeric_limits<uint64_t>::digits;
+  }
+#if defined(__GNUC__)
+  return __builtin_ctzll(n);
+#else
+  int result = 0;
+  for (; (n & 1) == 0; n >>= 1) {
+    ++result;
+  }
+  return result;
+#endif
+}
+
 /**
  * Compute an integer power.
  * This function may overflow very easily. Use only for small bases or very small exponents.
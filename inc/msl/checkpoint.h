@@ -0,0 +1,208 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_CHECKPOINT_H
+#define MSL_CHECKPOINT_H
+
+#include <cstdint>
+#include <iterator>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "util/detect.h"
+#include "util/type_traits.h"
+
+namespace champsim::msl
+{
+namespace detail
+{
+template <typename T>
+using has_checkpoint_member = decltype(std::declval<const T&>().checkpoint(std::declval<std::ostream&>()));
+
+template <typename T>
+using has_restore_member = decltype(std::declval<T&>().restore(std::declval<std::istream&>()));
+
+template <typename T>
+using has_data = decltype(std::data(std::declval<T&>()));
+
+template <typename T>
+using has_resize = decltype(std::declval<T&>().resize(std::size_t{}));
+
+template <typename T>
+using has_mapped_type = typename T::mapped_type;
+
+template <typename T>
+using has_begin = decltype(std::begin(std::declval<T&>()));
+
+template <typename T>
+inline constexpr bool is_contiguous_trivial_v = is_detected_v<has_data, T> && is_detected_v<has_resize, T>
+                                                && std::is_trivially_copyable_v<std::remove_pointer_t<detected_t<has_data, T>>>;
+
+template <typename>
+inline constexpr bool dependent_false_v = false;
+} // namespace detail
+
+/**
+ * Write the value to the checkpoint stream.
+ *
+ * Trivially copyable types are written as their object representation.
+ * Pairs, tuples, and containers are written element by element, with containers prefixed by their size.
+ * Any other type must provide a member function ``void checkpoint(std::ostream&) const``.
+ */
+template <typename T>
+void checkpoint(std::ostream& stream, const T& value)
+{
+  if constexpr (is_detected_v<detail::has_checkpoint_member, T>) {
+    value.checkpoint(stream);
+  } else if constexpr (std::is_trivially_copyable_v<T>) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  } else if constexpr (is_specialization_v<T, std::pair>) {
+    checkpoint(stream, value.first);
+    checkpoint(stream, value.second);
+  } else if constexpr (is_specialization_v<T, std::tuple>) {
+    std::apply([&](const auto&... elem) { (..., checkpoint(stream, elem)); }, value);
+  } else if constexpr (detail::is_contiguous_trivial_v<T>) {
+    checkpoint(stream, static_cast<uint64_t>(std::size(value)));
+    stream.write(reinterpret_cast<const char*>(std::data(value)), static_cast<std::streamsize>(std::size(value) * sizeof(*std::data(value))));
+  } else if constexpr (is_detected_v<detail::has_begin, T>) {
+    checkpoint(stream, static_cast<uint64_t>(std::size(value)));
+    for (const auto& elem : value) {
+      checkpoint(stream, elem);
+    }
+  } else {
+    static_assert(detail::dependent_false_v<T>, "This type cannot be written to a checkpoint");
+  }
+}
+
+/**
+ * Read a value from the checkpoint stream, in the format written by champsim::msl::checkpoint().
+ * Any type that is not handled by default must provide a member function ``void restore(std::istream&)``.
+ *
+ * \throws std::runtime_error if the stream ends early, or if a fixed-size container does not match the size that was written.
+ */
+template <typename T>
+void restore(std::istream& stream, T& value)
+{
+  if constexpr (is_detected_v<detail::has_restore_member, T>) {
+    value.restore(stream);
+  } else if constexpr (std::is_trivially_copyable_v<T>) {
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+  } else if constexpr (is_specialization_v<T, std::pair>) {
+    restore(stream, value.first);
+    restore(stream, value.second);
+  } else if constexpr (is_specialization_v<T, std::tuple>) {
+    std::apply([&](auto&... elem) { (..., restore(stream, elem)); }, value);
+  } else if constexpr (is_detected_v<detail::has_mapped_type, T>) {
+    uint64_t size{};
+    restore(stream, size);
+    value.clear();
+    for (uint64_t i = 0; i < size && stream; ++i) {
+      std::pair<typename T::key_type, typename T::mapped_type> elem{};
+      restore(stream, elem);
+      value.insert(std::move(elem));
+    }
+  } else if constexpr (detail::is_contiguous_trivial_v<T>) {
+    uint64_t size{};
+    restore(stream, size);
+    value.resize(size);
+    stream.read(reinterpret_cast<char*>(std::data(value)), static_cast<std::streamsize>(std::size(value) * sizeof(*std::data(value))));
+  } else if constexpr (is_detected_v<detail::has_begin, T>) {
+    uint64_t size{};
+    restore(stream, size);
+    if constexpr (is_detected_v<detail::has_resize, T> && std::is_default_constructible_v<typename T::value_type>) {
+      value.resize(size);
+    } else if (size != std::size(value)) {
+      throw std::runtime_error{"Checkpoint contains " + std::to_string(size) + " elements where " + std::to_string(std::size(value)) + " were expected"};
+    }
+    for (auto& elem : value) {
+      restore(stream, elem);
+    }
+  } else {
+    static_assert(detail::dependent_false_v<T>, "This type cannot be read from a checkpoint");
+  }
+
+  if (!stream) {
+    throw std::runtime_error{"Checkpoint ended unexpectedly"};
+  }
+}
+
+/**
+ * Write a block of checkpoint data, labelled with the given name.
+ * The block is produced by calling ``func`` with a stream to write to.
+ */
+template <typename F>
+void checkpoint_block(std::ostream& stream, const std::string& name, F&& func)
+{
+  std::ostringstream block;
+  std::forward<F>(func)(static_cast<std::ostream&>(block));
+  checkpoint(stream, name);
+  checkpoint(stream, std::move(block).str());
+}
+
+/**
+ * Read a block of checkpoint data written by champsim::msl::checkpoint_block().
+ * If the block's label matches the given name, ``func`` is called with a stream to read from.
+ * Otherwise, or if the stream has no more blocks, the block is skipped.
+ *
+ * \returns whether the block was restored.
+ */
+template <typename F>
+bool restore_block(std::istream& stream, const std::string& name, F&& func)
+{
+  if (stream.peek() == std::istream::traits_type::eof()) {
+    return false;
+  }
+
+  std::string block_name;
+  std::string block;
+  restore(stream, block_name);
+  restore(stream, block);
+  if (block_name != name) {
+    return false;
+  }
+
+  std::istringstream block_stream{block};
+  std::forward<F>(func)(static_cast<std::istream&>(block_stream));
+  return true;
+}
+
+/**
+ * Read every remaining block of checkpoint data written by champsim::msl::checkpoint_block(), so that they can be restored in any order.
+ *
+ * \returns the contents of each block, by its label.
+ */
+inline std::map<std::string, std::string> restore_blocks(std::istream& stream)
+{
+  std::map<std::string, std::string> blocks;
+  while (stream.peek() != std::istream::traits_type::eof()) {
+    std::string block_name;
+    std::string block;
+    restore(stream, block_name);
+    restore(stream, block);
+    blocks.insert_or_assign(std::move(block_name), std::move(block));
+  }
+  return blocks;
+}
+} // namespace champsim::msl
+
+#endif
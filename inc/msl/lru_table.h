@@ -22,12 +22,14 @@
 #include <cstdint>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "extent.h"
 #include "msl/bits.h"
+#include "msl/checkpoint.h"
 #include "util/detect.h"
 #include "util/span.h"
 #include "util/type_traits.h"
@@ -165,6 +167,24 @@ public:
     return std::exchange(*hit, {}).data;
   }
 
+  void checkpoint(std::ostream& stream) const
+  {
+    msl::checkpoint(stream, std::pair{NUM_SET, NUM_WAY});
+    msl::checkpoint(stream, access_count);
+    msl::checkpoint(stream, block);
+  }
+
+  void restore(std::istream& stream)
+  {
+    std::pair<diff_type, diff_type> shape{};
+    msl::restore(stream, shape);
+    if (shape != std::pair{NUM_SET, NUM_WAY})
+      throw std::runtime_error{"Checkpoint of a " + std::to_string(shape.first) + "x" + std::to_string(shape.second) + " table cannot be restored to a "
+                               + std::to_string(NUM_SET) + "x" + std::to_string(NUM_WAY) + " table"};
+    msl::restore(stream, access_count);
+    msl::restore(stream, block);
+  }
+
   lru_table(std::size_t sets, std::size_t ways, SetProj set_proj, TagProj tag_proj)
       : set_projection(set_proj), tag_projection(tag_proj), NUM_SET(static_cast<diff_type>(sets)), NUM_WAY(static_cast<diff_type>(ways)), block(sets * ways)
   {
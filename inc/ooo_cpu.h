@@ -24,13 +24,18 @@
 
 #include <array>
 #include <bitset>
-#include <deque>
+#include <functional>
+#include <istream>
 #include <limits>
+#include <map>
 #include <memory>
 #include <optional>
+#include <ostream>
 #include <queue>
 #include <stdexcept>
 #include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "bandwidth.h"
@@ -40,8 +45,10 @@
 #include "core_stats.h"
 #include "instruction.h"
 #include "modules.h"
+#include "msl/checkpoint.h"
 #include "operable.h"
 #include "register_allocator.h"
+#include "util/circular_buffer.h"
 #include "util/lru_table.h"
 #include "util/to_underlying.h"
 
@@ -72,11 +79,12 @@ struct LSQ_ENTRY : champsim::program_ordered<LSQ_ENTRY> {
   bool fetch_issued = false;
 
   uint64_t producer_id = std::numeric_limits<uint64_t>::max();
+  uint64_t rob_position = std::numeric_limits<uint64_t>::max();
   std::vector<std::reference_wrapper<std::optional<LSQ_ENTRY>>> lq_depend_on_me{};
 
   LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY>::id_type id, champsim::address ip, std::array<uint8_t, 2> asid);
   void finish(ooo_model_instr& rob_entry) const;
-  void finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const;
+  void finish(champsim::circular_buffer<ooo_model_instr>& rob) const;
 };
 
 // cpu
@@ -111,14 +119,28 @@ public:
   dib_type DIB;
 
   // reorder buffer, load/store queue, register file
-  std::deque<ooo_model_instr> IFETCH_BUFFER;
-  std::deque<ooo_model_instr> DISPATCH_BUFFER;
-  std::deque<ooo_model_instr> DECODE_BUFFER;
-  std::deque<ooo_model_instr> ROB;
-  std::deque<ooo_model_instr> DIB_HIT_BUFFER;
+  champsim::circular_buffer<ooo_model_instr> IFETCH_BUFFER;
+  champsim::circular_buffer<ooo_model_instr> DISPATCH_BUFFER;
+  champsim::circular_buffer<ooo_model_instr> DECODE_BUFFER;
+  champsim::circular_buffer<ooo_model_instr> ROB;
+  champsim::circular_buffer<ooo_model_instr> DIB_HIT_BUFFER;
 
   std::vector<std::optional<LSQ_ENTRY>> LQ;
-  std::deque<LSQ_ENTRY> SQ;
+  champsim::circular_buffer<LSQ_ENTRY> SQ;
+
+  // indices of the unallocated LQ entries, lowest first, and of the issued LQ entries by the block they read
+  std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> lq_free_entries;
+  std::multimap<champsim::block_number, std::size_t> lq_issued_entries;
+
+  // positions of the stores in the SQ to each address, oldest first
+  std::unordered_map<uint64_t, std::vector<uint64_t>> sq_forwarding_table;
+
+  // positions in the ROB of the instructions whose source registers have been produced, and of those that are executing, in program order
+  std::vector<uint64_t> ready_to_execute;
+  std::vector<uint64_t> executing;
+
+  // position in the ROB of the instruction that produces each physical register
+  std::vector<uint64_t> register_producer;
 
   // Constants
   const std::size_t IFETCH_BUFFER_SIZE, DISPATCH_BUFFER_SIZE, DECODE_BUFFER_SIZE, REGISTER_FILE_SIZE, ROB_SIZE, SQ_SIZE, DIB_HIT_BUFFER_SIZE;
@@ -140,15 +162,26 @@ public:
   champsim::chrono::clock::time_point fetch_resume_time{};
 
   const long IN_QUEUE_SIZE;
-  std::deque<ooo_model_instr> input_queue;
+  champsim::circular_buffer<ooo_model_instr> input_queue;
 
   CacheBus L1I_bus, L1D_bus;
   CACHE* l1i;
 
+  [[nodiscard]] std::array<champsim::channel*, 2> lower_levels() const;
+
   void initialize() final;
   long operate() final;
   void begin_phase() final;
   void end_phase(unsigned cpu) final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
+  void checkpoint(std::ostream& stream) const final;
+  void restore(std::istream& stream) final;
+
+  /**
+   * Retire the instruction immediately, without modelling the pipeline.
+   * The branch predictor and the decoded instruction buffer are updated, and the instruction's memory accesses are sent through ``forward``.
+   */
+  void functional_operate(ooo_model_instr instr, const champsim::functional_forward_type& forward);
 
   void initialize_instruction();
   long check_dib();
@@ -166,14 +199,17 @@ public:
   bool do_init_instruction(ooo_model_instr& instr);
   bool do_predict_branch(ooo_model_instr& instr);
   void do_check_dib(ooo_model_instr& instr);
-  bool do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end);
+  bool do_fetch_instruction(champsim::circular_buffer<ooo_model_instr>::iterator begin, champsim::circular_buffer<ooo_model_instr>::iterator end);
   void do_dib_update(const ooo_model_instr& instr);
-  void do_scheduling(ooo_model_instr& instr);
+  void do_scheduling(ooo_model_instr& instr, uint64_t rob_position);
   void do_execution(ooo_model_instr& instr);
   void do_memory_scheduling(ooo_model_instr& instr);
   void do_complete_execution(ooo_model_instr& instr);
+  void do_wakeup(const ooo_model_instr& producer);
   void do_sq_forward_to_lq(LSQ_ENTRY& sq_entry, LSQ_ENTRY& lq_entry);
 
+  void do_release_load(std::optional<LSQ_ENTRY>& lq_entry);
+
   void do_finish_store(const LSQ_ENTRY& sq_entry);
   bool do_complete_store(const LSQ_ENTRY& sq_entry);
   bool execute_load(const LSQ_ENTRY& lq_entry);
@@ -193,6 +229,8 @@ public:
     virtual void impl_initialize_branch_predictor() = 0;
     virtual void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) = 0;
     virtual bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) = 0;
+    virtual void impl_checkpoint_branch_predictor(std::ostream& stream) = 0;
+    virtual bool impl_restore_branch_predictor(std::istream& stream) = 0;
   };
 
   struct btb_module_concept {
@@ -201,6 +239,8 @@ public:
     virtual void impl_initialize_btb() = 0;
     virtual void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) = 0;
     virtual std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) = 0;
+    virtual void impl_checkpoint_btb(std::ostream& stream) = 0;
+    virtual bool impl_restore_btb(std::istream& stream) = 0;
   };
 
   template <typename... Bs>
@@ -211,6 +251,8 @@ public:
     void impl_initialize_branch_predictor() final;
     void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
     [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) final;
+    void impl_checkpoint_branch_predictor(std::ostream& stream) final;
+    [[nodiscard]] bool impl_restore_branch_predictor(std::istream& stream) final;
   };
 
   template <typename... Ts>
@@ -221,6 +263,8 @@ public:
     void impl_initialize_btb() final;
     void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) final;
     [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) final;
+    void impl_checkpoint_btb(std::ostream& stream) final;
+    [[nodiscard]] bool impl_restore_btb(std::istream& stream) final;
   };
 
   std::unique_ptr<branch_module_concept> branch_module_pimpl;
@@ -230,27 +274,37 @@ public:
   void impl_initialize_branch_predictor() const;
   void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const;
   [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) const;
+  void impl_checkpoint_branch_predictor(std::ostream& stream) const;
+  [[nodiscard]] bool impl_restore_branch_predictor(std::istream& stream) const;
 
   void impl_initialize_btb() const;
   void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) const;
   [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) const;
+  void impl_checkpoint_btb(std::ostream& stream) const;
+  [[nodiscard]] bool impl_restore_btb(std::istream& stream) const;
   // NOLINTEND(readability-make-member-function-const)
 
   template <typename... Bs, typename... Ts>
   explicit O3_CPU(champsim::core_builder<champsim::core_builder_module_type_holder<Bs...>, champsim::core_builder_module_type_holder<Ts...>> b)
       : champsim::operable(b.m_clock_period), cpu(b.m_cpu),
         DIB(b.m_dib_set, b.m_dib_way, {champsim::data::bits{champsim::lg2(b.m_dib_window)}}, {champsim::data::bits{champsim::lg2(b.m_dib_window)}}),
-        LQ(b.m_lq_size), IFETCH_BUFFER_SIZE(b.m_ifetch_buffer_size), DISPATCH_BUFFER_SIZE(b.m_dispatch_buffer_size), DECODE_BUFFER_SIZE(b.m_decode_buffer_size),
+        IFETCH_BUFFER(b.m_ifetch_buffer_size), DISPATCH_BUFFER(b.m_dispatch_buffer_size), DECODE_BUFFER(b.m_decode_buffer_size), ROB(b.m_rob_size),
+        DIB_HIT_BUFFER(b.m_dib_hit_buffer_size), LQ(b.m_lq_size), SQ(b.m_sq_size), register_producer(b.m_register_file_size, std::numeric_limits<uint64_t>::max()),
+        IFETCH_BUFFER_SIZE(b.m_ifetch_buffer_size), DISPATCH_BUFFER_SIZE(b.m_dispatch_buffer_size), DECODE_BUFFER_SIZE(b.m_decode_buffer_size),
         REGISTER_FILE_SIZE(b.m_register_file_size), ROB_SIZE(b.m_rob_size), SQ_SIZE(b.m_sq_size), DIB_HIT_BUFFER_SIZE(b.m_dib_hit_buffer_size),
         FETCH_WIDTH(b.m_fetch_width), DECODE_WIDTH(b.m_decode_width), DISPATCH_WIDTH(b.m_dispatch_width), SCHEDULER_SIZE(b.m_schedule_width),
         EXEC_WIDTH(b.m_execute_width), DIB_INORDER_WIDTH(b.m_dib_inorder_width), LQ_WIDTH(b.m_lq_width), SQ_WIDTH(b.m_sq_width), RETIRE_WIDTH(b.m_retire_width),
         BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
         DECODE_LATENCY(b.m_decode_latency * b.m_clock_period), SCHEDULING_LATENCY(b.m_schedule_latency * b.m_clock_period),
         EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), L1I_BANDWIDTH(b.m_l1i_bw),
-        L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
+        L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)),
+        input_queue(static_cast<std::size_t>(IN_QUEUE_SIZE)), L1I_bus(b.m_cpu, b.m_fetch_queues),
         L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
         btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
   {
+    for (std::size_t i = 0; i < std::size(LQ); ++i) {
+      lq_free_entries.push(i);
+    }
   }
 };
 
@@ -311,6 +365,36 @@ bool O3_CPU::branch_module_model<Bs...>::impl_predict_branch(champsim::address i
   return return_type{};
 }
 
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_checkpoint_branch_predictor(std::ostream& stream)
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    champsim::msl::checkpoint_block(stream, typeid(b).name(), [&](std::ostream& block) {
+      if constexpr (branch_predictor::has_checkpoint<decltype(b), std::ostream&>)
+        b.checkpoint_branch_predictor(block);
+    });
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
+template <typename... Bs>
+bool O3_CPU::branch_module_model<Bs...>::impl_restore_branch_predictor(std::istream& stream)
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    return champsim::msl::restore_block(stream, typeid(b).name(), [&](std::istream& block) {
+      if constexpr (branch_predictor::has_restore<decltype(b), std::istream&>)
+        b.restore_branch_predictor(block);
+    });
+  };
+
+  bool restored_all = true;
+  std::apply([&](auto&... b) { (..., (restored_all = process_one(b) && restored_all)); }, intern_);
+  return restored_all;
+}
+
 template <typename... Ts>
 void O3_CPU::btb_module_model<Ts...>::impl_initialize_btb()
 {
@@ -369,6 +453,36 @@ std::pair<champsim::address, bool> O3_CPU::btb_module_model<Ts...>::impl_btb_pre
   return return_type{};
 }
 
+template <typename... Ts>
+void O3_CPU::btb_module_model<Ts...>::impl_checkpoint_btb(std::ostream& stream)
+{
+  [[maybe_unused]] auto process_one = [&](auto& t) {
+    using namespace champsim::modules;
+    champsim::msl::checkpoint_block(stream, typeid(t).name(), [&](std::ostream& block) {
+      if constexpr (btb::has_checkpoint<decltype(t), std::ostream&>)
+        t.checkpoint_btb(block);
+    });
+  };
+
+  std::apply([&](auto&... t) { (..., process_one(t)); }, intern_);
+}
+
+template <typename... Ts>
+bool O3_CPU::btb_module_model<Ts...>::impl_restore_btb(std::istream& stream)
+{
+  [[maybe_unused]] auto process_one = [&](auto& t) {
+    using namespace champsim::modules;
+    return champsim::msl::restore_block(stream, typeid(t).name(), [&](std::istream& block) {
+      if constexpr (btb::has_restore<decltype(t), std::istream&>)
+        t.restore_btb(block);
+    });
+  };
+
+  bool restored_all = true;
+  std::apply([&](auto&... t) { (..., (restored_all = process_one(t) && restored_all)); }, intern_);
+  return restored_all;
+}
+
 #ifdef SET_ASIDE_CHAMPSIM_MODULE
 #undef SET_ASIDE_CHAMPSIM_MODULE
 #define CHAMPSIM_MODULE
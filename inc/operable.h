@@ -17,6 +17,11 @@
 #ifndef OPERABLE_H
 #define OPERABLE_H
 
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <vector>
+
 #include "chrono.h"
 
 namespace champsim
@@ -35,15 +40,64 @@ public:
   long _operate();
   long operate_on(const champsim::chrono::clock& clock);
 
+  void _skip(long cycles);
+  void skip_on(const champsim::chrono::clock& clock);
+
+  /**
+   * The earliest time at which a call to operate() might change the state of this object.
+   * Every cycle that begins before this time may be skipped without being operated.
+   * The default is the next cycle, which never permits skipping.
+   */
+  [[nodiscard]] virtual champsim::chrono::clock::time_point next_event_time() const;
+
   virtual void initialize() {} // LCOV_EXCL_LINE
   virtual long operate() = 0;
   virtual void begin_phase() {}                     // LCOV_EXCL_LINE
   virtual void end_phase(unsigned /*cpu index*/) {} // LCOV_EXCL_LINE
   virtual void print_deadlock() {}                  // LCOV_EXCL_LINE
+  virtual void skip_cycles(long /*cycles*/) {}      // LCOV_EXCL_LINE
+
+  /**
+   * Save and restore the state that this object accumulates while warming up.
+   * The default has no such state.
+   */
+  virtual void checkpoint(std::ostream& /*stream*/) const {} // LCOV_EXCL_LINE
+  virtual void restore(std::istream& /*stream*/) {}          // LCOV_EXCL_LINE
 
   [[deprecated]] uint64_t current_cycle() const;
 };
 
+/**
+ * A fixed set of operables, grouped by clock domain, that can be visited in order of their local time.
+ * The schedule is built once, and ordering it again does not allocate.
+ */
+class operable_schedule
+{
+  struct entry {
+    std::size_t index;
+    std::reference_wrapper<operable> op;
+  };
+
+  struct clock_domain {
+    champsim::chrono::picoseconds clock_period;
+    std::vector<entry> members{};
+    std::vector<entry>::const_iterator next{};
+  };
+
+  std::vector<clock_domain> domains{};
+  std::vector<std::reference_wrapper<operable>> order{};
+  std::size_t num_operables = 0;
+
+public:
+  explicit operable_schedule(const std::vector<std::reference_wrapper<operable>>& operables);
+
+  /**
+   * Order the operables by their local time. Operables with the same local time keep their original order.
+   * The returned sequence is valid until the next call.
+   */
+  const std::vector<std::reference_wrapper<operable>>& sorted();
+};
+
 } // namespace champsim
 
 #endif
@@ -0,0 +1,112 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "operable.h"
+
+namespace champsim
+{
+struct environment;
+
+/**
+ * Options for simulating the cores of a multicore system on separate threads.
+ */
+struct parallel_options {
+  /**
+   * The number of threads to simulate with. A value of 1 simulates every component serially, cycle by cycle.
+   * Only a serial simulation skips over the cycles in which no component can act; a parallel one simulates every cycle.
+   */
+  std::size_t threads = 1;
+
+  /**
+   * The number of cycles that each core may run ahead of the shared components before they are synchronized.
+   * Responses from the shared components may be delayed by up to this many cycles.
+   * A period in which nothing progresses counts as this many stalled cycles, so it must be less than ``deadlock_cycles``.
+   */
+  long sync_cycles = 100;
+};
+
+/**
+ * The operables of an environment, divided into those private to a single core and those shared between cores.
+ */
+struct operable_partition {
+  /**
+   * The operables reachable from only one core, indexed in the same order as environment::cpu_view().
+   * Each group includes its core.
+   */
+  std::vector<std::vector<std::reference_wrapper<operable>>> private_groups{};
+
+  /**
+   * The operables that are reachable from more than one core, or that are not reachable from any core.
+   * Page table walkers are always shared, because the page table is.
+   */
+  std::vector<std::reference_wrapper<operable>> shared{};
+};
+
+/**
+ * Divide the operables of the environment by following the channels down from each core.
+ */
+operable_partition partition_operables(environment& env);
+
+/**
+ * A fixed set of threads that run batches of jobs.
+ * The calling thread participates in each batch.
+ */
+class worker_pool
+{
+  std::vector<std::thread> threads{};
+
+  std::mutex mutex{};
+  std::condition_variable work_available{};
+  std::condition_variable work_finished{};
+
+  std::function<void(std::size_t)> current_job{};
+  std::size_t num_jobs = 0;
+  std::size_t next_job = 0;
+  std::size_t jobs_remaining = 0;
+  unsigned long generation = 0;
+  bool stopping = false;
+  std::exception_ptr failure{};
+
+  void work();
+  void drain(std::unique_lock<std::mutex>& lock);
+
+public:
+  explicit worker_pool(std::size_t num_threads);
+  ~worker_pool();
+
+  worker_pool(const worker_pool&) = delete;
+  worker_pool& operator=(const worker_pool&) = delete;
+
+  /**
+   * Run the job once for each index in [0, count), and wait for all of them to finish.
+   * If any job throws, the first exception is rethrown here after the batch completes.
+   */
+  void run(std::size_t count, std::function<void(std::size_t)> job);
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARALLEL_ZSTD_H
+#define PARALLEL_ZSTD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <ios>
+#include <memory>
+#include <string>
+#include <vector>
+#include <zstd.h>
+
+#include "inf_stream.h"
+#include "mapped_trace.h"
+#include "seekable_zstd.h"
+
+namespace champsim
+{
+/**
+ * A Zstandard-compressed file, decoded by several threads at once.
+ *
+ * A file made of several frames, as written by ``pzstd`` or by concatenating compressed files, has its frames decoded in parallel,
+ * up to ``threads`` frames ahead of the reader. A frame whose decoded size is not recorded in its header, or that is too large to
+ * hold in memory, is instead decoded in pieces on the reading thread, as a single-frame file is.
+ *
+ * A file written by ``seekable_zstd::writer`` also carries a table of its frames, which allows reading to begin at any point.
+ */
+class parallel_zstd_istream
+{
+  using buffer_type = std::vector<char>;
+  constexpr static std::size_t max_frame_size = std::size_t{1} << 28;
+
+  struct dctx_deleter {
+    void operator()(ZSTD_DCtx* dctx) { ::ZSTD_freeDCtx(dctx); }
+  };
+
+  mapped_trace file;
+  const char* begin = nullptr;
+  const char* next_frame = nullptr;
+  const char* end = nullptr;
+  std::size_t threads;
+  std::vector<seekable_zstd::frame_location> frames{}; // from the seek table, if the file has one
+
+  std::deque<std::future<buffer_type>> pending{};
+
+  // A frame being decoded on this thread
+  std::unique_ptr<ZSTD_DCtx, dctx_deleter> stream{};
+  ZSTD_inBuffer stream_input{};
+
+  buffer_type current{};
+  std::size_t current_offset = 0;
+  uint64_t position = 0; // in the decompressed file
+  std::streamsize gcount_ = 0;
+  bool eof_ = false;
+
+  [[nodiscard]] bool frames_exhausted() const { return stream == nullptr && std::empty(pending) && next_frame == end; }
+  bool next_frame_is_parallel() const;
+  void launch();
+  void refill();
+  uint64_t discard(uint64_t count);
+
+public:
+  /**
+   * Map the named file.
+   *
+   * \throws std::system_error if the file cannot be opened or mapped.
+   */
+  explicit parallel_zstd_istream(const std::string& fname, std::size_t threads_ = 1);
+
+  parallel_zstd_istream& read(char* s, std::streamsize count);
+
+  /**
+   * Whether the file has a seek table, so that reading can continue from any point.
+   */
+  [[nodiscard]] bool seekable() const { return !std::empty(frames); }
+
+  /**
+   * Continue reading from the given offset into the decompressed file, decoding only the frame that holds it.
+   *
+   * \throws std::logic_error if the file has no seek table.
+   */
+  void seek(uint64_t offset);
+
+  /**
+   * Pass over up to ``count`` decompressed bytes, stopping early at the end of the file. If the file has a seek table, the frames
+   * wholly within the skipped bytes are not decoded.
+   *
+   * \return the number of bytes skipped.
+   */
+  uint64_t skip(uint64_t count);
+  [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+  [[nodiscard]] bool eof() const { return eof_; }
+};
+} // namespace champsim
+
+#endif
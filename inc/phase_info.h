@@ -18,6 +18,7 @@
 #define PHASE_INFO_H
 
 #include <cstdint>
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -36,6 +37,9 @@ struct phase_info {
   long long length;
   std::vector<std::size_t> trace_index;
   std::vector<std::string> trace_names;
+  long long fast_forward = 0; // Instructions read from each trace and discarded before the phase begins
+  double weight = 1;          // The weight of this phase's statistics in a weighted aggregate
+  bool functional = false;    // Whether the phase bypasses the timing model
 };
 
 struct phase_stats {
@@ -44,8 +48,46 @@ struct phase_stats {
   std::vector<O3_CPU::stats_type> roi_cpu_stats, sim_cpu_stats;
   std::vector<CACHE::stats_type> roi_cache_stats, sim_cache_stats;
   std::vector<DRAM_CHANNEL::stats_type> roi_dram_stats, sim_dram_stats;
+  double weight = 1;
 };
 
+/**
+ * Produce a warmup phase followed by a simulation phase, each running every trace from where the last left off.
+ */
+std::vector<phase_info> default_phases(long long warmup_instructions, long long simulation_instructions, const std::vector<std::string>& trace_names);
+
+/**
+ * A region of a trace to be simulated in detail, such as a simulation point.
+ */
+struct region_info {
+  long long start;
+  long long length;
+  double weight;
+};
+
+/**
+ * Read a list of regions, one per line, each given as the starting instruction, the length, and the weight.
+ * Blank lines and lines beginning with '#' are ignored. The regions are returned in the order of their starting instructions.
+ *
+ * \throws std::invalid_argument if a line is malformed or if two regions overlap.
+ */
+std::vector<region_info> read_regions(std::istream& stream);
+
+/**
+ * Produce the phases that simulate each region in turn.
+ * Each region is preceded by a warmup phase of up to the given length, and the traces are fast-forwarded through the instructions between them.
+ * The warmup is also where the instructions in flight from the previous region retire, so it should be at least as long as the ROB.
+ *
+ * \throws std::invalid_argument if a region other than the first would have no warmup, because it begins where the previous region ends or
+ * because the warmup length is zero.
+ */
+std::vector<phase_info> region_phases(const std::vector<region_info>& regions, long long warmup_instructions, const std::vector<std::string>& trace_names);
+
+/**
+ * Combine the statistics of several phases, scaling each by its weight relative to the sum of the weights.
+ */
+phase_stats weighted_phase_stats(std::string name, const std::vector<phase_stats>& stats);
+
 } // namespace champsim
 
 #endif
@@ -95,8 +95,21 @@ public:
 
   long operate() final;
 
+  /**
+   * Walk the page table for the given request without modelling its timing, warming the paging structure caches.
+   * The reads of the page table are sent through ``forward``.
+   *
+   * \returns the physical page holding the requested address
+   */
+  champsim::address functional_translate(const request_type& handle_pkt, const champsim::functional_forward_type& forward);
+
+  [[nodiscard]] const std::vector<channel_type*>& upper_channels() const { return upper_levels; }
+
   void begin_phase() final;
   void print_deadlock() final;
+  [[nodiscard]] champsim::chrono::clock::time_point next_event_time() const final;
+  void checkpoint(std::ostream& stream) const final;
+  void restore(std::istream& stream) final;
 };
 
 #endif
@@ -17,6 +17,7 @@
 #ifndef REPEATABLE_H
 #define REPEATABLE_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <fmt/ranges.h>
@@ -33,17 +34,36 @@ struct repeatable {
   T intern_{std::apply([](auto... x) { return T{x...}; }, args_)};
   explicit repeatable(Args... args) : args_(args...) {}
 
-  auto operator()()
+  // Reopen trace if we've reached the end of the file
+  void reopen_at_end()
   {
-    // Reopen trace if we've reached the end of the file
     if (intern_.eof()) {
       fmt::print("*** Reached end of trace: {}\n", args_);
       intern_ = T{std::apply([](auto... x) { return T{x...}; }, args_)};
     }
+  }
 
+  auto operator()()
+  {
+    reopen_at_end();
     return intern_();
   }
 
+  template <typename U = T>
+  auto skip(uint64_t count) -> decltype(std::declval<U&>().skip(count))
+  {
+    uint64_t skipped = 0;
+    while (skipped < count) {
+      reopen_at_end();
+      auto step = intern_.skip(count - skipped);
+      if (step == 0) {
+        break; // The trace is empty
+      }
+      skipped += step;
+    }
+    return skipped;
+  }
+
   [[nodiscard]] bool eof() const { return false; }
 };
 } // namespace champsim
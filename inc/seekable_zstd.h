@@ -0,0 +1,176 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SEEKABLE_ZSTD_H
+#define SEEKABLE_ZSTD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zstd.h>
+
+namespace champsim
+{
+/**
+ * Traces stored as a series of independently compressed Zstandard frames, followed by a table of the frames' sizes.
+ *
+ * The table follows the Zstandard seekable format: it is a skippable frame, so the file remains an ordinary Zstandard file,
+ * and it can be read with the tools in Zstandard's contrib/seekable_format. Each frame holds a whole number of trace records
+ * and records its decoded size, so that the frames can be decoded in parallel, and a reader can begin at any frame.
+ */
+namespace seekable_zstd
+{
+constexpr uint32_t skippable_magic = 0x184D2A5E;
+constexpr uint32_t seekable_magic = 0x8F92EAB1;
+constexpr std::size_t footer_size = 9;
+constexpr std::size_t entry_size = 8;
+constexpr unsigned char checksum_flag = 0x80;
+
+/**
+ * The position of a frame in the compressed file, and of its contents in the decompressed trace.
+ */
+struct frame_location {
+  uint64_t compressed_offset;
+  uint64_t decompressed_offset;
+};
+
+namespace detail
+{
+inline uint32_t read_le32(const unsigned char* p) { return uint32_t{p[0]} | (uint32_t{p[1]} << 8) | (uint32_t{p[2]} << 16) | (uint32_t{p[3]} << 24); }
+
+inline void write_le32(std::ostream& out, uint32_t value)
+{
+  for (int i = 0; i < 4; ++i) {
+    out.put(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+} // namespace detail
+
+/**
+ * Read the table at the end of the file.
+ *
+ * \return the location of each frame, followed by the end of the frames, or an empty list if the file has no table.
+ * \throws std::runtime_error if the table is malformed.
+ */
+inline std::vector<frame_location> read_seek_table(const char* begin, const char* end)
+{
+  auto size = static_cast<std::size_t>(end - begin);
+  const auto* bytes = reinterpret_cast<const unsigned char*>(begin);
+  if (size < footer_size || detail::read_le32(bytes + size - 4) != seekable_magic) {
+    return {};
+  }
+
+  auto num_frames = std::size_t{detail::read_le32(bytes + size - footer_size)};
+  auto descriptor = bytes[size - 5];
+  auto this_entry_size = entry_size + ((descriptor & checksum_flag) != 0 ? 4 : 0);
+  auto table_size = 8 + num_frames * this_entry_size + footer_size;
+  if (table_size > size || detail::read_le32(bytes + size - table_size) != skippable_magic) {
+    throw std::runtime_error{"The trace's seek table is malformed"};
+  }
+
+  std::vector<frame_location> frames{{0, 0}};
+  const auto* entry = bytes + size - table_size + 8;
+  for (std::size_t i = 0; i < num_frames; ++i, entry += this_entry_size) {
+    auto last = frames.back();
+    frames.push_back({last.compressed_offset + detail::read_le32(entry), last.decompressed_offset + detail::read_le32(entry + 4)});
+  }
+
+  if (frames.back().compressed_offset != size - table_size) {
+    throw std::runtime_error{"The trace's seek table does not match its frames"};
+  }
+  return frames;
+}
+
+/**
+ * Compress a trace into independently decodable frames, each of ``frame_size`` bytes except the last, and append the seek table.
+ * To allow a reader to begin at any frame, ``frame_size`` should be a multiple of the size of a trace record.
+ * The file is not complete until ``close()`` is called.
+ */
+class writer
+{
+  std::ostream& out;
+  std::size_t frame_size;
+  int compression_level;
+  std::string pending{};
+  std::vector<std::pair<uint32_t, uint32_t>> entries{};
+
+  void write_frame()
+  {
+    std::string frame(::ZSTD_compressBound(std::size(pending)), '\0');
+    auto compressed_size = ::ZSTD_compress(std::data(frame), std::size(frame), std::data(pending), std::size(pending), compression_level);
+    if (::ZSTD_isError(compressed_size)) {
+      throw std::runtime_error{std::string{"Could not compress trace: "} + ::ZSTD_getErrorName(compressed_size)};
+    }
+    out.write(std::data(frame), static_cast<std::streamsize>(compressed_size));
+    entries.emplace_back(static_cast<uint32_t>(compressed_size), static_cast<uint32_t>(std::size(pending)));
+    pending.clear();
+  }
+
+public:
+  writer(std::ostream& out_, std::size_t frame_size_, int compression_level_ = ZSTD_CLEVEL_DEFAULT)
+      : out(out_), frame_size(frame_size_), compression_level(compression_level_)
+  {
+    if (frame_size == 0 || frame_size > std::numeric_limits<uint32_t>::max()) {
+      throw std::invalid_argument{"The frame size must be positive and fit in 32 bits"};
+    }
+    pending.reserve(frame_size);
+  }
+
+  void write(const char* s, std::size_t count)
+  {
+    while (count > 0) {
+      auto to_copy = std::min(count, frame_size - std::size(pending));
+      pending.append(s, to_copy);
+      s += to_copy;
+      count -= to_copy;
+      if (std::size(pending) == frame_size) {
+        write_frame();
+      }
+    }
+  }
+
+  /**
+   * Write the last frame and the seek table.
+   */
+  void close()
+  {
+    if (!std::empty(pending)) {
+      write_frame();
+    }
+
+    auto table_content_size = std::size(entries) * entry_size + footer_size;
+    detail::write_le32(out, skippable_magic);
+    detail::write_le32(out, static_cast<uint32_t>(table_content_size));
+    for (auto [compressed_size, decompressed_size] : entries) {
+      detail::write_le32(out, compressed_size);
+      detail::write_le32(out, decompressed_size);
+    }
+    detail::write_le32(out, static_cast<uint32_t>(std::size(entries)));
+    out.put(0); // no checksums
+    detail::write_le32(out, seekable_magic);
+    out.flush();
+  }
+};
+} // namespace seekable_zstd
+} // namespace champsim
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SHARED_TRACE_H
+#define SHARED_TRACE_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <ios>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "skip_stream.h"
+
+namespace champsim
+{
+/**
+ * A trace file that is decompressed once and read by several readers, each at its own position.
+ *
+ * The decompressed bytes are held in chunks until every reader has passed them. A reader that falls more than ``max_lag`` chunks
+ * behind the one furthest ahead is detached, and continues on a decompression of its own, so that the bytes held stay bounded.
+ * The detached reader's stream skips to where the reader left off, so a file that can be read from any point, such as an
+ * uncompressed file or a Zstandard file with a seek table, is not decompressed again from its beginning.
+ * A reader can only join while the first chunk is still held.
+ */
+class shared_trace_source
+{
+public:
+  /**
+   * A run of decompressed bytes, and the position in the file of the first of them.
+   */
+  struct chunk_type {
+    uint64_t offset = 0;
+    std::vector<char> bytes{};
+  };
+
+  constexpr static std::size_t chunk_size = 1 << 20;
+  constexpr static uint64_t default_max_lag = 64;
+
+  /**
+   * The bytes of the decompressed file, in the order they are read.
+   */
+  struct stream_concept {
+    virtual ~stream_concept() = default;
+    virtual std::size_t read(char* s, std::size_t count) = 0;
+    virtual uint64_t skip(uint64_t count) = 0;
+  };
+
+  template <typename F>
+  struct stream_model final : public stream_concept {
+    F intern_;
+    explicit stream_model(F&& val) : intern_(std::move(val)) {}
+
+    std::size_t read(char* s, std::size_t count) override
+    {
+      intern_.read(s, static_cast<std::streamsize>(count));
+      return static_cast<std::size_t>(intern_.gcount());
+    }
+
+    uint64_t skip(uint64_t count) override { return skip_stream(intern_, count); }
+  };
+
+  using opener_type = std::function<std::unique_ptr<stream_concept>()>;
+
+  /**
+   * A stream over the shared bytes, which can be read by a ``bulk_tracereader``.
+   */
+  class reader
+  {
+    std::shared_ptr<shared_trace_source> source;
+    std::size_t slot;
+    uint64_t chunk_index = 0;
+    std::size_t chunk_offset = 0;
+    std::shared_ptr<const chunk_type> chunk{};
+    std::streamsize gcount_ = 0;
+    bool eof_ = false;
+
+  public:
+    reader(std::shared_ptr<shared_trace_source> source_, std::size_t slot_);
+    ~reader();
+    reader(const reader&) = delete;
+    reader& operator=(const reader&) = delete;
+    reader(reader&& other) noexcept;
+    reader& operator=(reader&& other) noexcept;
+
+    reader& read(char* s, std::streamsize count);
+    [[nodiscard]] bool eof() const { return eof_; }
+    [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+  };
+
+private:
+  std::mutex mutex{};
+  std::string name;
+  opener_type open;
+  std::unique_ptr<stream_concept> file;
+  bool repeat;
+  uint64_t max_lag;
+  bool at_end = false;
+  uint64_t file_offset = 0; // the position in the file of the next byte to be decompressed
+
+  uint64_t first_chunk = 0;
+  std::deque<std::shared_ptr<const chunk_type>> chunks{};
+  std::vector<uint64_t> reader_positions{}; // the next chunk needed by each reader
+
+  constexpr static uint64_t finished = std::numeric_limits<uint64_t>::max();
+  constexpr static uint64_t detached = finished - 1;
+
+  std::shared_ptr<const chunk_type> get(std::size_t slot, uint64_t index);
+  [[nodiscard]] bool is_detached(std::size_t slot);
+  [[nodiscard]] std::shared_ptr<shared_trace_source> detach(uint64_t offset) const;
+  void leave(std::size_t slot);
+
+public:
+  /**
+   * Share the bytes of the stream produced by ``opener``. If ``repeat_`` is set, the stream is reopened at its end, and the readers never reach the end.
+   * A reader more than ``max_lag_`` chunks behind the furthest reader is detached.
+   */
+  shared_trace_source(std::string name_, opener_type opener, bool repeat_, uint64_t max_lag_ = default_max_lag);
+
+  /**
+   * Begin reading from the start of the trace, or return ``std::nullopt`` if the start has already been released.
+   */
+  static std::optional<reader> join(const std::shared_ptr<shared_trace_source>& source);
+};
+} // namespace champsim
+
+#endif
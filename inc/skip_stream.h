@@ -0,0 +1,70 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SKIP_STREAM_H
+#define SKIP_STREAM_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <iterator>
+#include <utility>
+
+#include "util/detect.h"
+
+namespace champsim
+{
+namespace detail
+{
+template <typename U>
+using has_skip = decltype(std::declval<U&>().skip(uint64_t{}));
+
+template <typename U>
+using has_take = decltype(std::declval<U&>().take(std::size_t{}));
+} // namespace detail
+
+/**
+ * Pass over up to ``count`` bytes of a stream, stopping early at its end. A stream with a ``skip()`` member does this itself,
+ * one with ``take()`` is advanced without copying, and any other is read into a scratch buffer.
+ *
+ * \return the number of bytes skipped.
+ */
+template <typename F>
+uint64_t skip_stream(F& stream, uint64_t count)
+{
+  uint64_t skipped = 0;
+  if constexpr (champsim::is_detected_v<detail::has_skip, F>) {
+    skipped = stream.skip(count);
+  } else if constexpr (champsim::is_detected_v<detail::has_take, F>) {
+    constexpr uint64_t chunk_size = uint64_t{1} << 20;
+    while (skipped < count && !stream.eof()) {
+      auto [begin, end] = stream.take(static_cast<std::size_t>(std::min(count - skipped, chunk_size)));
+      skipped += static_cast<uint64_t>(std::distance(begin, end));
+    }
+  } else {
+    std::array<char, std::size_t{1} << 16> discard;
+    while (skipped < count && !stream.eof()) {
+      stream.read(std::data(discard), static_cast<std::streamsize>(std::min<uint64_t>(count - skipped, std::size(discard))));
+      skipped += static_cast<uint64_t>(stream.gcount());
+    }
+  }
+  return skipped;
+}
+} // namespace champsim
+
+#endif
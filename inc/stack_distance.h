@@ -0,0 +1,76 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STACK_DISTANCE_H
+#define STACK_DISTANCE_H
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * Measures the LRU stack distance of each access in a stream of blocks, in a single pass.
+ *
+ * The distance of an access is the number of distinct blocks accessed since the previous access to the same block,
+ * so the access hits in any fully-associative LRU cache with more blocks than that.
+ * Blocks are sampled by a hash of their number (as in SHARDS), and the distances among the sampled blocks are scaled
+ * by the sampling rate, which bounds the memory and time used for large footprints.
+ */
+class stack_distance_profiler
+{
+  uint64_t threshold;
+  double rate;
+
+  uint64_t next_timestamp = 0;
+  std::unordered_map<uint64_t, uint64_t> last_access{};
+
+  // A Fenwick tree over the timestamps, marking the most recent access to each sampled block
+  std::vector<long> marks{};
+
+  void mark(uint64_t timestamp, long delta);
+  [[nodiscard]] long marked_before(uint64_t timestamp) const;
+  void compact();
+
+public:
+  /**
+   * The distance reported for the first access to a block, which misses at every size.
+   */
+  constexpr static long cold = std::numeric_limits<long>::max();
+
+  /**
+   * Profile a fraction ``sample_rate`` of the blocks, which must be in (0, 1].
+   */
+  explicit stack_distance_profiler(double sample_rate);
+
+  /**
+   * Record an access to the block, and return its estimated stack distance, or ``cold`` if the block has not been accessed before.
+   * Returns ``std::nullopt`` if the block is not sampled.
+   */
+  std::optional<long> access(uint64_t block);
+
+  /**
+   * Round the stack distance up to the smallest of a series of sizes (powers of two and the halfway points between them),
+   * in blocks, at which the access would hit.
+   */
+  static long hitting_size(long distance);
+};
+} // namespace champsim
+
+#endif
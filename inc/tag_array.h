@@ -0,0 +1,89 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TAG_ARRAY_H
+#define TAG_ARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "address.h"
+#include "block.h"
+
+namespace champsim
+{
+/**
+ * The tags and state bits of a set-associative array of blocks, held apart from the blocks themselves so that a lookup
+ * touches only what it compares.
+ *
+ * The tags of each set are packed together, and are compared against a key several ways at a time where the host
+ * supports it (AVX2 or SSE4.1, detected at run time), or one at a time otherwise. The valid, dirty, and prefetch bits of each set are held as
+ * bitmasks over its ways. The array mirrors the blocks it describes, and must be updated whenever one of them changes.
+ */
+class tag_array
+{
+  static constexpr std::size_t ways_per_word = 64;
+
+  std::size_t num_way = 0;
+  std::size_t words_per_set = 0;
+  std::size_t tag_stride = 0;
+
+  std::vector<uint64_t> tags{};
+  std::vector<uint64_t> valid_bits{};
+  std::vector<uint64_t> dirty_bits{};
+  std::vector<uint64_t> prefetch_bits{};
+
+  [[nodiscard]] uint64_t match_word(long set, std::size_t word, uint64_t tag) const;
+  [[nodiscard]] bool test(const std::vector<uint64_t>& bits, long set, long way) const;
+  void assign(std::vector<uint64_t>& bits, long set, long way, bool value);
+
+public:
+  tag_array() = default;
+  tag_array(std::size_t num_set, std::size_t num_way);
+
+  /**
+   * \return the first valid way of the set that holds the given tag, or the number of ways if there is none
+   */
+  [[nodiscard]] long find(long set, uint64_t tag) const;
+
+  /**
+   * \return the first way of the set that holds the given tag, whether or not it is valid, or the number of ways if there is none
+   */
+  [[nodiscard]] long find_any(long set, uint64_t tag) const;
+
+  /**
+   * \return the first invalid way of the set, or the number of ways if there is none
+   */
+  [[nodiscard]] long find_invalid(long set) const;
+
+  [[nodiscard]] bool is_valid(long set, long way) const;
+  [[nodiscard]] bool is_dirty(long set, long way) const;
+  [[nodiscard]] bool is_prefetch(long set, long way) const;
+
+  /**
+   * \return whether the given way holds the tag and the state bits of the block
+   */
+  [[nodiscard]] bool matches(long set, long way, uint64_t tag, const cache_block& block) const;
+
+  /**
+   * Copy the tag and state bits of a block into the given way.
+   */
+  void update(long set, long way, uint64_t tag, const cache_block& block);
+};
+} // namespace champsim
+
+#endif
@@ -17,6 +17,8 @@
 #ifndef TRACEREADER_H
 #define TRACEREADER_H
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <deque>
 #include <memory>
@@ -25,16 +27,18 @@
 #include <type_traits>
 
 #include "instruction.h"
+#include "shared_trace.h"
+#include "skip_stream.h"
 #include "util/detect.h"
 
 namespace champsim
 {
 class tracereader
 {
-  static uint64_t instr_unique_id; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
   struct reader_concept {
     virtual ~reader_concept() = default;
     virtual ooo_model_instr operator()() = 0;
+    virtual uint64_t skip(uint64_t count) = 0;
     [[nodiscard]] virtual bool eof() const = 0;
   };
 
@@ -46,7 +50,23 @@ class tracereader
     template <typename U>
     using has_eof = decltype(std::declval<U>().eof());
 
+    template <typename U>
+    using has_skip = decltype(std::declval<U&>().skip(uint64_t{}));
+
     ooo_model_instr operator()() override { return intern_(); }
+    uint64_t skip(uint64_t count) override
+    {
+      uint64_t skipped = 0;
+      if constexpr (champsim::is_detected_v<has_skip, T>) {
+        skipped = intern_.skip(count);
+      } else {
+        // The instructions must be read
+        for (; skipped < count && !eof(); ++skipped) {
+          intern_();
+        }
+      }
+      return skipped;
+    }
     [[nodiscard]] bool eof() const override
     {
       if constexpr (champsim::is_detected_v<has_eof, T>) {
@@ -57,20 +77,49 @@ class tracereader
   };
 
   std::unique_ptr<reader_concept> pimpl_;
+  uint64_t next_instr_id;
+  uint64_t instr_id_stride;
 
 public:
+  /**
+   * Wrap a reader. Its instructions are numbered from ``first_instr_id`` in steps of ``instr_id_stride``,
+   * so that the readers of one simulation can be given disjoint identifiers without sharing a counter.
+   */
   template <typename T, std::enable_if_t<!std::is_same_v<tracereader, T>, bool> = true>
-  tracereader(T&& val) : pimpl_(std::make_unique<reader_model<T>>(std::forward<T>(val)))
+  tracereader(T&& val, uint64_t first_instr_id = 0, uint64_t instr_id_stride_ = 1)
+      : pimpl_(std::make_unique<reader_model<T>>(std::forward<T>(val))), next_instr_id(first_instr_id), instr_id_stride(instr_id_stride_)
   {
   }
 
   auto operator()()
   {
     auto retval = (*pimpl_)();
-    retval.instr_id = instr_unique_id++;
+    retval.instr_id = next_instr_id;
+    next_instr_id += instr_id_stride;
     return retval;
   }
 
+  /**
+   * Discard up to ``count`` instructions, stopping early if the trace ends. The instructions that follow are numbered as if
+   * the skipped instructions had never been read.
+   *
+   * \return the number of instructions skipped.
+   */
+  uint64_t skip(uint64_t count) { return pimpl_->skip(count); }
+
+  /**
+   * Discard up to ``count`` instructions, stopping early if the trace ends. Unlike skip(), the skipped instructions use up their
+   * identifiers, so the instructions that follow are numbered as if they had all been read.
+   *
+   * \return the number of instructions skipped.
+   */
+  uint64_t fast_forward(uint64_t count)
+  {
+    auto skipped = pimpl_->skip(count);
+    next_instr_id += skipped * instr_id_stride;
+    return skipped;
+  }
+
   [[nodiscard]] auto eof() const { return pimpl_->eof(); }
 };
 
@@ -88,10 +137,33 @@ class bulk_tracereader
   constexpr static std::size_t refresh_thresh = 1;
   std::deque<ooo_model_instr> instr_buffer;
 
+  template <typename U>
+  using has_take = decltype(std::declval<U&>().take(std::size_t{}));
+
+  void refill();
+
+  // Streams that cannot be decoded in parallel do not take a number of threads
+  static F open(const std::string& fname, unsigned decoder_threads)
+  {
+    if constexpr (std::is_constructible_v<F, std::string, unsigned>) {
+      return F{fname, decoder_threads};
+    } else {
+      return F{fname};
+    }
+  }
+
 public:
   ooo_model_instr operator()();
 
-  bulk_tracereader(uint8_t cpu_idx, std::string tf) : cpu(cpu_idx), trace_file(tf) {}
+  /**
+   * Discard up to ``count`` instructions, stopping early if the trace ends. The records are passed over in the underlying stream
+   * without being decoded, using the stream's own ``skip()`` if it has one.
+   *
+   * \return the number of instructions skipped.
+   */
+  uint64_t skip(uint64_t count);
+
+  bulk_tracereader(uint8_t cpu_idx, std::string tf, unsigned decoder_threads = 1) : cpu(cpu_idx), trace_file(open(tf, decoder_threads)) {}
   bulk_tracereader(uint8_t cpu_idx, F&& file) : cpu(cpu_idx), trace_file(std::move(file)) {}
 
   [[nodiscard]] bool eof() const { return trace_file.eof() && std::size(instr_buffer) <= refresh_thresh; }
@@ -108,9 +180,18 @@ void set_branch_targets(It begin, It end)
 }
 
 template <typename T, typename F>
-ooo_model_instr bulk_tracereader<T, F>::operator()()
+void bulk_tracereader<T, F>::refill()
 {
-  if (std::size(instr_buffer) <= refresh_thresh) {
+  if constexpr (champsim::is_detected_v<has_take, F>) {
+    // Decode the records where they lie, without staging them in a buffer
+    auto [begin, end] = trace_file.take((buffer_size - refresh_thresh) * sizeof(T));
+    eof_ = trace_file.eof();
+    for (auto it = begin; std::distance(it, end) >= static_cast<long>(sizeof(T)); std::advance(it, sizeof(T))) {
+      T t;
+      std::memcpy(&t, it, sizeof(T));
+      instr_buffer.emplace_back(cpu, t);
+    }
+  } else {
     std::array<T, buffer_size - refresh_thresh> trace_read_buf;
     std::array<char, std::size(trace_read_buf) * sizeof(T)> raw_buf;
     std::size_t bytes_read;
@@ -127,9 +208,17 @@ ooo_model_instr bulk_tracereader<T, F>::operator()()
     auto begin = std::begin(trace_read_buf);
     auto end = std::next(begin, bytes_read / sizeof(T));
     std::transform(begin, end, std::back_inserter(instr_buffer), [cpu = this->cpu](T t) { return ooo_model_instr{cpu, t}; });
+  }
 
-    // Set branch targets
-    set_branch_targets(std::begin(instr_buffer), std::end(instr_buffer));
+  // Set branch targets
+  set_branch_targets(std::begin(instr_buffer), std::end(instr_buffer));
+}
+
+template <typename T, typename F>
+ooo_model_instr bulk_tracereader<T, F>::operator()()
+{
+  if (std::size(instr_buffer) <= refresh_thresh) {
+    refill();
   }
 
   auto retval = instr_buffer.front();
@@ -138,9 +227,50 @@ ooo_model_instr bulk_tracereader<T, F>::operator()()
   return retval;
 }
 
+template <typename T, typename F>
+uint64_t bulk_tracereader<T, F>::skip(uint64_t count)
+{
+  // The last buffered instruction is waiting for its successor to give its branch target, so it is not taken from the buffer here
+  auto from_buffer = std::min<uint64_t>(count, std::size(instr_buffer) - std::min(std::size(instr_buffer), refresh_thresh));
+  instr_buffer.erase(std::begin(instr_buffer), std::next(std::begin(instr_buffer), static_cast<long>(from_buffer)));
+  if (from_buffer == count) {
+    return count;
+  }
+
+  auto dropped = std::min<uint64_t>(count - from_buffer, std::size(instr_buffer));
+  instr_buffer.erase(std::begin(instr_buffer), std::next(std::begin(instr_buffer), static_cast<long>(dropped)));
+  auto skipped = from_buffer + dropped;
+  if (skipped < count) {
+    auto from_file = skip_stream(trace_file, (count - skipped) * sizeof(T)) / sizeof(T);
+
+    // Read ahead, so that eof() is accurate
+    refill();
+
+    // If nothing follows, the last record skipped is the last of the trace, which is never given when reading either
+    if (std::empty(instr_buffer) && from_file > 0) {
+      --from_file;
+    }
+    skipped += from_file;
+  }
+  return skipped;
+}
+
 std::string get_fptr_cmd(std::string_view fname);
+
+/**
+ * Open a trace file to be decompressed once and shared between several readers.
+ * If its format can be decoded in parallel, up to ``decoder_threads`` threads decode it.
+ */
+std::shared_ptr<shared_trace_source> open_shared_trace(const std::string& fname, bool is_cloudsuite, bool repeat, unsigned decoder_threads = 1);
+
+/**
+ * Whether ``get_tracereader()`` reads the named file on a thread of its own. Compressed files are decompressed ahead of the simulation,
+ * but an uncompressed file is mapped and decoded in place by the simulation thread. Readers of a shared trace always have a thread of their own.
+ */
+bool reads_asynchronously(const std::string& fname);
 } // namespace champsim
 
-champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat);
+champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat, unsigned decoder_threads = 1);
+champsim::tracereader get_tracereader(champsim::shared_trace_source::reader stream, uint8_t cpu, bool is_cloudsuite);
 
 #endif
@@ -30,6 +30,7 @@
 namespace champsim
 {
 using msl::bitmask;
+using msl::countr_zero;
 using msl::ipow;
 using msl::is_power_of_2;
 using msl::lg2;
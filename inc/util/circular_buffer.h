@@ -0,0 +1,265 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_CIRCULAR_BUFFER_H
+#define UTIL_CIRCULAR_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "util/bits.h"
+
+namespace champsim
+{
+/**
+ * A double-ended sequence whose elements are held in a single ring of slots, allocated once.
+ *
+ * Elements are added at the back and are usually removed from the front, neither of which moves any other element. The ring
+ * is sized to the capacity given at construction, rounded up to a power of two, and only grows if that capacity is exceeded.
+ *
+ * Each element is given a position when it is added, which counts all of the elements ever added before it. The position of
+ * an element does not change while it is in the buffer, so it can be held in place of an iterator and looked up again in
+ * constant time. Removing or inserting elements other than at the ends renumbers the elements that follow.
+ */
+template <typename T>
+class circular_buffer
+{
+  std::vector<std::optional<T>> slots;
+  std::size_t head = 0;
+  std::size_t size_ = 0;
+  uint64_t front_position = 0;
+
+  [[nodiscard]] std::size_t slot(std::ptrdiff_t idx) const { return (head + static_cast<std::size_t>(idx)) & (std::size(slots) - 1); }
+
+  void reserve_one_more()
+  {
+    if (size_ < std::size(slots)) {
+      return;
+    }
+
+    std::vector<std::optional<T>> grown(std::max<std::size_t>(2 * std::size(slots), 1));
+    for (std::size_t i = 0; i < size_; ++i) {
+      grown[i] = std::move(slots[slot(static_cast<std::ptrdiff_t>(i))]);
+    }
+    slots = std::move(grown);
+    head = 0;
+  }
+
+  template <bool Const>
+  class basic_iterator
+  {
+    using buffer_type = std::conditional_t<Const, const circular_buffer, circular_buffer>;
+
+    buffer_type* buf = nullptr;
+    std::ptrdiff_t idx = 0;
+
+    friend class circular_buffer;
+    friend class basic_iterator<!Const>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, const T&, T&>;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+
+    basic_iterator() = default;
+    basic_iterator(buffer_type* buffer, difference_type index) : buf(buffer), idx(index) {}
+
+    template <bool C = Const, std::enable_if_t<C, bool> = true>
+    basic_iterator(const basic_iterator<false>& other) : buf(other.buf), idx(other.idx) // NOLINT(google-explicit-constructor)
+    {
+    }
+
+    reference operator*() const { return *buf->slots[buf->slot(idx)]; }
+    pointer operator->() const { return &(**this); }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    basic_iterator& operator+=(difference_type n)
+    {
+      idx += n;
+      return *this;
+    }
+    basic_iterator& operator-=(difference_type n) { return *this += (-n); }
+    basic_iterator& operator++() { return *this += 1; }
+    basic_iterator& operator--() { return *this -= 1; }
+    basic_iterator operator++(int)
+    {
+      auto retval = *this;
+      ++(*this);
+      return retval;
+    }
+    basic_iterator operator--(int)
+    {
+      auto retval = *this;
+      --(*this);
+      return retval;
+    }
+
+    friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+    friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+    friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.idx - rhs.idx; }
+
+    friend bool operator==(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.idx == rhs.idx; }
+    friend bool operator!=(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.idx != rhs.idx; }
+    friend bool operator<(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.idx < rhs.idx; }
+    friend bool operator>(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.idx > rhs.idx; }
+    friend bool operator<=(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.idx <= rhs.idx; }
+    friend bool operator>=(const basic_iterator& lhs, const basic_iterator& rhs) { return lhs.idx >= rhs.idx; }
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  circular_buffer() = default;
+  explicit circular_buffer(std::size_t capacity) : slots(champsim::next_pow2(std::max<std::size_t>(capacity, 1))) {}
+
+  [[nodiscard]] iterator begin() { return {this, 0}; }
+  [[nodiscard]] const_iterator begin() const { return {this, 0}; }
+  [[nodiscard]] const_iterator cbegin() const { return begin(); }
+  [[nodiscard]] iterator end() { return {this, static_cast<difference_type>(size_)}; }
+  [[nodiscard]] const_iterator end() const { return {this, static_cast<difference_type>(size_)}; }
+  [[nodiscard]] const_iterator cend() const { return end(); }
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] size_type size() const { return size_; }
+  [[nodiscard]] size_type capacity() const { return std::size(slots); }
+
+  [[nodiscard]] reference operator[](size_type pos) { return begin()[static_cast<difference_type>(pos)]; }
+  [[nodiscard]] const_reference operator[](size_type pos) const { return begin()[static_cast<difference_type>(pos)]; }
+  [[nodiscard]] reference at(size_type pos)
+  {
+    if (pos >= size_) {
+      throw std::out_of_range{"circular_buffer::at"};
+    }
+    return (*this)[pos];
+  }
+  [[nodiscard]] const_reference at(size_type pos) const
+  {
+    if (pos >= size_) {
+      throw std::out_of_range{"circular_buffer::at"};
+    }
+    return (*this)[pos];
+  }
+
+  [[nodiscard]] reference front() { return *begin(); }
+  [[nodiscard]] const_reference front() const { return *begin(); }
+  [[nodiscard]] reference back() { return *std::prev(end()); }
+  [[nodiscard]] const_reference back() const { return *std::prev(end()); }
+
+  /**
+   * \return the position of the element at ``pos``
+   */
+  [[nodiscard]] uint64_t position_of(const_iterator pos) const { return front_position + static_cast<uint64_t>(pos.idx); }
+
+  /**
+   * \return an iterator to the element with the given position, or ``end()`` if it is no longer in the buffer
+   */
+  [[nodiscard]] iterator find_position(uint64_t position)
+  {
+    if (position < front_position || position - front_position >= size_) {
+      return end();
+    }
+    return {this, static_cast<difference_type>(position - front_position)};
+  }
+  [[nodiscard]] const_iterator find_position(uint64_t position) const
+  {
+    if (position < front_position || position - front_position >= size_) {
+      return end();
+    }
+    return {this, static_cast<difference_type>(position - front_position)};
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    reserve_one_more();
+    auto& added = slots[slot(static_cast<difference_type>(size_))].emplace(std::forward<Args>(args)...);
+    ++size_;
+    return added;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void pop_front()
+  {
+    slots[head].reset();
+    head = slot(1);
+    --size_;
+    ++front_position;
+  }
+
+  void pop_back()
+  {
+    slots[slot(static_cast<difference_type>(size_) - 1)].reset();
+    --size_;
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    auto count = last - first;
+    if (first == cbegin()) {
+      for (difference_type i = 0; i < count; ++i) {
+        pop_front();
+      }
+      return begin();
+    }
+
+    auto dest = std::next(begin(), first.idx);
+    std::move(std::next(begin(), last.idx), end(), dest);
+    for (difference_type i = 0; i < count; ++i) {
+      pop_back();
+    }
+    return dest;
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+  template <typename It>
+  iterator insert(const_iterator pos, It first, It last)
+  {
+    auto offset = pos.idx;
+    auto old_size = static_cast<difference_type>(size_);
+    std::for_each(first, last, [this](const auto& x) { emplace_back(x); });
+    std::rotate(std::next(begin(), offset), std::next(begin(), old_size), end());
+    return std::next(begin(), offset);
+  }
+
+  void clear()
+  {
+    while (!empty()) {
+      pop_front();
+    }
+  }
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTIL_INLINE_VECTOR_H
+#define UTIL_INLINE_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace champsim
+{
+/**
+ * A sequence of at most ``N`` elements, stored within the object rather than on the heap.
+ *
+ * This has the subset of the interface of ``std::vector`` that does not change its capacity. Its elements are always constructed,
+ * so ``T`` must be default-constructible, and elements past the end keep their old values until they are overwritten.
+ * Adding an element to a full sequence throws ``std::length_error``.
+ */
+template <typename T, std::size_t N>
+class inline_vector
+{
+  static_assert(N <= std::numeric_limits<unsigned char>::max());
+
+  std::array<T, N> storage{};
+  unsigned char size_ = 0;
+
+  void check_room(std::size_t count) const
+  {
+    if (std::size(*this) + count > N) {
+      throw std::length_error{"inline_vector capacity exceeded"};
+    }
+  }
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  inline_vector() = default;
+  inline_vector(std::initializer_list<T> init) : inline_vector(std::begin(init), std::end(init)) {}
+
+  template <typename It>
+  inline_vector(It first, It last)
+  {
+    std::for_each(first, last, [this](const auto& x) { push_back(x); });
+  }
+
+  [[nodiscard]] iterator begin() { return std::data(storage); }
+  [[nodiscard]] const_iterator begin() const { return std::data(storage); }
+  [[nodiscard]] const_iterator cbegin() const { return begin(); }
+  [[nodiscard]] iterator end() { return std::next(begin(), size_); }
+  [[nodiscard]] const_iterator end() const { return std::next(begin(), size_); }
+  [[nodiscard]] const_iterator cend() const { return end(); }
+
+  [[nodiscard]] pointer data() { return std::data(storage); }
+  [[nodiscard]] const_pointer data() const { return std::data(storage); }
+  [[nodiscard]] size_type size() const { return size_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] constexpr static size_type capacity() { return N; }
+  [[nodiscard]] constexpr static size_type max_size() { return N; }
+
+  [[nodiscard]] reference operator[](size_type pos) { return storage[pos]; }
+  [[nodiscard]] const_reference operator[](size_type pos) const { return storage[pos]; }
+  [[nodiscard]] reference front() { return storage.front(); }
+  [[nodiscard]] const_reference front() const { return storage.front(); }
+  [[nodiscard]] reference back() { return storage[size_ - 1]; }
+  [[nodiscard]] const_reference back() const { return storage[size_ - 1]; }
+
+  [[nodiscard]] reference at(size_type pos)
+  {
+    if (pos >= size()) {
+      throw std::out_of_range{"inline_vector index out of range"};
+    }
+    return storage[pos];
+  }
+
+  [[nodiscard]] const_reference at(size_type pos) const
+  {
+    if (pos >= size()) {
+      throw std::out_of_range{"inline_vector index out of range"};
+    }
+    return storage[pos];
+  }
+
+  void push_back(const T& value)
+  {
+    check_room(1);
+    storage[size_++] = value;
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args)
+  {
+    check_room(1);
+    storage[size_] = T{std::forward<Args>(args)...};
+    return storage[size_++];
+  }
+
+  void pop_back() { --size_; }
+  void clear() { size_ = 0; }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    auto dest = std::next(begin(), std::distance(cbegin(), first));
+    auto new_end = std::move(std::next(begin(), std::distance(cbegin(), last)), end(), dest);
+    size_ = static_cast<unsigned char>(std::distance(begin(), new_end));
+    return dest;
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+  friend bool operator==(const inline_vector& lhs, const inline_vector& rhs) { return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs), std::end(rhs)); }
+  friend bool operator!=(const inline_vector& lhs, const inline_vector& rhs) { return !(lhs == rhs); }
+};
+} // namespace champsim
+
+#endif
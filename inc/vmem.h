@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <deque>
+#include <iosfwd>
 #include <map>
 #include <optional>
 #include <random>
@@ -46,6 +47,7 @@ public:
 
 private:
   std::deque<champsim::page_number> ppage_free_list;
+  std::size_t ppages_allocated = 0;
   champsim::page_number active_pte_page{};
   champsim::address_slice<champsim::dynamic_extent> next_pte_page;
 
@@ -118,6 +120,17 @@ public:
    * :returns: A pair of the page table page address and the latency to be applied to the operation.
    */
   std::pair<champsim::address, champsim::chrono::clock::duration> get_pte_pa(uint32_t cpu_num, champsim::page_number vaddr, std::size_t level);
+
+  /**
+   * Save the page mappings that have been created so far.
+   */
+  void checkpoint(std::ostream& stream) const;
+
+  /**
+   * Replace the page mappings with those from a checkpoint.
+   * The virtual memory must have the same configuration as the one that was saved.
+   */
+  void restore(std::istream& stream);
 };
 
 #endif
@@ -57,3 +57,15 @@ uint32_t ip_stride::prefetcher_cache_fill(champsim::address addr, long set, long
 {
   return metadata_in;
 }
+
+void ip_stride::prefetcher_checkpoint(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, table);
+  champsim::msl::checkpoint(stream, active_lookahead);
+}
+
+void ip_stride::prefetcher_restore(std::istream& stream)
+{
+  champsim::msl::restore(stream, table);
+  champsim::msl::restore(stream, active_lookahead);
+}
@@ -2,7 +2,9 @@
 #define IP_STRIDE_H
 
 #include <cstdint>
+#include <istream>
 #include <optional>
+#include <ostream>
 
 #include "address.h"
 #include "champsim.h"
@@ -48,6 +50,8 @@ public:
                                     uint32_t metadata_in);
   uint32_t prefetcher_cache_fill(champsim::address addr, long set, long way, uint8_t prefetch, champsim::address evicted_addr, uint32_t metadata_in);
   void prefetcher_cycle_operate();
+  void prefetcher_checkpoint(std::ostream& stream) const;
+  void prefetcher_restore(std::istream& stream);
 };
 
 #endif
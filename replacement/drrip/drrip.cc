@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "champsim.h"
+#include "msl/checkpoint.h"
 
 drrip::drrip(CACHE* cache) : replacement(cache), NUM_SET(cache->NUM_SET), NUM_WAY(cache->NUM_WAY), rrpv(static_cast<std::size_t>(NUM_SET * NUM_WAY))
 {
@@ -85,3 +86,19 @@ long drrip::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, co
   assert(victim < end);
   return std::distance(begin, victim); // cast protected by assertions
 }
+
+void drrip::replacement_checkpoint(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, bip_counter);
+  champsim::msl::checkpoint(stream, rand_sets);
+  champsim::msl::checkpoint(stream, PSEL);
+  champsim::msl::checkpoint(stream, rrpv);
+}
+
+void drrip::replacement_restore(std::istream& stream)
+{
+  champsim::msl::restore(stream, bip_counter);
+  champsim::msl::restore(stream, rand_sets);
+  champsim::msl::restore(stream, PSEL);
+  champsim::msl::restore(stream, rrpv);
+}
@@ -2,6 +2,8 @@
 #define REPLACEMENT_DRRIP_H
 
 #include <array>
+#include <istream>
+#include <ostream>
 #include <vector>
 
 #include "cache.h"
@@ -33,6 +35,8 @@ public:
                    champsim::address full_addr, access_type type);
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
                                 access_type type, uint8_t hit);
+  void replacement_checkpoint(std::ostream& stream) const;
+  void replacement_restore(std::istream& stream);
 
   // use this function to print out your own stats at the end of simulation
   // void replacement_final_stats() {}
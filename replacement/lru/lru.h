@@ -1,6 +1,8 @@
 #ifndef REPLACEMENT_LRU_H
 #define REPLACEMENT_LRU_H
 
+#include <istream>
+#include <ostream>
 #include <vector>
 
 #include "cache.h"
@@ -23,6 +25,8 @@ public:
                               access_type type);
   void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
                                 access_type type, uint8_t hit);
+  void replacement_checkpoint(std::ostream& stream) const;
+  void replacement_restore(std::istream& stream);
   // void replacement_final_stats()
 };
 
@@ -9,3 +9,7 @@ long random::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, c
 {
   return dist(rng);
 }
+
+void random::replacement_checkpoint(std::ostream& stream) const { stream << rng << ' '; }
+
+void random::replacement_restore(std::istream& stream) { stream >> rng; }
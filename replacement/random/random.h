@@ -1,6 +1,8 @@
 #ifndef REPLACEMENT_RANDOM_H
 #define REPLACEMENT_RANDOM_H
 
+#include <istream>
+#include <ostream>
 #include <random>
 
 #include "cache.h"
@@ -15,6 +17,8 @@ struct random : public champsim::modules::replacement {
 
   // void initialize_replacement();
   long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const CACHE::BLOCK* current_set, uint64_t ip, uint64_t full_addr, access_type type);
+  void replacement_checkpoint(std::ostream& stream) const;
+  void replacement_restore(std::istream& stream);
   // void update_replacement_state(uint32_t triggering_cpu, long set, long way, uint64_t full_addr, uint64_t ip, uint64_t victim_addr, access_type type, uint8_t
   // hit);
   //  void replacement_final_stats()
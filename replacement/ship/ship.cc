@@ -5,6 +5,7 @@
 #include <random>
 
 #include "champsim.h"
+#include "msl/checkpoint.h"
 
 // initialize replacement state
 ship::ship(CACHE* cache)
@@ -95,3 +96,21 @@ void ship::update_replacement_state(uint32_t triggering_cpu, long set, long way,
       get_rrpv(set, way) = maxRRPV;
   }
 }
+
+void ship::replacement_checkpoint(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, access_count);
+  champsim::msl::checkpoint(stream, rand_sets);
+  champsim::msl::checkpoint(stream, sampler);
+  champsim::msl::checkpoint(stream, rrpv_values);
+  champsim::msl::checkpoint(stream, SHCT);
+}
+
+void ship::replacement_restore(std::istream& stream)
+{
+  champsim::msl::restore(stream, access_count);
+  champsim::msl::restore(stream, rand_sets);
+  champsim::msl::restore(stream, sampler);
+  champsim::msl::restore(stream, rrpv_values);
+  champsim::msl::restore(stream, SHCT);
+}
@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "cache.h"
+#include "msl/checkpoint.h"
 
 srrip::srrip(CACHE* cache) : srrip(cache, cache->NUM_SET, cache->NUM_WAY) {}
 
@@ -27,6 +28,20 @@ void srrip::update_replacement_state(uint32_t triggering_cpu, long set, long way
   sets.at(static_cast<std::size_t>(set)).update(way, hit);
 }
 
+void srrip::replacement_checkpoint(std::ostream& stream) const
+{
+  for (const auto& set : sets) {
+    champsim::msl::checkpoint(stream, set.rrpv_values);
+  }
+}
+
+void srrip::replacement_restore(std::istream& stream)
+{
+  for (auto& set : sets) {
+    champsim::msl::restore(stream, set.rrpv_values);
+  }
+}
+
 srrip_set_helper::srrip_set_helper(long ways) : rrpv_values(static_cast<std::size_t>(ways), maxRRPV) {}
 
 auto srrip_set_helper::get_rrpv(long way) -> rrpv_type& { return rrpv_values.at(static_cast<std::size_t>(way)); }
@@ -0,0 +1,177 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "batch.h"
+
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+#include "champsim.h"
+#include "checkpoint.h"
+#include "parallel.h"
+#include "phase_info.h"
+#include "stats_printer.h"
+#include "tracereader.h"
+
+namespace champsim
+{
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const parallel_options& options,
+                              const checkpoint_options& checkpoints);
+}
+
+std::vector<champsim::batch_job> champsim::read_batch_jobs(std::istream& stream)
+{
+  nlohmann::json job_list;
+  try {
+    stream >> job_list;
+  } catch (const nlohmann::json::exception& err) {
+    throw std::invalid_argument{fmt::format("The job list is not valid JSON: {}", err.what())};
+  }
+
+  if (!job_list.is_array()) {
+    throw std::invalid_argument{"The job list must be a JSON array"};
+  }
+
+  std::vector<batch_job> jobs;
+  for (std::size_t i = 0; i < std::size(job_list); ++i) {
+    const auto& entry = job_list.at(i);
+    batch_job job;
+    try {
+      job.name = entry.value("name", fmt::format("job{}", i));
+      job.trace_names = entry.at("traces").get<std::vector<std::string>>();
+      job.cloudsuite = entry.value("cloudsuite", false);
+      job.functional_warmup = entry.value("functional_warmup", false);
+      job.skip_instructions = entry.value("skip_instructions", 0LL);
+      job.output_file = entry.value("output", std::string{});
+      job.json_file = entry.value("json", std::string{});
+
+      // As on the command line, the traces repeat if the length is given, and the warmup is 20% of it by default
+      job.repeat = entry.contains("simulation_instructions");
+      job.simulation_instructions = entry.value("simulation_instructions", job.simulation_instructions);
+      // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+      job.warmup_instructions = entry.value("warmup_instructions", job.repeat ? job.simulation_instructions / 5 : 0LL);
+    } catch (const nlohmann::json::exception& err) {
+      throw std::invalid_argument{fmt::format("Job {} is malformed: {}", i, err.what())};
+    }
+
+    // The configuration is compiled into the binary, so a job that asks for another one would silently simulate the wrong system
+    if (entry.contains("config")) {
+      throw std::invalid_argument{fmt::format("Job {} names a configuration, but every job runs the configuration this binary was built with", job.name)};
+    }
+
+    if (job.skip_instructions < 0) {
+      throw std::invalid_argument{fmt::format("Job {} skips a negative number of instructions", job.name)};
+    }
+
+    if (std::size(job.trace_names) != NUM_CPUS) {
+      throw std::invalid_argument{fmt::format("Job {} has {} traces, but the simulator has {} CPUs", job.name, std::size(job.trace_names), NUM_CPUS)};
+    }
+
+    for (const auto& trace_name : job.trace_names) {
+      if (!std::ifstream{trace_name}) {
+        throw std::invalid_argument{fmt::format("Job {} cannot open trace {}", job.name, trace_name)};
+      }
+    }
+
+    jobs.push_back(job);
+  }
+
+  return jobs;
+}
+
+auto champsim::shared_trace_registry::join(const std::string& fname, bool is_cloudsuite, bool repeat) -> shared_trace_source::reader
+{
+  std::lock_guard lock{mutex};
+  auto& source = sources[std::tuple{fname, is_cloudsuite, repeat}];
+  if (auto existing = source.lock(); existing != nullptr) {
+    if (auto joined = shared_trace_source::join(existing); joined.has_value()) {
+      return std::move(joined.value());
+    }
+  }
+
+  // The file is not being read, or its beginning has already been released
+  auto opened = open_shared_trace(fname, is_cloudsuite, repeat, decoder_threads);
+  source = opened;
+  return std::move(shared_trace_source::join(opened).value());
+}
+
+std::size_t champsim::run_batch(const std::vector<batch_job>& jobs, std::size_t threads, unsigned decoder_threads,
+                                const std::function<std::unique_ptr<environment>()>& make_environment)
+{
+  shared_trace_registry registry{decoder_threads};
+  std::mutex output_mutex;
+  std::atomic<std::size_t> failures{0};
+
+  worker_pool pool{std::min(threads, std::size(jobs))};
+  pool.run(std::size(jobs), [&](std::size_t i) {
+    const auto& job = jobs.at(i);
+    try {
+      auto env = make_environment();
+      for (O3_CPU& cpu : env->cpu_view()) {
+        cpu.show_heartbeat = false;
+      }
+
+      std::vector<tracereader> traces;
+      for (std::size_t cpu = 0; cpu < std::size(job.trace_names); ++cpu) {
+        traces.push_back(get_tracereader(registry.join(job.trace_names.at(cpu), job.cloudsuite, job.repeat), static_cast<uint8_t>(cpu), job.cloudsuite));
+        traces.back().skip(static_cast<uint64_t>(job.skip_instructions));
+      }
+
+      auto phases = default_phases(job.warmup_instructions, job.simulation_instructions, job.trace_names);
+      for (auto& p : phases) {
+        p.name = fmt::format("{} {}", job.name, p.name);
+        p.functional = job.functional_warmup && p.is_warmup;
+      }
+
+      auto stats = champsim::main(*env, phases, traces, parallel_options{}, checkpoint_options{});
+
+      if (!job.output_file.empty()) {
+        std::ofstream output_file{job.output_file};
+        plain_printer{output_file}.print(stats);
+      }
+
+      if (!job.json_file.empty()) {
+        std::ofstream json_file{job.json_file};
+        json_printer{json_file}.print(stats);
+      }
+
+      // Modules print their final statistics to the standard output
+      std::lock_guard lock{output_mutex};
+      fmt::print("\n=== {} completed ===\n", job.name);
+      if (job.output_file.empty()) {
+        plain_printer{std::cout}.print(stats);
+      }
+      for (CACHE& cache : env->cache_view()) {
+        cache.impl_prefetcher_final_stats();
+      }
+      for (CACHE& cache : env->cache_view()) {
+        cache.impl_replacement_final_stats();
+      }
+      std::cout.flush();
+    } catch (const std::exception& err) {
+      std::lock_guard lock{output_mutex};
+      fmt::print("\n=== {} failed: {} ===\n", job.name, err.what());
+      ++failures;
+    }
+  });
+
+  return failures;
+}
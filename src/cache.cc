@@ -21,6 +21,7 @@
 #include <cmath>
 #include <iomanip>
 #include <numeric>
+#include <sstream>
 #include <fmt/core.h>
 
 #include "bandwidth.h"
@@ -35,14 +36,16 @@
 CACHE::CACHE(CACHE&& other)
     : operable(other),
 
+      shadows(std::move(other.shadows)), stack_distance_profilers(std::move(other.stack_distance_profilers)),
+
       upper_levels(std::move(other.upper_levels)), lower_level(std::move(other.lower_level)), lower_translate(std::move(other.lower_translate)),
 
       cpu(other.cpu), NAME(std::move(other.NAME)), NUM_SET(other.NUM_SET), NUM_WAY(other.NUM_WAY), MSHR_SIZE(other.MSHR_SIZE), PQ_SIZE(other.PQ_SIZE),
-      HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)), MAX_TAG(other.MAX_TAG),
-      MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
-      pref_activate_mask(std::move(other.pref_activate_mask)),
+      HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), MAX_TAG(other.MAX_TAG), MAX_FILL(other.MAX_FILL),
+      prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
+      pref_activate_mask(std::move(other.pref_activate_mask)), stack_distance_sample_rate(other.stack_distance_sample_rate),
 
-      sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)),
+      sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)), block(std::move(other.block)), tags(std::move(other.tags)),
 
       pref_module_pimpl(std::move(other.pref_module_pimpl)), repl_module_pimpl(std::move(other.repl_module_pimpl))
 {
@@ -73,18 +76,22 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
   this->OFFSET_BITS = other.OFFSET_BITS;
   ;
   this->block = std::move(other.block);
+  this->tags = std::move(other.tags);
   this->MAX_TAG = other.MAX_TAG;
   this->MAX_FILL = other.MAX_FILL;
   this->prefetch_as_load = other.prefetch_as_load;
   this->match_offset_bits = other.match_offset_bits;
   this->virtual_prefetch = other.virtual_prefetch;
   this->pref_activate_mask = std::move(other.pref_activate_mask);
+  this->stack_distance_sample_rate = other.stack_distance_sample_rate;
 
   this->sim_stats = std::move(other.sim_stats);
   this->roi_stats = std::move(other.roi_stats);
 
   this->pref_module_pimpl = std::move(other.pref_module_pimpl);
   this->repl_module_pimpl = std::move(other.repl_module_pimpl);
+  this->shadows = std::move(other.shadows);
+  this->stack_distance_profilers = std::move(other.stack_distance_profilers);
 
   pref_module_pimpl->bind(this);
   repl_module_pimpl->bind(this);
@@ -152,11 +159,38 @@ auto CACHE::fill_block(mshr_type mshr, uint32_t metadata) -> BLOCK
   return to_fill;
 }
 
-auto CACHE::matches_address(champsim::address addr) const
+uint64_t CACHE::block_key(champsim::address address) const { return address.slice_upper(OFFSET_BITS).to<uint64_t>(); }
+
+void CACHE::update_tags(long set, long way)
 {
-  return [match = addr.slice_upper(OFFSET_BITS), shamt = OFFSET_BITS](const auto& entry) {
-    return entry.address.slice_upper(shamt) == match;
-  };
+  const auto& updated = block.at(static_cast<std::size_t>(set * NUM_WAY + way));
+  tags.update(set, way, block_key(updated.address), updated);
+}
+
+bool CACHE::tags_match_blocks() const
+{
+  for (long set = 0; set < NUM_SET; ++set) {
+    for (long way = 0; way < NUM_WAY; ++way) {
+      const auto& checked = block.at(static_cast<std::size_t>(set * NUM_WAY + way));
+      if (!tags.matches(set, way, block_key(checked.address), checked)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CACHE::mshr_index_matches_mshr() const
+{
+  if (std::size(mshr_index) != std::size(MSHR)) {
+    return false;
+  }
+  for (auto it = std::cbegin(MSHR); it != std::cend(MSHR); ++it) {
+    if (auto found = mshr_index.find(block_key(it->address)); found == std::end(mshr_index) || found->second != MSHR.position_of(it)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 template <typename T>
@@ -167,15 +201,21 @@ champsim::address CACHE::module_address(const T& element) const
 }
 
 bool CACHE::handle_fill(const mshr_type& fill_mshr)
+{
+  return do_fill(fill_mshr, [this](const request_type& writeback_packet) { return lower_level->add_wq(writeback_packet); });
+}
+
+template <typename F>
+bool CACHE::do_fill(const mshr_type& fill_mshr, F&& issue_writeback)
 {
   cpu = fill_mshr.cpu;
 
   // find victim
+  const auto set_idx = get_set_index(fill_mshr.address);
   auto [set_begin, set_end] = get_set_span(fill_mshr.address);
-  auto way = std::find_if_not(set_begin, set_end, [](auto x) { return x.valid; });
+  auto way = std::next(set_begin, tags.find_invalid(set_idx));
   if (way == set_end) {
-    way = std::next(set_begin, impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, get_set_index(fill_mshr.address), &*set_begin, fill_mshr.ip,
-                                                fill_mshr.address, fill_mshr.type));
+    way = std::next(set_begin, impl_find_victim(fill_mshr.cpu, fill_mshr.instr_id, set_idx, &*set_begin, fill_mshr.ip, fill_mshr.address, fill_mshr.type));
   }
   assert(set_begin <= way);
   assert(way <= set_end);
@@ -189,7 +229,7 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
                (fill_mshr.time_enqueued.time_since_epoch()) / clock_period, (current_time.time_since_epoch()) / clock_period);
   }
 
-  if (way != set_end && way->valid && way->dirty) {
+  if (way != set_end && tags.is_valid(set_idx, way_idx) && tags.is_dirty(set_idx, way_idx)) {
     request_type writeback_packet;
 
     writeback_packet.cpu = fill_mshr.cpu;
@@ -206,14 +246,14 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
                  fill_mshr.data_promise->pf_metadata);
     }
 
-    auto success = lower_level->add_wq(writeback_packet);
+    auto success = issue_writeback(writeback_packet);
     if (!success) {
       return false;
     }
   }
 
   champsim::address evicting_address{};
-  if (way != set_end && way->valid) {
+  if (way != set_end && tags.is_valid(set_idx, way_idx)) {
     evicting_address = module_address(*way);
   }
 
@@ -223,7 +263,7 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
                               fill_mshr.type);
 
   if (way != set_end) {
-    if (way->valid && way->prefetch) {
+    if (tags.is_valid(set_idx, way_idx) && tags.is_prefetch(set_idx, way_idx)) {
       ++sim_stats.pf_useless;
     }
 
@@ -232,6 +272,7 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
     }
 
     *way = fill_block(fill_mshr, metadata_thru);
+    update_tags(set_idx, way_idx);
   }
 
   // COLLECT STATS
@@ -252,15 +293,17 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
   cpu = handle_pkt.cpu;
 
   // access cache
+  const auto set_idx = get_set_index(handle_pkt.address);
   auto [set_begin, set_end] = get_set_span(handle_pkt.address);
-  auto way = std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x) { return x.valid && matcher(x); });
+  const auto way_idx = tags.find(set_idx, block_key(handle_pkt.address));
+  auto way = std::next(set_begin, way_idx);
   const auto hit = (way != set_end);
-  const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this);
+  const auto useful_prefetch = (hit && tags.is_prefetch(set_idx, way_idx) && !handle_pkt.prefetch_from_this);
 
   if constexpr (champsim::debug_print) {
     fmt::print("[{}] {} instr_id: {} address: {} v_address: {} data: {} set: {} way: {} ({}) type: {} cycle: {}\n", NAME, __func__, handle_pkt.instr_id,
-               handle_pkt.address, handle_pkt.v_address, handle_pkt.data, get_set_index(handle_pkt.address), std::distance(set_begin, way),
-               hit ? "HIT" : "MISS", access_type_names.at(champsim::to_underlying(handle_pkt.type)), current_time.time_since_epoch() / clock_period);
+               handle_pkt.address, handle_pkt.v_address, handle_pkt.data, set_idx, way_idx, hit ? "HIT" : "MISS",
+               access_type_names.at(champsim::to_underlying(handle_pkt.type)), current_time.time_since_epoch() / clock_period);
   }
 
   auto metadata_thru = handle_pkt.pf_metadata;
@@ -269,9 +312,7 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
   }
 
   // update replacement policy
-  const auto way_idx = std::distance(set_begin, way);
-  impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), way_idx, module_address(handle_pkt), handle_pkt.ip, {}, handle_pkt.type,
-                                hit);
+  impl_update_replacement_state(handle_pkt.cpu, set_idx, way_idx, module_address(handle_pkt), handle_pkt.ip, {}, handle_pkt.type, hit);
 
   if (hit) {
     sim_stats.hits.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
@@ -288,6 +329,8 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
       ++sim_stats.pf_useful;
       way->prefetch = false;
     }
+
+    update_tags(set_idx, way_idx);
   }
 
   return hit;
@@ -332,7 +375,10 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
   auto mshr_pkt = mshr_and_forward_packet(handle_pkt);
 
   // check mshr
-  auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(handle_pkt.address));
+  auto mshr_entry = std::end(MSHR);
+  if (auto found = mshr_index.find(block_key(handle_pkt.address)); found != std::end(mshr_index)) {
+    mshr_entry = MSHR.find_position(found->second);
+  }
   bool mshr_full = (MSHR.size() == MSHR_SIZE);
 
   if (mshr_entry != MSHR.end()) // miss already inflight
@@ -362,6 +408,7 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
 
     // Allocate an MSHR
     if (mshr_pkt.second.response_requested) {
+      mshr_index.insert_or_assign(block_key(handle_pkt.address), MSHR.position_of(std::cend(MSHR)));
       MSHR.emplace_back(std::move(mshr_pkt.first));
     }
   }
@@ -441,13 +488,21 @@ long CACHE::operate()
 
   // Perform fills
   champsim::bandwidth fill_bw{MAX_FILL};
-  for (auto q : {std::ref(MSHR), std::ref(inflight_writes)}) {
-    auto [fill_begin, fill_end] = champsim::get_span_p(std::cbegin(q.get()), std::cend(q.get()), fill_bw,
+  auto do_fills = [this, &fill_bw](const auto& q) {
+    auto [fill_begin, fill_end] = champsim::get_span_p(std::cbegin(q), std::cend(q), fill_bw,
                                                        [time = current_time](const auto& x) { return x.data_promise.is_ready_at(time); });
     auto complete_end = std::find_if_not(fill_begin, fill_end, [this](const auto& x) { return this->handle_fill(x); });
     fill_bw.consume(std::distance(fill_begin, complete_end));
-    q.get().erase(fill_begin, complete_end);
-  }
+    return std::pair{fill_begin, complete_end};
+  };
+
+  auto [mshr_fill_begin, mshr_fill_end] = do_fills(MSHR);
+  std::for_each(mshr_fill_begin, mshr_fill_end, [this](const auto& x) { this->mshr_index.erase(this->block_key(x.address)); });
+  mshr_returned -= static_cast<std::size_t>(std::distance(mshr_fill_begin, mshr_fill_end));
+  MSHR.erase(mshr_fill_begin, mshr_fill_end);
+
+  auto [write_fill_begin, write_fill_end] = do_fills(inflight_writes);
+  inflight_writes.erase(write_fill_begin, write_fill_end);
 
   // Initiate tag checks
   const champsim::bandwidth::maximum_type bandwidth_from_tag_checks{champsim::to_underlying(MAX_TAG) * (long)(HIT_LATENCY / clock_period)
@@ -510,6 +565,10 @@ long CACHE::operate()
                            [is_ready, is_translated](const auto& pkt) { return is_ready(pkt) && is_translated(pkt); });
   auto hits_end = std::stable_partition(tag_check_ready_begin, tag_check_ready_end, [this](const auto& pkt) { return this->try_hit(pkt); });
   auto finish_tag_check_end = std::stable_partition(hits_end, tag_check_ready_end, do_handle_miss);
+  std::for_each(tag_check_ready_begin, finish_tag_check_end, [this](const auto& pkt) {
+    this->record_stack_distance(pkt);
+    this->replay_to_shadows(pkt);
+  });
   tag_check_bw.consume(std::distance(tag_check_ready_begin, finish_tag_check_end));
   inflight_tag_check.erase(tag_check_ready_begin, finish_tag_check_end);
 
@@ -525,6 +584,52 @@ long CACHE::operate()
   return progress + fill_bw.amount_consumed() + initiate_tag_bw.amount_consumed() + tag_check_bw.amount_consumed();
 }
 
+champsim::chrono::clock::time_point CACHE::next_event_time() const
+{
+  const auto next_cycle = current_time + clock_period;
+
+  auto queue_occupied = [](const auto* ul) {
+    return !std::empty(ul->RQ) || !std::empty(ul->WQ) || !std::empty(ul->PQ);
+  };
+  auto needs_translation = [](const auto& entry) {
+    return !entry.translate_issued && !entry.is_translated;
+  };
+  auto stash_ready = [needs_translation](const auto& entry) {
+    return entry.is_translated || needs_translation(entry);
+  };
+
+  // Incoming requests and returns are handled in the next cycle, as are translations waiting to be issued
+  if (std::any_of(std::begin(upper_levels), std::end(upper_levels), queue_occupied) || !std::empty(internal_PQ) || !std::empty(lower_level->returned)
+      || (lower_translate != nullptr && !std::empty(lower_translate->returned))
+      || std::any_of(std::begin(translation_stash), std::end(translation_stash), stash_ready)
+      || std::any_of(std::begin(inflight_tag_check), std::end(inflight_tag_check), needs_translation) || impl_prefetcher_has_cycle_operate()) {
+    return next_cycle;
+  }
+
+  // A tag check that is blocked on a full MSHR has passed its event cycle, so it is retried in the next cycle
+  auto next_event = champsim::chrono::clock::time_point::max();
+  for (const auto& entry : inflight_tag_check) {
+    next_event = std::min(next_event, entry.event_cycle);
+  }
+  // Only the entries whose data has returned can become ready
+  std::for_each(std::cbegin(MSHR), std::next(std::cbegin(MSHR), static_cast<long>(mshr_returned)),
+                [&next_event](const auto& entry) { next_event = std::min(next_event, entry.data_promise.ready_time()); });
+  for (const auto& entry : inflight_writes) {
+    next_event = std::min(next_event, entry.data_promise.ready_time());
+  }
+
+  return std::max(next_event, next_cycle);
+}
+
+void CACHE::skip_cycles(long cycles)
+{
+  // operate() rotates the upper levels once per cycle
+  if (std::size(upper_levels) > 1) {
+    auto rotation = static_cast<std::ptrdiff_t>(cycles % static_cast<long>(std::size(upper_levels)));
+    std::rotate(std::begin(upper_levels), std::next(std::begin(upper_levels), rotation), std::end(upper_levels));
+  }
+}
+
 // LCOV_EXCL_START exclude deprecated function
 uint64_t CACHE::get_set(uint64_t address) const { return static_cast<uint64_t>(get_set_index(champsim::address{address})); }
 // LCOV_EXCL_STOP
@@ -556,21 +661,23 @@ auto CACHE::get_set_span(champsim::address address) const -> std::pair<set_type:
 uint64_t CACHE::get_way(uint64_t address, uint64_t /*unused set index*/) const
 {
   champsim::address intern_addr{address};
-  auto [begin, end] = get_set_span(intern_addr);
-  return static_cast<uint64_t>(std::distance(begin, std::find_if(begin, end, matches_address(champsim::address{address}))));
+  return static_cast<uint64_t>(tags.find_any(get_set_index(intern_addr), block_key(intern_addr)));
 }
 // LCOV_EXCL_STOP
 
 long CACHE::invalidate_entry(champsim::address inval_addr)
 {
+  const auto set_idx = get_set_index(inval_addr);
   auto [begin, end] = get_set_span(inval_addr);
-  auto inv_way = std::find_if(begin, end, matches_address(inval_addr));
+  const auto way_idx = tags.find_any(set_idx, block_key(inval_addr));
+  auto inv_way = std::next(begin, way_idx);
 
   if (inv_way != end) {
     inv_way->valid = false;
+    update_tags(set_idx, way_idx);
   }
 
-  return std::distance(begin, inv_way);
+  return way_idx;
 }
 
 bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint32_t prefetch_metadata)
@@ -595,6 +702,132 @@ bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint3
   return true;
 }
 
+champsim::address CACHE::functional_access(request_type pkt, const champsim::functional_forward_type& forward)
+{
+  return functional_operate(tag_lookup_type{pkt}, forward);
+}
+
+champsim::address CACHE::functional_operate(tag_lookup_type handle_pkt, const champsim::functional_forward_type& forward)
+{
+  // The translation is requested as in issue_translation(), and applied as in finish_translation()
+  auto translate = [this, &forward](tag_lookup_type& entry) {
+    if (!entry.is_translated) {
+      request_type translation_pkt;
+      translation_pkt.asid[0] = entry.asid[0];
+      translation_pkt.asid[1] = entry.asid[1];
+      translation_pkt.type = access_type::LOAD;
+      translation_pkt.cpu = entry.cpu;
+      translation_pkt.address = entry.address;
+      translation_pkt.v_address = entry.v_address;
+      translation_pkt.instr_id = entry.instr_id;
+      translation_pkt.ip = entry.ip;
+      translation_pkt.is_translated = true;
+
+      auto p_page = champsim::page_number{forward(lower_translate, translation_pkt)};
+      entry.address = champsim::address{champsim::splice(p_page, champsim::page_offset{entry.v_address})};
+      entry.is_translated = true;
+    }
+  };
+
+  translate(handle_pkt);
+  auto data = functional_lookup(handle_pkt, forward);
+
+  // Perform the prefetches that have been issued so far. Any that they issue in turn wait for the next access.
+  impl_prefetcher_cycle_operate();
+  for (auto num_prefetches = std::size(internal_PQ); num_prefetches > 0 && !std::empty(internal_PQ); --num_prefetches) {
+    auto pf_pkt = internal_PQ.front();
+    internal_PQ.pop_front();
+    translate(pf_pkt);
+    functional_lookup(pf_pkt, forward);
+  }
+
+  return data;
+}
+
+void CACHE::add_shadow(CACHE& shadow)
+{
+  // The shadow was built with this cache's upper levels only so that it is sized alike
+  shadow.upper_levels.clear();
+  shadow.lower_level = nullptr;
+  shadow.lower_translate = nullptr;
+  shadows.push_back(&shadow);
+}
+
+void CACHE::replay_to_shadows(const tag_lookup_type& handle_pkt)
+{
+  // Each shadow runs its own prefetcher, so this cache's prefetches are not replayed
+  if (std::empty(shadows) || handle_pkt.prefetch_from_this) {
+    return;
+  }
+
+  // The shadows have no lower level, so their misses and translations are satisfied at once
+  static const champsim::functional_forward_type no_lower_level = [](champsim::channel*, const request_type& pkt) {
+    return pkt.address;
+  };
+
+  auto replayed = handle_pkt;
+  replayed.to_return.clear();
+  replayed.instr_depend_on_me.clear();
+  for (auto* shadow : shadows) {
+    shadow->functional_operate(replayed, no_lower_level);
+  }
+}
+
+void CACHE::record_stack_distance(const tag_lookup_type& handle_pkt)
+{
+  // Like the shadows, the profile models a cache without this cache's prefetcher
+  if (stack_distance_sample_rate <= 0 || handle_pkt.prefetch_from_this) {
+    return;
+  }
+
+  while (std::size(stack_distance_profilers) <= handle_pkt.cpu) {
+    stack_distance_profilers.emplace_back(stack_distance_sample_rate);
+  }
+
+  auto block_number = handle_pkt.address.slice_upper(OFFSET_BITS).to<uint64_t>();
+  if (auto distance = stack_distance_profilers.at(handle_pkt.cpu).access(block_number); distance.has_value()) {
+    auto size = champsim::stack_distance_profiler::hitting_size(distance.value());
+    if (size != champsim::stack_distance_profiler::cold) {
+      size <<= champsim::to_underlying(OFFSET_BITS);
+    }
+    sim_stats.stack_distances.increment(std::pair{size, handle_pkt.cpu});
+  }
+}
+
+champsim::address CACHE::functional_lookup(const tag_lookup_type& handle_pkt, const champsim::functional_forward_type& forward)
+{
+  record_stack_distance(handle_pkt);
+  replay_to_shadows(handle_pkt);
+
+  if (try_hit(handle_pkt)) {
+    auto [set_begin, set_end] = get_set_span(handle_pkt.address);
+    return std::next(set_begin, tags.find(get_set_index(handle_pkt.address), block_key(handle_pkt.address)))->data;
+  }
+
+  sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
+
+  // The fill happens immediately, so it is recorded as having no latency
+  mshr_type fill_mshr{handle_pkt, current_time - clock_period};
+  if (handle_pkt.type == access_type::WRITE && !match_offset_bits) {
+    // Writebacks are filled without reading from the lower level, as in handle_write()
+    fill_mshr.data_promise = champsim::waitable{mshr_type::returned_value{}, current_time};
+  } else {
+    auto fwd_pkt = mshr_and_forward_packet(handle_pkt).second;
+    auto data = forward(lower_level, fwd_pkt);
+    if (!fwd_pkt.response_requested) {
+      return data;
+    }
+    fill_mshr.data_promise = champsim::waitable{mshr_type::returned_value{data, handle_pkt.pf_metadata}, current_time};
+  }
+
+  do_fill(fill_mshr, [this, &forward](const request_type& writeback_packet) {
+    forward(lower_level, writeback_packet);
+    return true;
+  });
+
+  return fill_mshr.data_promise->data;
+}
+
 // LCOV_EXCL_START exclude deprecated function
 bool CACHE::prefetch_line(uint64_t pf_addr, bool fill_this_level, uint32_t prefetch_metadata)
 {
@@ -610,8 +843,11 @@ bool CACHE::prefetch_line(uint64_t /*deprecated*/, uint64_t /*deprecated*/, uint
 void CACHE::finish_packet(const response_type& packet)
 {
   // check MSHR information
-  auto mshr_entry = std::find_if(std::begin(MSHR), std::end(MSHR), matches_address(packet.address));
-  auto first_unreturned = std::find_if(MSHR.begin(), MSHR.end(), [](auto x) { return x.data_promise.has_unknown_readiness(); });
+  auto mshr_entry = std::end(MSHR);
+  if (auto found = mshr_index.find(block_key(packet.address)); found != std::end(mshr_index)) {
+    mshr_entry = MSHR.find_position(found->second);
+  }
+  auto first_unreturned = std::next(std::begin(MSHR), static_cast<long>(mshr_returned));
 
   // sanity check
   if (mshr_entry == MSHR.end()) {
@@ -629,7 +865,12 @@ void CACHE::finish_packet(const response_type& packet)
 
   // Order this entry after previously-returned entries, but before non-returned
   // entries
-  std::iter_swap(mshr_entry, first_unreturned);
+  if (mshr_entry >= first_unreturned) {
+    std::iter_swap(mshr_entry, first_unreturned);
+    mshr_index.insert_or_assign(block_key(mshr_entry->address), MSHR.position_of(mshr_entry));
+    mshr_index.insert_or_assign(block_key(first_unreturned->address), MSHR.position_of(first_unreturned));
+    ++mshr_returned;
+  }
 }
 
 void CACHE::finish_translation(const response_type& packet)
@@ -808,6 +1049,8 @@ uint32_t CACHE::impl_prefetcher_cache_fill(champsim::address addr, long set, lon
 
 void CACHE::impl_prefetcher_cycle_operate() const { pref_module_pimpl->impl_prefetcher_cycle_operate(); }
 
+bool CACHE::impl_prefetcher_has_cycle_operate() const { return pref_module_pimpl->impl_prefetcher_has_cycle_operate(); }
+
 void CACHE::impl_prefetcher_final_stats() const { pref_module_pimpl->impl_prefetcher_final_stats(); }
 
 void CACHE::impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) const
@@ -837,10 +1080,74 @@ void CACHE::impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long
 
 void CACHE::impl_replacement_final_stats() const { repl_module_pimpl->impl_replacement_final_stats(); }
 
+void CACHE::impl_prefetcher_checkpoint(std::ostream& stream) const { pref_module_pimpl->impl_prefetcher_checkpoint(stream); }
+
+bool CACHE::impl_prefetcher_restore(std::istream& stream) const { return pref_module_pimpl->impl_prefetcher_restore(stream); }
+
+void CACHE::impl_replacement_checkpoint(std::ostream& stream) const { repl_module_pimpl->impl_replacement_checkpoint(stream); }
+
+bool CACHE::impl_replacement_restore(std::istream& stream) const { return repl_module_pimpl->impl_replacement_restore(stream); }
+
 void CACHE::initialize()
 {
   impl_prefetcher_initialize();
   impl_initialize_replacement();
+
+  for (auto* shadow : shadows) {
+    shadow->initialize();
+  }
+}
+
+void CACHE::checkpoint(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, std::pair{NUM_SET, NUM_WAY});
+  champsim::msl::checkpoint(stream, block);
+  champsim::msl::checkpoint_block(stream, "replacement", [this](std::ostream& module_stream) { impl_replacement_checkpoint(module_stream); });
+  champsim::msl::checkpoint_block(stream, "prefetcher", [this](std::ostream& module_stream) { impl_prefetcher_checkpoint(module_stream); });
+  for (const auto* shadow : shadows) {
+    champsim::msl::checkpoint_block(stream, shadow->NAME, [shadow](std::ostream& shadow_stream) { shadow->checkpoint(shadow_stream); });
+  }
+}
+
+void CACHE::restore(std::istream& stream)
+{
+  std::pair<uint32_t, uint32_t> shape{};
+  champsim::msl::restore(stream, shape);
+  if (shape != std::pair{NUM_SET, NUM_WAY}) {
+    throw std::runtime_error{fmt::format("{} has {} sets and {} ways, but its checkpoint has {} sets and {} ways", NAME, NUM_SET, NUM_WAY, shape.first,
+                                         shape.second)};
+  }
+  champsim::msl::restore(stream, block);
+  for (long set = 0; set < NUM_SET; ++set) {
+    for (long way = 0; way < NUM_WAY; ++way) {
+      update_tags(set, way);
+    }
+  }
+  assert(tags_match_blocks());
+
+  // Modules that have changed since the checkpoint was taken start cold
+  bool repl_restored = false;
+  champsim::msl::restore_block(stream, "replacement", [&](std::istream& module_stream) { repl_restored = impl_replacement_restore(module_stream); });
+  if (!repl_restored) {
+    fmt::print("[{}] WARNING: the checkpoint does not match the replacement policy, which will start cold\n", NAME);
+  }
+
+  bool pref_restored = false;
+  champsim::msl::restore_block(stream, "prefetcher", [&](std::istream& module_stream) { pref_restored = impl_prefetcher_restore(module_stream); });
+  if (!pref_restored) {
+    fmt::print("[{}] WARNING: the checkpoint does not match the prefetcher, which will start cold\n", NAME);
+  }
+
+  // Shadows are found by name, so that one missing from the checkpoint does not take the place of the next
+  auto shadow_blocks = champsim::msl::restore_blocks(stream);
+  for (auto* shadow : shadows) {
+    if (auto found = shadow_blocks.find(shadow->NAME); found != std::end(shadow_blocks)) {
+      std::istringstream shadow_stream{found->second};
+      shadow->restore(shadow_stream);
+    } else {
+      fmt::print("[{}] WARNING: the checkpoint does not contain this shadow cache, which will start cold\n", shadow->NAME);
+    }
+  }
 }
 
 void CACHE::begin_phase()
@@ -860,17 +1167,26 @@ void CACHE::begin_phase()
     ul->roi_stats = ul_new_roi_stats;
     ul->sim_stats = ul_new_sim_stats;
   }
+
+  for (auto* shadow : shadows) {
+    shadow->warmup = warmup;
+    shadow->begin_phase();
+  }
 }
 
 void CACHE::end_phase(unsigned finished_cpu)
 {
   finished_cpu = finished_cpu;
+  assert(tags_match_blocks());
+  assert(mshr_index_matches_mshr());
+
   roi_stats.total_miss_latency_cycles = sim_stats.total_miss_latency_cycles;
 
   roi_stats.hits = sim_stats.hits;
   roi_stats.misses = sim_stats.misses;
   roi_stats.mshr_merge = sim_stats.mshr_merge;
   roi_stats.mshr_return = sim_stats.mshr_return;
+  roi_stats.stack_distances = sim_stats.stack_distances;
 
   roi_stats.pf_requested = sim_stats.pf_requested;
   roi_stats.pf_issued = sim_stats.pf_issued;
@@ -895,6 +1211,10 @@ void CACHE::end_phase(unsigned finished_cpu)
     ul->roi_stats.WQ_TO_CACHE = ul->sim_stats.WQ_TO_CACHE;
     ul->roi_stats.WQ_FORWARD = ul->sim_stats.WQ_FORWARD;
   }
+
+  for (auto* shadow : shadows) {
+    shadow->end_phase(finished_cpu);
+  }
 }
 
 template <typename T>
@@ -1,5 +1,7 @@
 #include "cache_stats.h"
 
+#include <cmath>
+
 cache_stats operator-(cache_stats lhs, cache_stats rhs)
 {
   cache_stats result;
@@ -11,7 +13,45 @@ cache_stats operator-(cache_stats lhs, cache_stats rhs)
 
   result.hits = lhs.hits - rhs.hits;
   result.misses = lhs.misses - rhs.misses;
+  result.stack_distances = lhs.stack_distances - rhs.stack_distances;
 
   result.total_miss_latency_cycles = lhs.total_miss_latency_cycles - rhs.total_miss_latency_cycles;
   return result;
 }
+
+cache_stats operator+(cache_stats lhs, cache_stats rhs)
+{
+  lhs.pf_requested += rhs.pf_requested;
+  lhs.pf_issued += rhs.pf_issued;
+  lhs.pf_useful += rhs.pf_useful;
+  lhs.pf_useless += rhs.pf_useless;
+  lhs.pf_fill += rhs.pf_fill;
+
+  lhs.hits += rhs.hits;
+  lhs.misses += rhs.misses;
+  lhs.mshr_merge += rhs.mshr_merge;
+  lhs.mshr_return += rhs.mshr_return;
+  lhs.stack_distances += rhs.stack_distances;
+
+  lhs.total_miss_latency_cycles += rhs.total_miss_latency_cycles;
+  return lhs;
+}
+
+cache_stats operator*(cache_stats lhs, double factor)
+{
+  auto scale = [factor](uint64_t val) { return static_cast<uint64_t>(std::llround(static_cast<double>(val) * factor)); };
+  lhs.pf_requested = scale(lhs.pf_requested);
+  lhs.pf_issued = scale(lhs.pf_issued);
+  lhs.pf_useful = scale(lhs.pf_useful);
+  lhs.pf_useless = scale(lhs.pf_useless);
+  lhs.pf_fill = scale(lhs.pf_fill);
+
+  lhs.hits *= factor;
+  lhs.misses *= factor;
+  lhs.mshr_merge *= factor;
+  lhs.mshr_return *= factor;
+  lhs.stack_distances *= factor;
+
+  lhs.total_miss_latency_cycles = std::lround(static_cast<double>(lhs.total_miss_latency_cycles) * factor);
+  return lhs;
+}
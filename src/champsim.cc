@@ -18,18 +18,28 @@
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
+#include <functional>
+#include <limits>
 #include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
 #include <vector>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 
+#include "cache.h"
+#include "checkpoint.h"
 #include "environment.h"
 #include "ooo_cpu.h"
 #include "operable.h"
+#include "parallel.h"
 #include "phase_info.h"
+#include "ptw.h"
 #include "tracereader.h"
 
-constexpr int DEADLOCK_CYCLE{500};
+constexpr int DEADLOCK_CYCLE{champsim::deadlock_cycles};
 
 const auto start_time = std::chrono::steady_clock::now();
 
@@ -37,33 +47,241 @@ std::chrono::seconds elapsed_time() { return std::chrono::duration_cast<std::chr
 
 namespace champsim
 {
-long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<std::size_t> trace_index, champsim::chrono::clock& global_clock)
+void read_trace(O3_CPU& cpu, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index)
 {
-  auto operables = env.operable_view();
-  std::sort(std::begin(operables), std::end(operables),
-            [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
+  auto& trace = traces.at(trace_index.at(cpu.cpu));
+  for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); !trace.eof() && pkt_count > 0; --pkt_count) {
+    cpu.input_queue.push_back(trace());
+  }
+}
 
+long do_cycle(operable_schedule& schedule, const std::vector<std::reference_wrapper<O3_CPU>>& cpus, std::vector<tracereader>& traces,
+              const std::vector<std::size_t>& trace_index, champsim::chrono::clock& global_clock)
+{
   // Operate
   long progress{0};
-  for (champsim::operable& op : operables) {
+  for (champsim::operable& op : schedule.sorted()) {
     progress += op.operate_on(global_clock);
   }
 
   // Read from trace
-  for (O3_CPU& cpu : env.cpu_view()) {
-    auto& trace = traces.at(trace_index.at(cpu.cpu));
-    for (auto pkt_count = cpu.IN_QUEUE_SIZE - static_cast<long>(std::size(cpu.input_queue)); !trace.eof() && pkt_count > 0; --pkt_count) {
-      cpu.input_queue.push_back(trace());
+  for (O3_CPU& cpu : cpus) {
+    read_trace(cpu, traces, trace_index);
+  }
+
+  return progress;
+}
+
+/**
+ * The state needed to simulate each core's private hierarchy on its own thread.
+ */
+struct parallel_simulation {
+  long sync_cycles;
+  std::vector<std::reference_wrapper<O3_CPU>> cpus;
+  std::vector<operable_schedule> core_schedules{};
+  operable_schedule shared_schedule;
+  std::vector<long> core_progress;
+  worker_pool pool;
+
+  parallel_simulation(environment& env, const parallel_options& options, operable_partition partition)
+      : sync_cycles(options.sync_cycles), cpus(env.cpu_view()), shared_schedule(partition.shared), core_progress(std::size(cpus)),
+        pool(std::min(options.threads, std::size(cpus)))
+  {
+    // A period with no progress counts as sync_cycles stalled cycles at once, which must not be mistaken for a deadlock
+    if (sync_cycles < 1 || sync_cycles >= deadlock_cycles) {
+      throw std::invalid_argument{fmt::format("The number of sync cycles must be between 1 and {}, but is {}", deadlock_cycles - 1, sync_cycles)};
+    }
+
+    std::transform(std::cbegin(partition.private_groups), std::cend(partition.private_groups), std::back_inserter(core_schedules),
+                   [](const auto& group) { return operable_schedule{group}; });
+  }
+
+  parallel_simulation(environment& env, const parallel_options& options) : parallel_simulation(env, options, partition_operables(env)) {}
+};
+
+/**
+ * The routing of requests between the components of the hierarchy when simulating functionally.
+ * Each channel is mapped to the component that services its requests.
+ */
+struct functional_simulation {
+  std::unordered_map<const channel*, std::function<champsim::address(const channel::request_type&)>> handlers{};
+
+  explicit functional_simulation(environment& env)
+  {
+    auto forwarder = [this](channel* ch, const channel::request_type& pkt) { return forward(ch, pkt); };
+    for (CACHE& cache : env.cache_view()) {
+      for (auto* ul : cache.upper_levels) {
+        handlers.try_emplace(ul, [&cache, forwarder](const channel::request_type& pkt) { return cache.functional_access(pkt, forwarder); });
+      }
+    }
+    for (PageTableWalker& ptw : env.ptw_view()) {
+      for (auto* ul : ptw.upper_channels()) {
+        handlers.try_emplace(ul, [&ptw, forwarder](const channel::request_type& pkt) { return ptw.functional_translate(pkt, forwarder); });
+      }
+    }
+  }
+
+  /**
+   * Service the request immediately. Channels that are not mapped lead to main memory, which returns the request's own data.
+   */
+  champsim::address forward(const channel* ch, const channel::request_type& pkt) const
+  {
+    if (auto handler = handlers.find(ch); handler != std::end(handlers)) {
+      return handler->second(pkt);
+    }
+    return pkt.data;
+  }
+};
+
+long do_quantum(parallel_simulation& sim, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index,
+                champsim::chrono::clock& global_clock, champsim::chrono::clock::duration time_quantum)
+{
+  // Each core runs ahead through the quantum, seeing the shared components as they were when it began
+  const auto quantum_begin = global_clock;
+  std::fill(std::begin(sim.core_progress), std::end(sim.core_progress), 0);
+  sim.pool.run(std::size(sim.core_schedules), [&](std::size_t i) {
+    auto local_clock = quantum_begin;
+    for (long cycle = 0; cycle < sim.sync_cycles; ++cycle) {
+      local_clock.tick(time_quantum);
+      for (champsim::operable& op : sim.core_schedules[i].sorted()) {
+        sim.core_progress[i] += op.operate_on(local_clock);
+      }
+      read_trace(sim.cpus[i], traces, trace_index);
+    }
+  });
+
+  // The shared components then catch up, servicing the requests made during the quantum
+  auto progress = std::accumulate(std::cbegin(sim.core_progress), std::cend(sim.core_progress), long{0});
+  for (long cycle = 0; cycle < sim.sync_cycles; ++cycle) {
+    global_clock.tick(time_quantum);
+    for (champsim::operable& op : sim.shared_schedule.sorted()) {
+      progress += op.operate_on(global_clock);
     }
   }
 
   return progress;
 }
 
-phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock)
+/**
+ * Find the number of global clock ticks that can be skipped because no operable would change state in any of them.
+ */
+long skippable_cycles(const std::vector<std::reference_wrapper<operable>>& operables, const champsim::chrono::clock& global_clock,
+                      champsim::chrono::clock::duration time_quantum)
+{
+  const auto next_event = std::accumulate(std::cbegin(operables), std::cend(operables), champsim::chrono::clock::time_point::max(),
+                                          [](const auto acc, const operable& y) { return std::min(acc, y.next_event_time()); });
+  if (next_event == champsim::chrono::clock::time_point::max()) {
+    return std::numeric_limits<long>::max();
+  }
+
+  // Each operable may only advance to its last cycle before the next event
+  auto horizon = champsim::chrono::clock::time_point::max();
+  for (const operable& op : operables) {
+    auto cycles_before_event = (next_event - champsim::chrono::clock::duration{1} - op.current_time) / op.clock_period;
+    horizon = std::min(horizon, op.current_time + cycles_before_event * op.clock_period);
+  }
+
+  return std::max<long>((horizon - global_clock.now()) / time_quantum, 0);
+}
+
+/**
+ * Skip the instructions between the given phase and the previous one without simulating them.
+ */
+void skip_between_phases(const phase_info& phase, const std::vector<std::reference_wrapper<O3_CPU>>& cpus, std::vector<tracereader>& traces)
+{
+  if (phase.fast_forward > 0) {
+    for (O3_CPU& cpu : cpus) {
+      fmt::print("Fast-forwarding CPU {} by {} instructions\n", cpu.cpu, phase.fast_forward);
+      traces.at(phase.trace_index.at(cpu.cpu)).fast_forward(static_cast<uint64_t>(phase.fast_forward));
+    }
+  }
+}
+
+phase_stats collect_phase_stats(const phase_info& phase, environment& env)
+{
+  auto cpus = env.cpu_view();
+
+  phase_stats stats;
+  stats.name = phase.name;
+  stats.weight = phase.weight;
+
+  for (std::size_t i = 0; i < std::size(phase.trace_index); ++i) {
+    stats.trace_names.push_back(phase.trace_names.at(phase.trace_index.at(i)));
+  }
+
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
+  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
+
+  auto caches = env.cache_view();
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
+  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
+
+  auto dram = env.dram_view();
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
+  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
+                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+
+  return stats;
+}
+
+/**
+ * Run the phase without the timing model. Each instruction is retired as soon as it is read, and its accesses are serviced immediately.
+ */
+phase_stats do_functional_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, const functional_simulation& functional)
+{
+  auto operables = env.operable_view();
+  auto cpus = env.cpu_view();
+  skip_between_phases(phase, cpus, traces);
+
+  for (champsim::operable& op : operables) {
+    op.warmup = phase.is_warmup;
+    op.begin_phase();
+  }
+
+  const champsim::functional_forward_type forwarder = [&functional](channel* ch, const channel::request_type& pkt) { return functional.forward(ch, pkt); };
+
+  // Interleave the cores one instruction at a time
+  std::vector<bool> phase_complete(std::size(cpus), false);
+  while (!std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and{})) {
+    for (O3_CPU& cpu : cpus) {
+      if (phase_complete[cpu.cpu]) {
+        continue;
+      }
+
+      // Instructions already read for the timing model are consumed before the trace
+      auto& trace = traces.at(phase.trace_index.at(cpu.cpu));
+      if (!std::empty(cpu.input_queue)) {
+        cpu.functional_operate(cpu.input_queue.front(), forwarder);
+        cpu.input_queue.pop_front();
+      } else if (!trace.eof()) {
+        cpu.functional_operate(trace(), forwarder);
+      }
+
+      if (cpu.sim_instr() >= phase.length || (std::empty(cpu.input_queue) && trace.eof())) {
+        phase_complete[cpu.cpu] = true;
+        for (champsim::operable& op : operables) {
+          op.end_phase(cpu.cpu);
+        }
+
+        fmt::print("{} finished CPU {} instructions: {} (functional) (Simulation time: {:%H hr %M min %S sec})\n", phase.name, cpu.cpu, cpu.sim_instr(),
+                   elapsed_time());
+      }
+    }
+  }
+
+  return collect_phase_stats(phase, env);
+}
+
+phase_stats do_phase(const phase_info& phase, environment& env, std::vector<tracereader>& traces, champsim::chrono::clock& global_clock,
+                     parallel_simulation* parallel)
 {
   auto operables = env.operable_view();
-  auto [phase_name, is_warmup, length, trace_index, trace_names] = phase;
+  auto cpus = env.cpu_view();
+  operable_schedule schedule{operables};
+  auto [phase_name, is_warmup, length, trace_index, trace_names, fast_forward, weight, functional] = phase;
+
+  skip_between_phases(phase, cpus, traces);
 
   // Initialize phase
   for (champsim::operable& op : operables) {
@@ -79,28 +297,51 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   uint64_t livelock_timer{0};
   //                                   die | critical | warning
   std::vector<double> livelock_threshold{0.01, 0.02, 0.05};
-  std::vector<uint64_t> livelock_instr(std::size(env.cpu_view()), 0);
+  std::vector<uint64_t> livelock_instr(std::size(cpus), 0);
 
   // Perform phase
   int stalled_cycle{0};
-  std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
+  std::vector<bool> phase_complete(std::size(cpus), false);
+  std::vector<bool> next_phase_complete(std::size(cpus), false);
   while (!std::accumulate(std::begin(phase_complete), std::end(phase_complete), true, std::logical_and{})) {
-    auto next_phase_complete = phase_complete;
-    global_clock.tick(time_quantum);
+    next_phase_complete = phase_complete;
+
+    long cycles{1};
+    long progress{0};
+    if (parallel != nullptr) {
+      cycles = parallel->sync_cycles;
+      progress = do_quantum(*parallel, traces, trace_index, global_clock, time_quantum);
+    } else {
+      // Fast-forward through cycles in which nothing can happen, stopping short of the deadlock and livelock checks
+      if (stalled_cycle > 0) {
+        auto skip = std::min({skippable_cycles(operables, global_clock, time_quantum), static_cast<long>(DEADLOCK_CYCLE - 1 - stalled_cycle),
+                              static_cast<long>(livelock_period - livelock_timer - 1)});
+        if (skip > 0) {
+          global_clock.tick(skip * time_quantum);
+          for (champsim::operable& op : operables) {
+            op.skip_on(global_clock);
+          }
+          stalled_cycle += static_cast<int>(skip);
+          livelock_timer += static_cast<uint64_t>(skip);
+        }
+      }
+
+      global_clock.tick(time_quantum);
 
-    auto progress = do_cycle(env, traces, trace_index, global_clock);
+      progress = do_cycle(schedule, cpus, traces, trace_index, global_clock);
+    }
 
     if (progress == 0) {
-      ++stalled_cycle;
+      stalled_cycle += static_cast<int>(cycles);
     } else {
       stalled_cycle = 0;
     }
 
     // Livelock detect, every livelock_period cycles, check progress and alert the user
-    livelock_timer++;
+    livelock_timer += static_cast<uint64_t>(cycles);
     if (livelock_timer >= livelock_period) {
       // for each cpu
-      for (O3_CPU& cpu : env.cpu_view()) {
+      for (O3_CPU& cpu : cpus) {
         // for each threshold
         for (auto thres = std::begin(livelock_threshold); thres != std::end(livelock_threshold); thres++) {
           double livelock_ipc = std::ceil(cpu.sim_instr() - livelock_instr[cpu.cpu]) / std::ceil(livelock_period);
@@ -132,12 +373,12 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     }
 
     // Check for phase finish
-    for (O3_CPU& cpu : env.cpu_view()) {
+    for (O3_CPU& cpu : cpus) {
       // Phase complete
       next_phase_complete[cpu.cpu] = next_phase_complete[cpu.cpu] || (cpu.sim_instr() >= length);
     }
 
-    for (O3_CPU& cpu : env.cpu_view()) {
+    for (O3_CPU& cpu : cpus) {
       if (next_phase_complete[cpu.cpu] != phase_complete[cpu.cpu]) {
         for (champsim::operable& op : operables) {
           op.end_phase(cpu.cpu);
@@ -151,49 +392,74 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
     phase_complete = next_phase_complete;
   }
 
-  for (O3_CPU& cpu : env.cpu_view()) {
+  for (O3_CPU& cpu : cpus) {
     fmt::print("{} complete CPU {} instructions: {} cycles: {} cumulative IPC: {:.4g} (Simulation time: {:%H hr %M min %S sec})\n", phase_name, cpu.cpu,
                cpu.sim_instr(), cpu.sim_cycle(), std::ceil(cpu.sim_instr()) / std::ceil(cpu.sim_cycle()), elapsed_time());
   }
 
-  phase_stats stats;
-  stats.name = phase.name;
+  return collect_phase_stats(phase, env);
+}
 
-  for (std::size_t i = 0; i < std::size(trace_index); ++i) {
-    stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
+// simulation entry point
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const parallel_options& options,
+                              const checkpoint_options& checkpoints)
+{
+  // A functional phase does not drain the pipeline, so the instructions in flight at the end of a timed phase would retire in the next timed one
+  auto timed_then_functional =
+      std::adjacent_find(std::begin(phases), std::end(phases), [](const auto& prev, const auto& next) { return !prev.functional && next.functional; });
+  if (timed_then_functional != std::end(phases)) {
+    throw std::invalid_argument{fmt::format("Phase {} runs without the timing model after the timed phase {}", std::next(timed_then_functional)->name,
+                                            timed_then_functional->name)};
   }
 
-  auto cpus = env.cpu_view();
-  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.sim_cpu_stats), [](const O3_CPU& cpu) { return cpu.sim_stats; });
-  std::transform(std::begin(cpus), std::end(cpus), std::back_inserter(stats.roi_cpu_stats), [](const O3_CPU& cpu) { return cpu.roi_stats; });
+  for (champsim::operable& op : env.operable_view()) {
+    op.initialize();
+  }
 
-  auto caches = env.cache_view();
-  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.sim_cache_stats), [](const CACHE& cache) { return cache.sim_stats; });
-  std::transform(std::begin(caches), std::end(caches), std::back_inserter(stats.roi_cache_stats), [](const CACHE& cache) { return cache.roi_stats; });
+  const bool restored = !checkpoints.restore_file.empty();
+  if (restored) {
+    std::ifstream checkpoint_file{checkpoints.restore_file, std::ios::binary};
+    if (!checkpoint_file) {
+      throw std::runtime_error{"Could not open checkpoint " + checkpoints.restore_file};
+    }
+    fmt::print("Restoring checkpoint from {}\n", checkpoints.restore_file);
+    restore_checkpoint(checkpoint_file, env, traces, phases.front().trace_index, checkpoints.skip_instructions);
+  }
 
-  auto dram = env.dram_view();
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.sim_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.sim_stats; });
-  std::transform(std::begin(dram.channels), std::end(dram.channels), std::back_inserter(stats.roi_dram_stats),
-                 [](const DRAM_CHANNEL& chan) { return chan.roi_stats; });
+  auto last_warmup = std::find_if(std::rbegin(phases), std::rend(phases), [](const auto& phase) { return phase.is_warmup; });
 
-  return stats;
-}
+  std::optional<parallel_simulation> parallel{};
+  if (options.threads > 1 && std::size(env.cpu_view()) > 1) {
+    parallel.emplace(env, options);
+  }
 
-// simulation entry point
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
-{
-  for (champsim::operable& op : env.operable_view()) {
-    op.initialize();
+  std::optional<functional_simulation> functional{};
+  if (std::any_of(std::begin(phases), std::end(phases), [](const auto& phase) { return phase.functional; })) {
+    functional.emplace(env);
   }
 
   champsim::chrono::clock global_clock;
   std::vector<phase_stats> results;
-  for (auto phase : phases) {
-    auto stats = do_phase(phase, env, traces, global_clock);
-    if (!phase.is_warmup) {
+  for (auto phase_it = std::begin(phases); phase_it != std::end(phases); ++phase_it) {
+    // The checkpoint replaces the warmup phases
+    if (restored && phase_it->is_warmup) {
+      continue;
+    }
+
+    auto stats = phase_it->functional ? do_functional_phase(*phase_it, env, traces, functional.value())
+                                      : do_phase(*phase_it, env, traces, global_clock, parallel.has_value() ? &parallel.value() : nullptr);
+    if (!phase_it->is_warmup) {
       results.push_back(stats);
     }
+
+    if (!checkpoints.save_file.empty() && last_warmup != std::rend(phases) && phase_it == std::prev(last_warmup.base())) {
+      std::ofstream checkpoint_file{checkpoints.save_file, std::ios::binary};
+      save_checkpoint(checkpoint_file, env, checkpoints.skip_instructions);
+      if (!checkpoint_file) {
+        throw std::runtime_error{"Could not write checkpoint " + checkpoints.save_file};
+      }
+      fmt::print("Saved checkpoint to {}\n", checkpoints.save_file);
+    }
   }
 
   return results;
@@ -29,16 +29,56 @@ champsim::channel::channel(std::size_t rq_size, std::size_t pq_size, std::size_t
 {
 }
 
+void champsim::channel::queue_index::prune(const queue_type& queue)
+{
+  auto front = queue.position_of(std::cbegin(queue));
+  for (; !std::empty(checked) && checked.front().first < front; checked.pop_front()) {
+    auto [position, block] = checked.front();
+    auto found = positions_by_block.find(block);
+    assert(found != std::end(positions_by_block) && found->second.front() == position);
+    found->second.erase(std::begin(found->second));
+    if (std::empty(found->second)) {
+      positions_by_block.erase(found);
+    }
+  }
+}
+
+void champsim::channel::queue_index::add(uint64_t position, uint64_t block)
+{
+  positions_by_block[block].push_back(position);
+  checked.emplace_back(position, block);
+}
+
+auto champsim::channel::queue_index::first_unchecked(queue_type& queue) const -> queue_type::iterator
+{
+  // Packets are checked in the order they were added, so the unchecked packets follow the last checked one
+  if (std::empty(checked)) {
+    return std::begin(queue);
+  }
+  return queue.find_position(checked.back().first + 1);
+}
+
+auto champsim::channel::queue_index::find(queue_type& queue, uint64_t block) const -> queue_type::iterator
+{
+  if (auto found = positions_by_block.find(block); found != std::end(positions_by_block)) {
+    return queue.find_position(found->second.front());
+  }
+  return std::end(queue);
+}
+
+namespace
+{
+uint64_t block_of(champsim::address address, champsim::data::bits shamt) { return address.slice_upper(shamt).to<uint64_t>(); }
+} // namespace
+
 template <typename Iter, typename F>
-bool do_collision_for(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt, F&& func)
+bool do_collision_for(Iter found, Iter end, champsim::channel::request_type& packet, F&& func)
 {
   // We make sure that both merge packet address have been translated. If
   // not this can happen: package with address virtual and physical X
   // (not translated) is inserted, package with physical address
   // (already translated) X.
-  if (auto found =
-          std::find_if(begin, end, [match = packet.address.slice_upper(shamt), shamt](const auto& x) { return x.address.slice_upper(shamt) == match; });
-      found != end && packet.is_translated == found->is_translated) {
+  if (found != end && packet.is_translated == found->is_translated) {
     func(packet, *found);
     return true;
   }
@@ -47,9 +87,9 @@ bool do_collision_for(Iter begin, Iter end, champsim::channel::request_type& pac
 }
 
 template <typename Iter>
-bool do_collision_for_merge(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt)
+bool do_collision_for_merge(Iter found, Iter end, champsim::channel::request_type& packet)
 {
-  return do_collision_for(begin, end, packet, shamt, [](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
+  return do_collision_for(found, end, packet, [](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
     destination.response_requested |= source.response_requested;
     auto instr_copy = std::move(destination.instr_depend_on_me);
 
@@ -59,10 +99,9 @@ bool do_collision_for_merge(Iter begin, Iter end, champsim::channel::request_typ
 }
 
 template <typename Iter>
-bool do_collision_for_return(Iter begin, Iter end, champsim::channel::request_type& packet, champsim::data::bits shamt,
-                             std::deque<champsim::channel::response_type>& returned)
+bool do_collision_for_return(Iter found, Iter end, champsim::channel::request_type& packet, std::deque<champsim::channel::response_type>& returned)
 {
-  return do_collision_for(begin, end, packet, shamt, [&](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
+  return do_collision_for(found, end, packet, [&](champsim::channel::request_type& source, champsim::channel::request_type& destination) {
     if (source.response_requested) {
       returned.emplace_back(source.address, source.v_address, destination.data, destination.pf_metadata, source.instr_depend_on_me);
     }
@@ -74,41 +113,51 @@ void champsim::channel::check_collision()
   auto write_shamt = match_offset_bits ? champsim::data::bits{} : OFFSET_BITS;
   auto read_shamt = OFFSET_BITS;
 
+  wq_index.prune(WQ);
+  rq_index.prune(RQ);
+  pq_index.prune(PQ);
+
   // Check WQ for duplicates, merging if they are found
-  for (auto wq_it = std::find_if(std::begin(WQ), std::end(WQ), std::not_fn(&request_type::forward_checked)); wq_it != std::end(WQ);) {
-    if (do_collision_for_merge(std::begin(WQ), wq_it, *wq_it, write_shamt)) {
+  for (auto wq_it = wq_index.first_unchecked(WQ); wq_it != std::end(WQ);) {
+    auto block = block_of(wq_it->address, write_shamt);
+    if (do_collision_for_merge(wq_index.find(WQ, block), std::end(WQ), *wq_it)) {
       sim_stats.WQ_MERGED++;
       wq_it = WQ.erase(wq_it);
     } else {
       wq_it->forward_checked = true;
+      wq_index.add(WQ.position_of(wq_it), block);
       ++wq_it;
     }
   }
 
   // Check RQ for forwarding from WQ (return if found), then for duplicates (merge if found)
-  for (auto rq_it = std::find_if(std::begin(RQ), std::end(RQ), std::not_fn(&request_type::forward_checked)); rq_it != std::end(RQ);) {
-    if (do_collision_for_return(std::begin(WQ), std::end(WQ), *rq_it, write_shamt, returned)) {
+  for (auto rq_it = rq_index.first_unchecked(RQ); rq_it != std::end(RQ);) {
+    auto block = block_of(rq_it->address, read_shamt);
+    if (do_collision_for_return(wq_index.find(WQ, block_of(rq_it->address, write_shamt)), std::end(WQ), *rq_it, returned)) {
       sim_stats.WQ_FORWARD++;
       rq_it = RQ.erase(rq_it);
-    } else if (do_collision_for_merge(std::begin(RQ), rq_it, *rq_it, read_shamt)) {
+    } else if (do_collision_for_merge(rq_index.find(RQ, block), std::end(RQ), *rq_it)) {
       sim_stats.RQ_MERGED++;
       rq_it = RQ.erase(rq_it);
     } else {
       rq_it->forward_checked = true;
+      rq_index.add(RQ.position_of(rq_it), block);
       ++rq_it;
     }
   }
 
   // Check PQ for forwarding from WQ (return if found), then for duplicates (merge if found)
-  for (auto pq_it = std::find_if(std::begin(PQ), std::end(PQ), std::not_fn(&request_type::forward_checked)); pq_it != std::end(PQ);) {
-    if (do_collision_for_return(std::begin(WQ), std::end(WQ), *pq_it, write_shamt, returned)) {
+  for (auto pq_it = pq_index.first_unchecked(PQ); pq_it != std::end(PQ);) {
+    auto block = block_of(pq_it->address, read_shamt);
+    if (do_collision_for_return(wq_index.find(WQ, block_of(pq_it->address, write_shamt)), std::end(WQ), *pq_it, returned)) {
       sim_stats.WQ_FORWARD++;
       pq_it = PQ.erase(pq_it);
-    } else if (do_collision_for_merge(std::begin(PQ), pq_it, *pq_it, read_shamt)) {
+    } else if (do_collision_for_merge(pq_index.find(PQ, block), std::end(PQ), *pq_it)) {
       sim_stats.PQ_MERGED++;
       pq_it = PQ.erase(pq_it);
     } else {
       pq_it->forward_checked = true;
+      pq_index.add(PQ.position_of(pq_it), block);
       ++pq_it;
     }
   }
@@ -0,0 +1,84 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "checkpoint.h"
+
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "environment.h"
+#include "msl/checkpoint.h"
+
+namespace
+{
+const std::string checkpoint_magic{"ChampSim checkpoint"};
+constexpr uint32_t checkpoint_version = 2;
+} // namespace
+
+void champsim::save_checkpoint(std::ostream& stream, environment& env, uint64_t skip_instructions)
+{
+  champsim::msl::checkpoint(stream, checkpoint_magic);
+  champsim::msl::checkpoint(stream, checkpoint_version);
+  champsim::msl::checkpoint(stream, skip_instructions);
+
+  auto operables = env.operable_view();
+  champsim::msl::checkpoint(stream, static_cast<uint64_t>(std::size(operables)));
+  for (std::size_t i = 0; i < std::size(operables); ++i) {
+    champsim::msl::checkpoint_block(stream, std::to_string(i), [op = operables[i]](std::ostream& op_stream) { op.get().checkpoint(op_stream); });
+  }
+
+  env.vmem_view().checkpoint(stream);
+}
+
+void champsim::restore_checkpoint(std::istream& stream, environment& env, std::vector<tracereader>& traces, const std::vector<std::size_t>& trace_index,
+                                  uint64_t skip_instructions)
+{
+  std::string magic;
+  uint32_t version{};
+  champsim::msl::restore(stream, magic);
+  champsim::msl::restore(stream, version);
+  if (magic != checkpoint_magic || version != checkpoint_version) {
+    throw std::runtime_error{"The file is not a checkpoint written by this version of ChampSim"};
+  }
+
+  uint64_t saved_skip{};
+  champsim::msl::restore(stream, saved_skip);
+  if (saved_skip != skip_instructions) {
+    throw std::runtime_error{
+        fmt::format("The checkpoint was saved after skipping {} instructions, but {} instructions were skipped", saved_skip, skip_instructions)};
+  }
+
+  auto operables = env.operable_view();
+  uint64_t num_operables{};
+  champsim::msl::restore(stream, num_operables);
+  if (num_operables != std::size(operables)) {
+    throw std::runtime_error{fmt::format("The checkpoint has {} components, but the configuration has {}", num_operables, std::size(operables))};
+  }
+  for (std::size_t i = 0; i < std::size(operables); ++i) {
+    if (!champsim::msl::restore_block(stream, std::to_string(i), [op = operables[i]](std::istream& op_stream) { op.get().restore(op_stream); })) {
+      throw std::runtime_error{fmt::format("The checkpoint does not hold the state of component {}", i)};
+    }
+  }
+
+  env.vmem_view().restore(stream);
+
+  // Skip the instructions that were retired before the checkpoint
+  for (O3_CPU& cpu : env.cpu_view()) {
+    traces.at(trace_index.at(cpu.cpu)).fast_forward(static_cast<uint64_t>(cpu.num_retired));
+  }
+}
@@ -1,5 +1,7 @@
 #include "core_stats.h"
 
+#include <cmath>
+
 cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
 {
   lhs.begin_instrs -= rhs.begin_instrs;
@@ -13,3 +15,33 @@ cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
 
   return lhs;
 }
+
+cpu_stats operator+(cpu_stats lhs, cpu_stats rhs)
+{
+  lhs.begin_instrs += rhs.begin_instrs;
+  lhs.begin_cycles += rhs.begin_cycles;
+  lhs.end_instrs += rhs.end_instrs;
+  lhs.end_cycles += rhs.end_cycles;
+  lhs.total_rob_occupancy_at_branch_mispredict += rhs.total_rob_occupancy_at_branch_mispredict;
+
+  lhs.total_branch_types += rhs.total_branch_types;
+  lhs.branch_type_misses += rhs.branch_type_misses;
+
+  return lhs;
+}
+
+cpu_stats operator*(cpu_stats lhs, double factor)
+{
+  // Scale the lengths rather than the endpoints, so that rounding cannot change the difference between them
+  lhs.end_instrs = std::llround(static_cast<double>(lhs.instrs()) * factor);
+  lhs.end_cycles = std::llround(static_cast<double>(lhs.cycles()) * factor);
+  lhs.begin_instrs = 0;
+  lhs.begin_cycles = 0;
+  lhs.total_rob_occupancy_at_branch_mispredict =
+      static_cast<uint64_t>(std::llround(static_cast<double>(lhs.total_rob_occupancy_at_branch_mispredict) * factor));
+
+  lhs.total_branch_types *= factor;
+  lhs.branch_type_misses *= factor;
+
+  return lhs;
+}
@@ -104,6 +104,29 @@ long MEMORY_CONTROLLER::operate()
   return progress;
 }
 
+champsim::chrono::clock::time_point MEMORY_CONTROLLER::next_event_time() const
+{
+  auto queue_occupied = [](const auto* ul) {
+    return !std::empty(ul->RQ) || !std::empty(ul->WQ) || !std::empty(ul->PQ);
+  };
+  if (std::any_of(std::begin(queues), std::end(queues), queue_occupied)) {
+    return current_time + clock_period;
+  }
+
+  auto next_event = champsim::chrono::clock::time_point::max();
+  for (const auto& channel : channels) {
+    next_event = std::min(next_event, channel.next_event_time());
+  }
+  return next_event;
+}
+
+void MEMORY_CONTROLLER::skip_cycles(long cycles)
+{
+  for (auto& channel : channels) {
+    channel._skip(cycles);
+  }
+}
+
 long DRAM_CHANNEL::operate()
 {
   long progress{0};
@@ -127,6 +150,12 @@ long DRAM_CHANNEL::operate()
       }
       entry.reset();
     }
+
+    // Requests left in the banks by a previous detailed phase were answered above
+    for (auto& bank : bank_request) {
+      bank.valid = false;
+    }
+    active_request = std::end(bank_request);
   }
 
   check_write_collision();
@@ -140,6 +169,50 @@ long DRAM_CHANNEL::operate()
   return progress;
 }
 
+champsim::chrono::clock::time_point DRAM_CHANNEL::next_event_time() const
+{
+  const auto next_cycle = current_time + clock_period;
+
+  auto occupied = [](const auto& entry) {
+    return entry.has_value();
+  };
+  auto unchecked = [](const auto& entry) {
+    return entry.has_value() && !entry->forward_checked;
+  };
+  auto refreshing = [](const auto& b_req) {
+    return (b_req.need_refresh && !b_req.valid) || b_req.under_refresh;
+  };
+
+  // Warmup drains, collision checks, mode swaps, and refreshes are handled in the next cycle
+  bool any_occupied = std::any_of(std::begin(RQ), std::end(RQ), occupied) || std::any_of(std::begin(WQ), std::end(WQ), occupied);
+  if ((warmup && any_occupied) || std::any_of(std::begin(RQ), std::end(RQ), unchecked) || std::any_of(std::begin(WQ), std::end(WQ), unchecked)
+      || std::any_of(std::begin(bank_request), std::end(bank_request), refreshing) || should_swap_write_mode()) {
+    return next_cycle;
+  }
+
+  auto next_event = last_refresh + tREF;
+
+  // Requests in the banks finish or wait for the data bus
+  for (const auto& b_req : bank_request) {
+    if (b_req.valid) {
+      next_event = std::min(next_event, b_req.ready_time);
+    }
+  }
+
+  // Unscheduled requests may be sent to a free bank
+  const auto& queue = write_mode ? WQ : RQ;
+  for (const auto& entry : queue) {
+    if (entry.has_value() && !entry->scheduled) {
+      const auto& b_req = bank_request[bank_request_index(entry->address)];
+      if (!b_req.valid && !b_req.under_refresh) {
+        next_event = std::min(next_event, entry->ready_time);
+      }
+    }
+  }
+
+  return std::max(next_event, next_cycle);
+}
+
 long DRAM_CHANNEL::finish_dbus_request()
 {
   long progress{0};
@@ -201,7 +274,7 @@ long DRAM_CHANNEL::schedule_refresh()
   return (progress);
 }
 
-void DRAM_CHANNEL::swap_write_mode()
+bool DRAM_CHANNEL::should_swap_write_mode() const
 {
   // these values control when to send out a burst of writes
   const std::size_t DRAM_WRITE_HIGH_WM = ((std::size(WQ) * 7) >> 3); // 7/8th
@@ -213,8 +286,13 @@ void DRAM_CHANNEL::swap_write_mode()
   auto rq_occu = static_cast<std::size_t>(std::count_if(std::begin(RQ), std::end(RQ), [](const auto& x) { return x.has_value(); }));
 
   // Change modes if the queues are unbalanced
-  if ((!write_mode && (wq_occu >= DRAM_WRITE_HIGH_WM || (rq_occu == 0 && wq_occu > 0)))
-      || (write_mode && (wq_occu == 0 || (rq_occu > 0 && wq_occu < DRAM_WRITE_LOW_WM)))) {
+  return (!write_mode && (wq_occu >= DRAM_WRITE_HIGH_WM || (rq_occu == 0 && wq_occu > 0)))
+         || (write_mode && (wq_occu == 0 || (rq_occu > 0 && wq_occu < DRAM_WRITE_LOW_WM)));
+}
+
+void DRAM_CHANNEL::swap_write_mode()
+{
+  if (should_swap_write_mode()) {
     // Reset scheduled requests
     for (auto it = std::begin(bank_request); it != std::end(bank_request); ++it) {
       // Leave active request on the data bus
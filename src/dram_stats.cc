@@ -1,5 +1,7 @@
 #include "dram_stats.h"
 
+#include <cmath>
+
 dram_stats operator-(dram_stats lhs, dram_stats rhs)
 {
   lhs.dbus_cycle_congested -= rhs.dbus_cycle_congested;
@@ -11,3 +13,30 @@ dram_stats operator-(dram_stats lhs, dram_stats rhs)
   lhs.WQ_FULL -= rhs.WQ_FULL;
   return lhs;
 }
+
+dram_stats operator+(dram_stats lhs, dram_stats rhs)
+{
+  lhs.dbus_cycle_congested += rhs.dbus_cycle_congested;
+  lhs.dbus_count_congested += rhs.dbus_count_congested;
+  lhs.refresh_cycles += rhs.refresh_cycles;
+  lhs.WQ_ROW_BUFFER_HIT += rhs.WQ_ROW_BUFFER_HIT;
+  lhs.WQ_ROW_BUFFER_MISS += rhs.WQ_ROW_BUFFER_MISS;
+  lhs.RQ_ROW_BUFFER_HIT += rhs.RQ_ROW_BUFFER_HIT;
+  lhs.RQ_ROW_BUFFER_MISS += rhs.RQ_ROW_BUFFER_MISS;
+  lhs.WQ_FULL += rhs.WQ_FULL;
+  return lhs;
+}
+
+dram_stats operator*(dram_stats lhs, double factor)
+{
+  auto scale = [factor](auto val) { return static_cast<decltype(val)>(std::llround(static_cast<double>(val) * factor)); };
+  lhs.dbus_cycle_congested = scale(lhs.dbus_cycle_congested);
+  lhs.dbus_count_congested = scale(lhs.dbus_count_congested);
+  lhs.refresh_cycles = scale(lhs.refresh_cycles);
+  lhs.WQ_ROW_BUFFER_HIT = scale(lhs.WQ_ROW_BUFFER_HIT);
+  lhs.WQ_ROW_BUFFER_MISS = scale(lhs.WQ_ROW_BUFFER_MISS);
+  lhs.RQ_ROW_BUFFER_HIT = scale(lhs.RQ_ROW_BUFFER_HIT);
+  lhs.RQ_ROW_BUFFER_MISS = scale(lhs.RQ_ROW_BUFFER_MISS);
+  lhs.WQ_FULL = scale(lhs.WQ_FULL);
+  return lhs;
+}
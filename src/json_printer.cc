@@ -71,6 +71,30 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
     statsmap.emplace(access_type_names.at(champsim::to_underlying(type)), nlohmann::json{{"hit", hits}, {"miss", misses}, {"mshr_merge", mshr_merges}});
   }
 
+  if (!std::empty(stats.stack_distances.get_keys())) {
+    // For each cpu, a list of [size in bytes, miss ratio] points
+    std::vector<std::vector<std::pair<long, double>>> curves(NUM_CPUS);
+    for (std::size_t cpu = 0; cpu < NUM_CPUS; ++cpu) {
+      long accesses = 0;
+      for (auto key : stats.stack_distances.get_keys()) {
+        if (key.second == cpu) {
+          accesses += stats.stack_distances.value_or(key, 0);
+        }
+      }
+
+      auto misses = accesses;
+      for (auto key : stats.stack_distances.get_keys()) {
+        if (key.second == cpu) {
+          misses -= stats.stack_distances.value_or(key, 0);
+          if (key.first != champsim::stack_distance_profiler::cold) {
+            curves.at(cpu).emplace_back(key.first, std::ceil(misses) / std::ceil(accesses));
+          }
+        }
+      }
+    }
+    statsmap.emplace("miss ratio curve", curves);
+  }
+
   j = statsmap;
 }
 
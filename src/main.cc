@@ -17,19 +17,25 @@
 #include <algorithm>
 #include <fstream>
 #include <numeric>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 #include <CLI/CLI.hpp>
 #include <fmt/core.h>
 
+#include "batch.h"
 #include "cache.h" // for CACHE
 #include "champsim.h"
+#include "checkpoint.h"
 #ifndef CHAMPSIM_TEST_BUILD
 #include "core_inst.inc"
 #endif
 #include "defaults.hpp"
 #include "environment.h"
+#include "inf_stream.h"
 #include "ooo_cpu.h" // for O3_CPU
+#include "parallel.h"
 #include "phase_info.h"
 #include "stats_printer.h"
 #include "tracereader.h"
@@ -37,7 +43,8 @@
 
 namespace champsim
 {
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const parallel_options& options,
+                              const checkpoint_options& checkpoints);
 }
 
 #ifndef CHAMPSIM_TEST_BUILD
@@ -54,24 +61,25 @@ const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
 #ifndef CHAMPSIM_TEST_BUILD
 int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 {
-  configured_environment gen_environment{};
-
   CLI::App app{"A microarchitecture simulator for research and education"};
 
   bool knob_cloudsuite{false};
+  bool knob_hide_heartbeat{false};
+  bool knob_functional_warmup{false};
+  long long skip_instructions = 0;
   long long warmup_instructions = 0;
   long long simulation_instructions = std::numeric_limits<long long>::max();
   std::string json_file_name;
+  std::string region_file_name;
+  std::string batch_file_name;
+  std::size_t batch_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  unsigned decoder_threads = 0;
   std::vector<std::string> trace_names;
-
-  auto set_heartbeat_callback = [&](auto) {
-    for (O3_CPU& cpu : gen_environment.cpu_view()) {
-      cpu.show_heartbeat = false;
-    }
-  };
+  champsim::parallel_options parallel{};
+  champsim::checkpoint_options checkpoints{};
 
   app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
-  app.add_flag("--hide-heartbeat", set_heartbeat_callback, "Hide the heartbeat output");
+  app.add_flag("--hide-heartbeat", knob_hide_heartbeat, "Hide the heartbeat output");
   auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
   auto* deprec_warmup_instr_option =
       app.add_option("--warmup_instructions", warmup_instructions, "[deprecated] use --warmup-instructions instead")->excludes(warmup_instr_option);
@@ -83,10 +91,105 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   auto* json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
-  app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
+  app.add_option("--threads", parallel.threads,
+                 "The number of threads used to simulate the cores. If greater than 1, each core runs ahead of the shared components, and idle cycles "
+                 "are simulated rather than skipped")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--sync-cycles", parallel.sync_cycles,
+                 "The number of cycles the cores may run ahead of the shared components when using multiple threads. It must be less than the "
+                 "number of cycles without progress that is reported as a deadlock.")
+      ->check(CLI::Range(1L, champsim::deadlock_cycles - 1));
+
+  auto* save_checkpoint_option =
+      app.add_option("--save-checkpoint", checkpoints.save_file, "The name of the file to receive the state of the simulation after warmup");
+  auto* restore_checkpoint_option =
+      app.add_option("--restore-checkpoint", checkpoints.restore_file,
+                     "The name of a file from which to restore the state of the simulation, instead of warming up")
+          ->excludes(save_checkpoint_option)
+          ->check(CLI::ExistingFile);
+
+  auto* region_option = app.add_option("--regions", region_file_name,
+                                       "The name of a file listing the regions to simulate, one per line as '<start> <length> <weight>'. Each region is "
+                                       "preceded by the warmup instructions, and the statistics are also reported as a weighted aggregate.")
+                            ->excludes(sim_instr_option, deprec_sim_instr_option, save_checkpoint_option, restore_checkpoint_option)
+                            ->check(CLI::ExistingFile);
+
+  auto* skip_instr_option = app.add_option("--skip-instructions", skip_instructions,
+                                           "The number of instructions to pass over at the beginning of each trace, before the warmup. They are "
+                                           "neither simulated nor decoded, so skipping runs at the speed of decompression.")
+                                ->excludes(region_option)
+                                ->check(CLI::NonNegativeNumber);
+
+  app.add_flag("--functional-warmup", knob_functional_warmup,
+               "Warm up without the timing model. Caches, TLBs, prefetchers, and branch predictors are updated as each instruction is read. "
+               "Not available with --regions, because the instructions in flight at the end of a region would be counted in the next one.")
+      ->excludes(region_option);
+
+  auto* traces_option = app.add_option("traces", trace_names, "The paths to the traces")->expected(NUM_CPUS)->check(CLI::ExistingFile);
+
+  auto* batch_option = app.add_option("--batch", batch_file_name,
+                                      "The name of a JSON file listing simulations to run in this process, each with its own traces and options. Simulations "
+                                      "that read the same trace at the same time decompress it once.")
+                           ->excludes(traces_option, warmup_instr_option, deprec_warmup_instr_option, sim_instr_option, deprec_sim_instr_option, json_option,
+                                      save_checkpoint_option, restore_checkpoint_option, region_option, skip_instr_option)
+                           ->check(CLI::ExistingFile);
+  app.add_option("--jobs", batch_threads, "The number of simulations from --batch to run at once")->needs(batch_option)->check(CLI::PositiveNumber);
+
+  auto* decoder_threads_option =
+      app.add_option("--decoder-threads", decoder_threads,
+                     "The number of threads each trace may use to decompress itself, if it is in a format that can be decoded in parallel, such as a "
+                     "multi-block xz file. By default, the hardware threads not used for simulation or for reading the traces are divided among the traces.")
+          ->check(CLI::PositiveNumber);
 
   CLI11_PARSE(app, argc, argv);
 
+  const bool batch_given = batch_option->count() > 0;
+  std::vector<champsim::batch_job> jobs;
+  if (batch_given) {
+    std::ifstream batch_file{batch_file_name};
+    jobs = champsim::read_batch_jobs(batch_file);
+  }
+
+  if (decoder_threads_option->count() == 0) {
+    // Each trace that is read on a thread of its own takes one hardware thread, and the decoders divide the rest
+    const std::size_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    std::size_t simulating_threads = parallel.threads;
+    std::size_t reading_threads = 0;
+    std::size_t open_traces = 1;
+    if (batch_given) {
+      // The traces of a batch are all shared, so every one is read on a thread of its own
+      simulating_threads = std::min(batch_threads, std::size(jobs));
+      reading_threads = NUM_CPUS * simulating_threads;
+      open_traces = std::max<std::size_t>(reading_threads, 1);
+    } else {
+      auto is_shared = [&](const auto& name) { return std::count(std::begin(trace_names), std::end(trace_names), name) > 1; };
+      reading_threads = static_cast<std::size_t>(std::count_if(std::begin(trace_names), std::end(trace_names),
+                                                               [&](const auto& name) { return is_shared(name) || champsim::reads_asynchronously(name); }));
+      const std::set<std::string> distinct_traces{std::begin(trace_names), std::end(trace_names)};
+      open_traces = std::max<std::size_t>(std::size(distinct_traces), 1);
+    }
+    const std::size_t busy_threads = std::min(hardware_threads, simulating_threads + reading_threads);
+    decoder_threads = static_cast<unsigned>(std::max<std::size_t>((hardware_threads - busy_threads) / open_traces, 1));
+  }
+
+  if (batch_given) {
+    auto failures = champsim::run_batch(jobs, batch_threads, decoder_threads, [] { return std::make_unique<configured_environment>(); });
+    fmt::print("\nChampSim completed {} of {} simulations\n", std::size(jobs) - failures, std::size(jobs));
+    return failures > 0 ? 1 : 0;
+  }
+
+  if (traces_option->count() == 0) {
+    return app.exit(CLI::RequiredError{"traces"});
+  }
+
+  // A batch builds an environment for each of its jobs, so this one is only needed for a single simulation
+  configured_environment gen_environment{};
+  if (knob_hide_heartbeat) {
+    for (O3_CPU& cpu : gen_environment.cpu_view()) {
+      cpu.show_heartbeat = false;
+    }
+  }
+
   const bool warmup_given = (warmup_instr_option->count() > 0) || (deprec_warmup_instr_option->count() > 0);
   const bool simulation_given = (sim_instr_option->count() > 0) || (deprec_sim_instr_option->count() > 0);
 
@@ -104,23 +207,55 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     warmup_instructions = simulation_instructions / 5;
   }
 
+  // Copies of one trace, as in a rate-mode run, are decompressed once and shared between their cores. Each core still tags its
+  // instructions with its own address space.
+  champsim::shared_trace_registry registry{decoder_threads};
   std::vector<champsim::tracereader> traces;
-  std::transform(
-      std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
-      [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
+  bool any_shared = false;
+  for (std::size_t cpu = 0; cpu < std::size(trace_names); ++cpu) {
+    const auto& name = trace_names.at(cpu);
+    if (std::count(std::begin(trace_names), std::end(trace_names), name) > 1) {
+      traces.push_back(get_tracereader(registry.join(name, knob_cloudsuite, simulation_given), static_cast<uint8_t>(cpu), knob_cloudsuite));
+      any_shared = true;
+    } else {
+      traces.push_back(get_tracereader(name, static_cast<uint8_t>(cpu), knob_cloudsuite, simulation_given, decoder_threads));
+    }
+  }
+
+  // The readers of a shared trace skip together, so that the bytes between them need not be held
+  const auto skip_step = any_shared ? uint64_t{1} << 20 : static_cast<uint64_t>(skip_instructions);
+  for (auto remaining = static_cast<uint64_t>(skip_instructions); remaining > 0; remaining -= std::min(remaining, skip_step)) {
+    for (auto& trace : traces) {
+      trace.skip(std::min(remaining, skip_step));
+    }
+  }
+
+  checkpoints.skip_instructions = static_cast<uint64_t>(skip_instructions);
 
-  std::vector<champsim::phase_info> phases{
-      {champsim::phase_info{"Warmup", true, warmup_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names},
-       champsim::phase_info{"Simulation", false, simulation_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names}}};
+  auto phases = champsim::default_phases(warmup_instructions, simulation_instructions, trace_names);
 
-  for (auto& p : phases) {
-    std::iota(std::begin(p.trace_index), std::end(p.trace_index), 0);
+  const bool regions_given = region_option->count() > 0;
+  if (regions_given) {
+    std::ifstream region_file{region_file_name};
+    phases = champsim::region_phases(champsim::read_regions(region_file), warmup_instructions, trace_names);
+    simulation_instructions = std::accumulate(std::begin(phases), std::end(phases), 0LL,
+                                              [](auto acc, const auto& phase) { return phase.is_warmup ? acc : acc + phase.length; });
+  }
+
+  if (knob_functional_warmup) {
+    for (auto& p : phases) {
+      p.functional = p.is_warmup;
+    }
   }
 
   fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n",
-             phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
+             warmup_instructions, simulation_instructions, std::size(gen_environment.cpu_view()), PAGE_SIZE);
 
-  auto phase_stats = champsim::main(gen_environment, phases, traces);
+  auto phase_stats = champsim::main(gen_environment, phases, traces, parallel, checkpoints);
+
+  if (regions_given) {
+    phase_stats.push_back(champsim::weighted_phase_stats("Weighted", phase_stats));
+  }
 
   fmt::print("\nChampSim completed all CPUs\n\n");
 
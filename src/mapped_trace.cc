@@ -0,0 +1,104 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+champsim::mapped_trace::mapped_trace(const std::string& fname)
+{
+  auto fd = ::open(fname.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::system_error{errno, std::generic_category(), "Could not open trace " + fname};
+  }
+
+  struct stat file_stat {
+  };
+  if (::fstat(fd, &file_stat) != 0) {
+    auto err = errno;
+    ::close(fd);
+    throw std::system_error{err, std::generic_category(), "Could not read the size of trace " + fname};
+  }
+
+  size_ = static_cast<std::size_t>(file_stat.st_size);
+  if (size_ > 0) {
+    auto* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      auto err = errno;
+      ::close(fd);
+      throw std::system_error{err, std::generic_category(), "Could not map trace " + fname};
+    }
+
+    // The trace is read once, front to back, so the kernel should read ahead aggressively and may drop pages behind the reader
+    ::madvise(mapping, size_, MADV_SEQUENTIAL);
+    begin_ = static_cast<const char*>(mapping);
+  }
+
+  // The mapping holds its own reference to the file
+  ::close(fd);
+}
+
+champsim::mapped_trace::~mapped_trace()
+{
+  if (begin_ != nullptr) {
+    ::munmap(const_cast<char*>(begin_), size_); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+  }
+}
+
+champsim::mapped_trace::mapped_trace(mapped_trace&& other) noexcept
+    : begin_(std::exchange(other.begin_, nullptr)), size_(std::exchange(other.size_, 0)), position(std::exchange(other.position, 0)), gcount_(other.gcount_),
+      eof_(other.eof_)
+{
+}
+
+auto champsim::mapped_trace::operator=(mapped_trace&& other) noexcept -> mapped_trace&
+{
+  if (this != &other) {
+    if (begin_ != nullptr) {
+      ::munmap(const_cast<char*>(begin_), size_); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    }
+    begin_ = std::exchange(other.begin_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    position = std::exchange(other.position, 0);
+    gcount_ = other.gcount_;
+    eof_ = other.eof_;
+  }
+  return *this;
+}
+
+auto champsim::mapped_trace::take(std::size_t count) -> std::pair<const char*, const char*>
+{
+  auto taken = std::min(count, size_ - position);
+  std::pair<const char*, const char*> retval{begin_ + position, begin_ + position + taken}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  position += taken;
+  gcount_ = static_cast<std::streamsize>(taken);
+  eof_ = (position == size_);
+  return retval;
+}
+
+auto champsim::mapped_trace::read(char* s, std::streamsize count) -> mapped_trace&
+{
+  auto [first, last] = take(static_cast<std::size_t>(count));
+  std::copy(first, last, s);
+  return *this;
+}
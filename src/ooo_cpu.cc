@@ -34,6 +34,45 @@ std::chrono::seconds elapsed_time();
 
 constexpr long long STAT_PRINTING_PERIOD = 10000000;
 
+namespace
+{
+void insert_in_program_order(std::vector<uint64_t>& rob_positions, uint64_t rob_position)
+{
+  rob_positions.insert(std::upper_bound(std::begin(rob_positions), std::end(rob_positions), rob_position), rob_position);
+}
+
+bool sources_are_valid(const ooo_model_instr& instr, const RegisterAllocator& alloc)
+{
+  return std::all_of(std::begin(instr.source_registers), std::end(instr.source_registers), [&alloc](auto srcreg) { return alloc.isValid(srcreg); });
+}
+
+/*
+ * Call the function on each ROB entry that the scheduler considers in this cycle, in program order. The window ends at the first
+ * entry whose registers cannot be renamed, or after the scheduler has seen its size in entries that have not executed.
+ *
+ * Both schedule_instruction() and next_event_time() walk the window through this function, so that they agree on its bounds.
+ */
+template <typename It, typename F>
+void for_each_in_schedule_window(It begin, It end, const RegisterAllocator& alloc, champsim::bandwidth::maximum_type scheduler_size, F&& func)
+{
+  champsim::bandwidth search_bw{scheduler_size};
+  for (auto rob_it = begin; rob_it != end && search_bw.has_remaining(); ++rob_it) {
+    // if there aren't enough physical registers available for the next instruction, stop scheduling
+    unsigned long sources_to_allocate =
+        std::count_if(rob_it->source_registers.begin(), rob_it->source_registers.end(), [&alloc](auto srcreg) { return !alloc.isAllocated(srcreg); });
+    if (alloc.count_free_registers() < (sources_to_allocate + rob_it->destination_registers.size())) {
+      break;
+    }
+
+    func(rob_it);
+
+    if (!rob_it->executed) {
+      search_bw.consume();
+    }
+  }
+}
+} // namespace
+
 long O3_CPU::operate()
 {
   long progress{0};
@@ -78,6 +117,34 @@ void O3_CPU::initialize()
   impl_initialize_btb();
 }
 
+void O3_CPU::checkpoint(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, num_retired);
+  champsim::msl::checkpoint(stream, DIB);
+  champsim::msl::checkpoint_block(stream, "branch_predictor", [this](std::ostream& module_stream) { impl_checkpoint_branch_predictor(module_stream); });
+  champsim::msl::checkpoint_block(stream, "btb", [this](std::ostream& module_stream) { impl_checkpoint_btb(module_stream); });
+}
+
+void O3_CPU::restore(std::istream& stream)
+{
+  champsim::msl::restore(stream, num_retired);
+  last_heartbeat_instr = num_retired;
+  champsim::msl::restore(stream, DIB);
+
+  // Modules that have changed since the checkpoint was taken start cold
+  bool bp_restored = false;
+  champsim::msl::restore_block(stream, "branch_predictor", [&](std::istream& module_stream) { bp_restored = impl_restore_branch_predictor(module_stream); });
+  if (!bp_restored) {
+    fmt::print("[CPU {}] WARNING: the checkpoint does not match the branch predictor, which will start cold\n", cpu);
+  }
+
+  bool btb_restored = false;
+  champsim::msl::restore_block(stream, "btb", [&](std::istream& module_stream) { btb_restored = impl_restore_btb(module_stream); });
+  if (!btb_restored) {
+    fmt::print("[CPU {}] WARNING: the checkpoint does not match the BTB, which will start cold\n", cpu);
+  }
+}
+
 void O3_CPU::begin_phase()
 {
   begin_phase_instr = num_retired;
@@ -105,6 +172,96 @@ void O3_CPU::end_phase(unsigned finished_cpu)
   }
 }
 
+champsim::chrono::clock::time_point O3_CPU::next_event_time() const
+{
+  const auto next_cycle = current_time + clock_period;
+
+  // Memory returns, retirement, and instructions waiting on the DIB or on a fetch slot are handled in the next cycle
+  auto needs_fetch = [](const ooo_model_instr& x) {
+    return !x.dib_checked || !x.fetch_issued;
+  };
+  if (!std::empty(L1I_bus.lower_level->returned) || !std::empty(L1D_bus.lower_level->returned) || (!std::empty(ROB) && ROB.front().completed)
+      || std::any_of(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), needs_fetch)) {
+    return next_cycle;
+  }
+
+  auto next_event = champsim::chrono::clock::time_point::max();
+  auto wait_for = [&next_event](champsim::chrono::clock::time_point t) {
+    next_event = std::min(next_event, t);
+  };
+
+  // initialize_instruction()
+  if (!std::empty(input_queue) && std::size(IFETCH_BUFFER) < IFETCH_BUFFER_SIZE) {
+    wait_for(fetch_resume_time);
+  }
+
+  // promote_to_decode()
+  if (!std::empty(IFETCH_BUFFER) && IFETCH_BUFFER.front().fetch_completed && std::size(DIB_HIT_BUFFER) < DIB_HIT_BUFFER_SIZE
+      && std::size(DECODE_BUFFER) < DECODE_BUFFER_SIZE) {
+    wait_for(IFETCH_BUFFER.front().ready_time);
+  }
+
+  // decode_instruction()
+  if (std::size(DISPATCH_BUFFER) < DISPATCH_BUFFER_SIZE) {
+    if (!std::empty(DIB_HIT_BUFFER)) {
+      wait_for(DIB_HIT_BUFFER.front().ready_time);
+    }
+    if (!std::empty(DECODE_BUFFER)) {
+      wait_for(DECODE_BUFFER.front().ready_time);
+    }
+  }
+
+  // dispatch_instruction()
+  if (!std::empty(DISPATCH_BUFFER) && std::size(ROB) != ROB_SIZE
+      && std::size(lq_free_entries) >= std::size(DISPATCH_BUFFER.front().source_memory)
+      && ((std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) <= SQ_SIZE)) {
+    wait_for(DISPATCH_BUFFER.front().ready_time);
+  }
+
+  // schedule_instruction()
+  for_each_in_schedule_window(std::cbegin(ROB), std::cend(ROB), reg_allocator, SCHEDULER_SIZE, [wait_for](auto rob_it) {
+    if (!rob_it->scheduled) {
+      wait_for(rob_it->ready_time);
+    }
+  });
+
+  // execute_instruction()
+  for (auto rob_position : ready_to_execute) {
+    auto rob_entry = ROB.find_position(rob_position);
+    if (rob_entry != std::end(ROB) && !rob_entry->executed && sources_are_valid(*rob_entry, reg_allocator)) {
+      wait_for(rob_entry->ready_time);
+    }
+  }
+
+  // complete_inflight_instruction()
+  for (auto rob_position : executing) {
+    auto rob_entry = ROB.find_position(rob_position);
+    bool can_complete = rob_entry != std::end(ROB) && !rob_entry->completed && rob_entry->completed_mem_ops == rob_entry->num_mem_ops();
+    if (can_complete) {
+      wait_for(rob_entry->ready_time);
+    }
+  }
+
+  // operate_lsq()
+  auto unfetched_begin = std::partition_point(std::begin(SQ), std::end(SQ), [](const auto& x) { return x.fetch_issued; });
+  if (unfetched_begin != std::end(SQ)) {
+    wait_for(unfetched_begin->ready_time);
+  }
+  const auto complete_id = std::empty(ROB) ? std::numeric_limits<uint64_t>::max() : ROB.front().instr_id;
+  if (!std::empty(SQ) && LSQ_ENTRY::precedes(complete_id)(SQ.front())) {
+    wait_for(SQ.front().ready_time);
+  }
+  for (const auto& lq_entry : LQ) {
+    if (lq_entry.has_value() && lq_entry->producer_id == std::numeric_limits<uint64_t>::max() && !lq_entry->fetch_issued
+        && lq_entry->ready_time != champsim::chrono::clock::time_point::max()) {
+      // Loads issue strictly after their ready time
+      wait_for(lq_entry->ready_time + champsim::chrono::clock::duration{1});
+    }
+  }
+
+  return std::max(next_event, next_cycle);
+}
+
 void O3_CPU::initialize_instruction()
 {
   champsim::bandwidth instrs_to_read_this_cycle{
@@ -266,7 +423,7 @@ long O3_CPU::fetch_instruction()
   return progress;
 }
 
-bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end)
+bool O3_CPU::do_fetch_instruction(champsim::circular_buffer<ooo_model_instr>::iterator begin, champsim::circular_buffer<ooo_model_instr>::iterator end)
 {
   CacheBus::request_type fetch_packet;
   fetch_packet.v_address = begin->ip;
@@ -411,8 +568,7 @@ long O3_CPU::dispatch_instruction()
   // dispatch DISPATCH_WIDTH instructions into the ROB
   while (available_dispatch_bandwidth.has_remaining() && !std::empty(DISPATCH_BUFFER) && DISPATCH_BUFFER.front().ready_time <= current_time
          && std::size(ROB) != ROB_SIZE
-         && ((std::size_t)std::count_if(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return !lq_entry.has_value(); })
-             >= std::size(DISPATCH_BUFFER.front().source_memory))
+         && std::size(lq_free_entries) >= std::size(DISPATCH_BUFFER.front().source_memory)
          && ((std::size(DISPATCH_BUFFER.front().destination_memory) + std::size(SQ)) <= SQ_SIZE)) {
     ROB.push_back(std::move(DISPATCH_BUFFER.front()));
     DISPATCH_BUFFER.pop_front();
@@ -427,29 +583,18 @@ long O3_CPU::dispatch_instruction()
 
 long O3_CPU::schedule_instruction()
 {
-  champsim::bandwidth search_bw{SCHEDULER_SIZE};
   int progress{0};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && search_bw.has_remaining(); ++rob_it) {
-    // if there aren't enough physical registers available for the next instruction, stop scheduling
-    unsigned long sources_to_allocate = std::count_if(rob_it->source_registers.begin(), rob_it->source_registers.end(),
-                                                      [&alloc = std::as_const(reg_allocator)](auto srcreg) { return !alloc.isAllocated(srcreg); });
-    if (reg_allocator.count_free_registers() < (sources_to_allocate + rob_it->destination_registers.size())) {
-      break;
-    }
+  for_each_in_schedule_window(std::begin(ROB), std::end(ROB), reg_allocator, SCHEDULER_SIZE, [this, &progress](auto rob_it) {
     if (!rob_it->scheduled && rob_it->ready_time <= current_time) {
-      do_scheduling(*rob_it);
+      do_scheduling(*rob_it, ROB.position_of(rob_it));
       ++progress;
     }
-
-    if (!rob_it->executed) {
-      search_bw.consume();
-    }
-  }
+  });
 
   return progress;
 }
 
-void O3_CPU::do_scheduling(ooo_model_instr& instr)
+void O3_CPU::do_scheduling(ooo_model_instr& instr, uint64_t rob_position)
 {
   // Mark register dependencies
   for (auto& src_reg : instr.source_registers) {
@@ -460,6 +605,23 @@ void O3_CPU::do_scheduling(ooo_model_instr& instr)
   for (auto& dreg : instr.destination_registers) {
     // rename destination register
     dreg = reg_allocator.rename_dest_register(dreg, instr.instr_id);
+    register_producer.at(static_cast<std::size_t>(dreg)) = rob_position;
+  }
+
+  // Ask the producers of the sources that are not yet valid to wake this instruction
+  instr.num_reg_dependent = 0;
+  for (auto src_reg : instr.source_registers) {
+    if (!reg_allocator.isValid(src_reg)) {
+      auto producer = ROB.find_position(register_producer.at(static_cast<std::size_t>(src_reg)));
+      if (producer != std::end(ROB) && !producer->completed) {
+        producer->registers_instrs_depend_on_me.push_back(rob_position);
+        ++instr.num_reg_dependent;
+      }
+    }
+  }
+
+  if (instr.num_reg_dependent == 0) {
+    insert_in_program_order(ready_to_execute, rob_position);
   }
 
   instr.scheduled = true;
@@ -468,14 +630,21 @@ void O3_CPU::do_scheduling(ooo_model_instr& instr)
 long O3_CPU::execute_instruction()
 {
   champsim::bandwidth exec_bw{EXEC_WIDTH};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && exec_bw.has_remaining(); ++rob_it) {
-    if (rob_it->scheduled && !rob_it->executed && rob_it->ready_time <= current_time) {
-      bool ready = std::all_of(std::begin(rob_it->source_registers), std::end(rob_it->source_registers),
-                               [&alloc = std::as_const(reg_allocator)](auto srcreg) { return alloc.isValid(srcreg); });
-      if (ready) {
-        do_execution(*rob_it);
-        exec_bw.consume();
-      }
+  for (auto ready_it = std::begin(ready_to_execute); ready_it != std::end(ready_to_execute) && exec_bw.has_remaining();) {
+    auto rob_it = ROB.find_position(*ready_it);
+    if (rob_it == std::end(ROB) || rob_it->executed) {
+      ready_it = ready_to_execute.erase(ready_it);
+      continue;
+    }
+
+    // Sources whose producers could not be found when scheduling are checked here
+    if (rob_it->ready_time <= current_time && sources_are_valid(*rob_it, reg_allocator)) {
+      do_execution(*rob_it);
+      insert_in_program_order(executing, *ready_it);
+      exec_bw.consume();
+      ready_it = ready_to_execute.erase(ready_it);
+    } else {
+      ++ready_it;
     }
   }
 
@@ -487,18 +656,18 @@ void O3_CPU::do_execution(ooo_model_instr& instr)
   instr.executed = true;
   instr.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
 
-  // Mark LQ entries as ready to translate
-  for (auto& lq_entry : LQ) {
+  // Mark LQ entries as ready to translate. The entry of a load that was forwarded from a store may have been given to another instruction.
+  for (auto lq_index : instr.lq_entries) {
+    auto& lq_entry = LQ.at(lq_index);
     if (lq_entry.has_value() && lq_entry->instr_id == instr.instr_id) {
       lq_entry->ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
     }
   }
 
-  // Mark SQ entries as ready to translate
-  for (auto& sq_entry : SQ) {
-    if (sq_entry.instr_id == instr.instr_id) {
-      sq_entry.ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
-    }
+  // Mark SQ entries as ready to translate. The stores of an instruction are adjacent in the SQ.
+  auto sq_it = SQ.find_position(instr.sq_position);
+  for (std::size_t i = 0; i < std::size(instr.destination_memory) && sq_it != std::end(SQ) && sq_it->instr_id == instr.instr_id; ++i, ++sq_it) {
+    sq_it->ready_time = current_time + (warmup ? champsim::chrono::clock::duration{} : EXEC_LATENCY);
   }
 
   if constexpr (champsim::debug_print) {
@@ -508,20 +677,33 @@ void O3_CPU::do_execution(ooo_model_instr& instr)
 
 void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
 {
+  // The instruction has just been placed at the back of the ROB
+  const auto rob_position = std::empty(ROB) ? std::numeric_limits<uint64_t>::max() : ROB.position_of(std::prev(std::cend(ROB)));
+
   // load
+  instr.lq_entries.clear();
   for (auto& smem : instr.source_memory) {
-    auto q_entry = std::find_if_not(std::begin(LQ), std::end(LQ), [](const auto& lq_entry) { return lq_entry.has_value(); });
-    assert(q_entry != std::end(LQ));
+    assert(!std::empty(lq_free_entries));
+    auto lq_index = lq_free_entries.top();
+    lq_free_entries.pop();
+    auto q_entry = std::next(std::begin(LQ), static_cast<long>(lq_index));
     q_entry->emplace(smem, instr.instr_id, instr.ip, instr.asid); // add it to the load queue
-
-    // Check for forwarding
-    auto sq_it = std::max_element(std::begin(SQ), std::end(SQ), [smem](const auto& lhs, const auto& rhs) {
-      return lhs.virtual_address != smem || (rhs.virtual_address == smem && LSQ_ENTRY::program_order(lhs, rhs));
-    });
-    if (sq_it != std::end(SQ) && sq_it->virtual_address == smem) {
+    (*q_entry)->rob_position = rob_position;
+
+    // Check for forwarding from the youngest prior store to the same address.
+    // The trace gives the address of each access but not its size, so a store elsewhere in the same word may not write the bytes the load reads.
+    auto sq_it = std::end(SQ);
+    if (auto found = sq_forwarding_table.find(smem.to<uint64_t>()); found != std::end(sq_forwarding_table)) {
+      // If the youngest instruction stores to this address more than once, forward from its first store
+      auto youngest_id = SQ.find_position(found->second.back())->instr_id;
+      auto first_of_youngest = std::find_if(std::rbegin(found->second), std::rend(found->second),
+                                            [&](auto position) { return SQ.find_position(position)->instr_id != youngest_id; });
+      sq_it = SQ.find_position(*first_of_youngest.base());
+    }
+    if (sq_it != std::end(SQ)) {
       if (sq_it->fetch_issued) { // Store already executed
         (*q_entry)->finish(instr);
-        q_entry->reset();
+        do_release_load(*q_entry);
       } else {
         assert(sq_it->instr_id < instr.instr_id);      // The found SQ entry is a prior store
         sq_it->lq_depend_on_me.emplace_back(*q_entry); // Forward the load when the store finishes
@@ -532,11 +714,17 @@ void O3_CPU::do_memory_scheduling(ooo_model_instr& instr)
         }
       }
     }
+
+    if (q_entry->has_value()) {
+      instr.lq_entries.push_back(lq_index);
+    }
   }
 
   // store
+  instr.sq_position = SQ.position_of(std::cend(SQ));
   for (auto& dmem : instr.destination_memory) {
-    SQ.emplace_back(dmem, instr.instr_id, instr.ip, instr.asid); // add it to the store queue
+    sq_forwarding_table[dmem.to<uint64_t>()].push_back(SQ.position_of(std::cend(SQ)));
+    SQ.emplace_back(dmem, instr.instr_id, instr.ip, instr.asid).rob_position = rob_position; // add it to the store queue
   }
 
   if constexpr (champsim::debug_print) {
@@ -566,6 +754,15 @@ long O3_CPU::operate_lsq()
 
   auto [complete_begin, complete_end] = champsim::get_span_p(std::cbegin(SQ), std::cend(SQ), store_bw, do_complete);
   store_bw.consume(std::distance(complete_begin, complete_end));
+  for (auto sq_it = complete_begin; sq_it != complete_end; ++sq_it) {
+    // Stores leave the SQ oldest first, so each is the oldest of its address
+    auto found = sq_forwarding_table.find(sq_it->virtual_address.to<uint64_t>());
+    assert(found != std::end(sq_forwarding_table) && found->second.front() == SQ.position_of(sq_it));
+    found->second.erase(std::begin(found->second));
+    if (std::empty(found->second)) {
+      sq_forwarding_table.erase(found);
+    }
+  }
   SQ.erase(complete_begin, complete_end);
 
   champsim::bandwidth load_bw{LQ_WIDTH};
@@ -577,6 +774,7 @@ long O3_CPU::operate_lsq()
       if (success) {
         load_bw.consume();
         lq_entry->fetch_issued = true;
+        lq_issued_entries.emplace(champsim::block_number{lq_entry->virtual_address}, static_cast<std::size_t>(std::distance(std::data(LQ), &lq_entry)));
       }
     }
   }
@@ -584,21 +782,27 @@ long O3_CPU::operate_lsq()
   return store_bw.amount_consumed() + load_bw.amount_consumed();
 }
 
+void O3_CPU::do_release_load(std::optional<LSQ_ENTRY>& lq_entry)
+{
+  lq_entry.reset();
+  lq_free_entries.push(static_cast<std::size_t>(std::distance(std::data(LQ), &lq_entry)));
+}
+
 void O3_CPU::do_finish_store(const LSQ_ENTRY& sq_entry)
 {
   if constexpr (champsim::debug_print) {
     fmt::print("[SQ] {} instr_id: {} vaddr: {}\n", __func__, sq_entry.instr_id, sq_entry.virtual_address);
   }
 
-  sq_entry.finish(std::begin(ROB), std::end(ROB));
+  sq_entry.finish(ROB);
 
   // Release dependent loads
   for (std::optional<LSQ_ENTRY>& dependent : sq_entry.lq_depend_on_me) {
     assert(dependent.has_value()); // LQ entry is still allocated
     assert(dependent->producer_id == sq_entry.instr_id);
 
-    dependent->finish(std::begin(ROB), std::end(ROB));
-    dependent.reset();
+    dependent->finish(ROB);
+    do_release_load(dependent);
   }
 }
 
@@ -638,20 +842,40 @@ void O3_CPU::do_complete_execution(ooo_model_instr& instr)
   }
 
   instr.completed = true;
+  do_wakeup(instr);
 
   if (instr.branch_mispredicted) {
     fetch_resume_time = current_time + BRANCH_MISPREDICT_PENALTY;
   }
 }
 
+void O3_CPU::do_wakeup(const ooo_model_instr& producer)
+{
+  for (auto consumer_position : producer.registers_instrs_depend_on_me) {
+    auto consumer = ROB.find_position(consumer_position);
+    if (consumer != std::end(ROB) && --consumer->num_reg_dependent == 0) {
+      insert_in_program_order(ready_to_execute, consumer_position);
+    }
+  }
+}
+
 long O3_CPU::complete_inflight_instruction()
 {
   // update ROB entries with completed executions
   champsim::bandwidth complete_bw{EXEC_WIDTH};
-  for (auto rob_it = std::begin(ROB); rob_it != std::end(ROB) && complete_bw.has_remaining(); ++rob_it) {
-    if (rob_it->executed && !rob_it->completed && (rob_it->ready_time <= current_time) && rob_it->completed_mem_ops == rob_it->num_mem_ops()) {
+  for (auto exec_it = std::begin(executing); exec_it != std::end(executing) && complete_bw.has_remaining();) {
+    auto rob_it = ROB.find_position(*exec_it);
+    if (rob_it == std::end(ROB) || rob_it->completed) {
+      exec_it = executing.erase(exec_it);
+      continue;
+    }
+
+    if ((rob_it->ready_time <= current_time) && rob_it->completed_mem_ops == rob_it->num_mem_ops()) {
       do_complete_execution(*rob_it);
       complete_bw.consume();
+      exec_it = executing.erase(exec_it);
+    } else {
+      ++exec_it;
     }
   }
 
@@ -690,13 +914,15 @@ long O3_CPU::handle_memory_return()
 
   auto l1d_it = std::begin(L1D_bus.lower_level->returned);
   for (champsim::bandwidth l1d_bw{L1D_BANDWIDTH}; l1d_bw.has_remaining() && l1d_it != std::end(L1D_bus.lower_level->returned); l1d_bw.consume(), ++l1d_it) {
-    for (auto& lq_entry : LQ) {
-      if (lq_entry.has_value() && lq_entry->fetch_issued && champsim::block_number{lq_entry->virtual_address} == champsim::block_number{l1d_it->v_address}) {
-        lq_entry->finish(std::begin(ROB), std::end(ROB));
-        lq_entry.reset();
-        ++progress;
-      }
+    auto [issued_begin, issued_end] = lq_issued_entries.equal_range(champsim::block_number{l1d_it->v_address});
+    for (auto issued_it = issued_begin; issued_it != issued_end; ++issued_it) {
+      auto& lq_entry = LQ.at(issued_it->second);
+      assert(lq_entry.has_value() && lq_entry->fetch_issued);
+      lq_entry->finish(ROB);
+      do_release_load(lq_entry);
+      ++progress;
     }
+    lq_issued_entries.erase(issued_begin, issued_end);
     ++progress;
   }
   L1D_bus.lower_level->returned.erase(std::begin(L1D_bus.lower_level->returned), l1d_it);
@@ -730,6 +956,54 @@ long O3_CPU::retire_rob()
   return retire_count;
 }
 
+void O3_CPU::functional_operate(ooo_model_instr instr, const champsim::functional_forward_type& forward)
+{
+  do_predict_branch(instr);
+
+  // Fetch the instruction if it would not have been found in the DIB
+  if (!DIB.check_hit(instr.ip).has_value()) {
+    CacheBus::request_type fetch_packet;
+    fetch_packet.v_address = instr.ip;
+    fetch_packet.instr_id = instr.instr_id;
+    fetch_packet.ip = instr.ip;
+    fetch_packet.address = fetch_packet.v_address;
+    fetch_packet.is_translated = false;
+    fetch_packet.cpu = cpu;
+    fetch_packet.type = access_type::LOAD;
+    forward(L1I_bus.lower_level, fetch_packet);
+  }
+  do_dib_update(instr);
+
+  for (auto smem : instr.source_memory) {
+    CacheBus::request_type data_packet;
+    data_packet.v_address = smem;
+    data_packet.instr_id = instr.instr_id;
+    data_packet.ip = instr.ip;
+    data_packet.address = data_packet.v_address;
+    data_packet.is_translated = false;
+    data_packet.cpu = cpu;
+    data_packet.type = access_type::LOAD;
+    forward(L1D_bus.lower_level, data_packet);
+  }
+
+  for (auto dmem : instr.destination_memory) {
+    CacheBus::request_type data_packet;
+    data_packet.v_address = dmem;
+    data_packet.instr_id = instr.instr_id;
+    data_packet.ip = instr.ip;
+    data_packet.address = data_packet.v_address;
+    data_packet.is_translated = false;
+    data_packet.cpu = cpu;
+    data_packet.type = access_type::WRITE;
+    data_packet.response_requested = false;
+    forward(L1D_bus.lower_level, data_packet);
+  }
+
+  ++num_retired;
+}
+
+std::array<champsim::channel*, 2> O3_CPU::lower_levels() const { return {L1I_bus.lower_level, L1D_bus.lower_level}; }
+
 void O3_CPU::impl_initialize_branch_predictor() const { branch_module_pimpl->impl_initialize_branch_predictor(); }
 
 void O3_CPU::impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
@@ -754,6 +1028,14 @@ std::pair<champsim::address, bool> O3_CPU::impl_btb_prediction(champsim::address
   return btb_module_pimpl->impl_btb_prediction(ip, branch_type);
 }
 
+void O3_CPU::impl_checkpoint_branch_predictor(std::ostream& stream) const { branch_module_pimpl->impl_checkpoint_branch_predictor(stream); }
+
+bool O3_CPU::impl_restore_branch_predictor(std::istream& stream) const { return branch_module_pimpl->impl_restore_branch_predictor(stream); }
+
+void O3_CPU::impl_checkpoint_btb(std::ostream& stream) const { btb_module_pimpl->impl_checkpoint_btb(stream); }
+
+bool O3_CPU::impl_restore_btb(std::istream& stream) const { return btb_module_pimpl->impl_restore_btb(stream); }
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void O3_CPU::print_deadlock()
 {
@@ -807,10 +1089,10 @@ LSQ_ENTRY::LSQ_ENTRY(champsim::address addr, champsim::program_ordered<LSQ_ENTRY
 {
 }
 
-void LSQ_ENTRY::finish(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end) const
+void LSQ_ENTRY::finish(champsim::circular_buffer<ooo_model_instr>& rob) const
 {
-  auto rob_entry = std::partition_point(begin, end, ooo_model_instr::precedes(this->instr_id));
-  assert(rob_entry != end);
+  auto rob_entry = rob.find_position(rob_position);
+  assert(rob_entry != std::end(rob) && rob_entry->instr_id == this->instr_id);
   finish(*rob_entry);
 }
 
@@ -16,6 +16,9 @@
 
 #include "operable.h"
 
+#include <algorithm>
+#include <tuple>
+
 champsim::operable::operable() : operable(champsim::chrono::picoseconds{1}) {}
 
 champsim::operable::operable(champsim::chrono::picoseconds clock_period_) : clock_period(clock_period_) {}
@@ -36,4 +39,66 @@ long champsim::operable::_operate()
   return operate();
 }
 
+void champsim::operable::skip_on(const champsim::chrono::clock& clock)
+{
+  if (current_time < clock.now()) {
+    // Round up, so that the local clock lands where operate_on() would have left it
+    _skip((clock.now() - current_time + clock_period - champsim::chrono::clock::duration{1}) / clock_period);
+  }
+}
+
+void champsim::operable::_skip(long cycles)
+{
+  current_time += cycles * clock_period;
+  skip_cycles(cycles);
+}
+
+auto champsim::operable::next_event_time() const -> champsim::chrono::clock::time_point { return current_time + clock_period; }
+
 uint64_t champsim::operable::current_cycle() const { return static_cast<uint64_t>(current_time.time_since_epoch() / clock_period); }
+
+champsim::operable_schedule::operable_schedule(const std::vector<std::reference_wrapper<operable>>& operables) : num_operables(std::size(operables))
+{
+  for (std::size_t i = 0; i < std::size(operables); ++i) {
+    operable& op = operables[i];
+    auto domain = std::find_if(std::begin(domains), std::end(domains), [period = op.clock_period](const auto& x) { return x.clock_period == period; });
+    if (domain == std::end(domains)) {
+      domain = domains.insert(std::end(domains), clock_domain{op.clock_period});
+    }
+    domain->members.push_back({i, std::ref(op)});
+  }
+
+  order.reserve(num_operables);
+}
+
+auto champsim::operable_schedule::sorted() -> const std::vector<std::reference_wrapper<operable>>&
+{
+  auto precedes = [](const entry& lhs, const entry& rhs) {
+    return std::tie(lhs.op.get().current_time, lhs.index) < std::tie(rhs.op.get().current_time, rhs.index);
+  };
+
+  // Members of a clock domain advance in lockstep, so they are almost always still in order
+  for (auto& domain : domains) {
+    if (!std::is_sorted(std::begin(domain.members), std::end(domain.members), precedes)) {
+      for (auto it = std::begin(domain.members); it != std::end(domain.members); ++it) {
+        std::rotate(std::upper_bound(std::begin(domain.members), it, *it, precedes), it, std::next(it));
+      }
+    }
+    domain.next = std::cbegin(domain.members);
+  }
+
+  // Merge the domains
+  order.clear();
+  while (std::size(order) < num_operables) {
+    auto domain = std::min_element(std::begin(domains), std::end(domains), [precedes](const auto& lhs, const auto& rhs) {
+      if (rhs.next == std::cend(rhs.members)) {
+        return lhs.next != std::cend(lhs.members);
+      }
+      return lhs.next != std::cend(lhs.members) && precedes(*lhs.next, *rhs.next);
+    });
+    order.push_back(domain->next->op);
+    ++domain->next;
+  }
+
+  return order;
+}
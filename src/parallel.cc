@@ -0,0 +1,157 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "environment.h"
+
+auto champsim::partition_operables(environment& env) -> operable_partition
+{
+  // Find the operable that services each channel, and the channels that each operable sends to
+  std::map<const champsim::channel*, const operable*> consumers;
+  std::map<const operable*, std::vector<const champsim::channel*>> producers;
+  std::set<const operable*> walkers;
+
+  for (const CACHE& cache : env.cache_view()) {
+    for (const auto* ul : cache.upper_levels) {
+      consumers.insert_or_assign(ul, &cache);
+    }
+    producers[&cache].push_back(cache.lower_level);
+    if (cache.lower_translate != nullptr) {
+      producers[&cache].push_back(cache.lower_translate);
+    }
+  }
+
+  // Page table walkers are left out of the graph, since they are always shared
+  for (const PageTableWalker& ptw : env.ptw_view()) {
+    walkers.insert(&ptw);
+  }
+
+  // Walk down from each core, recording which cores reach each operable
+  auto cpus = env.cpu_view();
+  std::map<const operable*, std::vector<std::size_t>> reached_from;
+  for (std::size_t i = 0; i < std::size(cpus); ++i) {
+    const O3_CPU& cpu = cpus[i];
+    auto lower = cpu.lower_levels();
+    std::vector<const champsim::channel*> to_visit{std::begin(lower), std::end(lower)};
+    std::set<const operable*> visited{&cpu};
+    reached_from[&cpu].push_back(i);
+
+    while (!std::empty(to_visit)) {
+      auto consumer = consumers.find(to_visit.back());
+      to_visit.pop_back();
+      if (consumer != std::end(consumers) && visited.insert(consumer->second).second) {
+        reached_from[consumer->second].push_back(i);
+        auto sent = producers.find(consumer->second);
+        if (sent != std::end(producers)) {
+          to_visit.insert(std::end(to_visit), std::begin(sent->second), std::end(sent->second));
+        }
+      }
+    }
+  }
+
+  operable_partition retval;
+  retval.private_groups.resize(std::size(cpus));
+  for (operable& op : env.operable_view()) {
+    auto found = reached_from.find(&op);
+    if (found != std::end(reached_from) && std::size(found->second) == 1 && walkers.count(&op) == 0) {
+      retval.private_groups.at(found->second.front()).push_back(std::ref(op));
+    } else {
+      retval.shared.push_back(std::ref(op));
+    }
+  }
+
+  return retval;
+}
+
+champsim::worker_pool::worker_pool(std::size_t num_threads)
+{
+  // The calling thread is one of the workers
+  for (std::size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back([this] { this->work(); });
+  }
+}
+
+champsim::worker_pool::~worker_pool()
+{
+  {
+    std::lock_guard lock{mutex};
+    stopping = true;
+  }
+  work_available.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void champsim::worker_pool::work()
+{
+  std::unique_lock lock{mutex};
+  decltype(generation) seen_generation = 0;
+  while (true) {
+    work_available.wait(lock, [this, seen_generation] { return stopping || generation != seen_generation; });
+    if (stopping) {
+      return;
+    }
+    seen_generation = generation;
+    drain(lock);
+  }
+}
+
+void champsim::worker_pool::drain(std::unique_lock<std::mutex>& lock)
+{
+  while (next_job < num_jobs) {
+    auto job = next_job++;
+    lock.unlock();
+    std::exception_ptr job_failure{};
+    try {
+      current_job(job);
+    } catch (...) {
+      job_failure = std::current_exception();
+    }
+    lock.lock();
+
+    if (job_failure && !failure) {
+      failure = job_failure;
+    }
+    if (--jobs_remaining == 0) {
+      work_finished.notify_all();
+    }
+  }
+}
+
+void champsim::worker_pool::run(std::size_t count, std::function<void(std::size_t)> job)
+{
+  std::unique_lock lock{mutex};
+  current_job = std::move(job);
+  num_jobs = count;
+  next_job = 0;
+  jobs_remaining = count;
+  failure = nullptr;
+  ++generation;
+  work_available.notify_all();
+
+  drain(lock);
+  work_finished.wait(lock, [this] { return jobs_remaining == 0; });
+
+  if (failure) {
+    std::rethrow_exception(failure);
+  }
+}
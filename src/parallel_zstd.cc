@@ -0,0 +1,188 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel_zstd.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+std::size_t frame_compressed_size(const char* begin, const char* end)
+{
+  auto size = ::ZSTD_findFrameCompressedSize(begin, static_cast<std::size_t>(std::distance(begin, end)));
+  if (::ZSTD_isError(size)) {
+    throw std::runtime_error{std::string{"Malformed Zstandard frame: "} + ::ZSTD_getErrorName(size)};
+  }
+  return size;
+}
+} // namespace
+
+champsim::parallel_zstd_istream::parallel_zstd_istream(const std::string& fname, std::size_t threads_) : file(fname), threads(threads_)
+{
+  std::tie(begin, end) = file.take(std::numeric_limits<std::size_t>::max());
+  next_frame = begin;
+
+  // The seek table is not decoded as a frame
+  frames = seekable_zstd::read_seek_table(begin, end);
+  if (!std::empty(frames)) {
+    end = std::next(begin, static_cast<long>(frames.back().compressed_offset));
+  }
+
+  launch();
+}
+
+void champsim::parallel_zstd_istream::seek(uint64_t offset)
+{
+  if (!seekable()) {
+    throw std::logic_error{"The trace has no seek table"};
+  }
+
+  // Find the frame holding the offset, or the end of the frames
+  auto frame = std::prev(std::upper_bound(std::begin(frames), std::end(frames), offset,
+                                          [](uint64_t off, const seekable_zstd::frame_location& loc) { return off < loc.decompressed_offset; }));
+
+  pending.clear();
+  stream.reset();
+  current.clear();
+  current_offset = 0;
+  eof_ = false;
+  next_frame = std::next(begin, static_cast<long>(frame->compressed_offset));
+  position = frame->decompressed_offset;
+  launch();
+
+  // Discard the beginning of the frame
+  discard(offset - frame->decompressed_offset);
+}
+
+uint64_t champsim::parallel_zstd_istream::skip(uint64_t count)
+{
+  gcount_ = 0;
+  if (seekable() && count > std::size(current) - current_offset) {
+    const auto start = position;
+    seek(std::min(position + count, frames.back().decompressed_offset));
+    return position - start;
+  }
+  return discard(count);
+}
+
+uint64_t champsim::parallel_zstd_istream::discard(uint64_t count)
+{
+  uint64_t discarded = 0;
+  while (discarded < count && !eof_) {
+    if (current_offset < std::size(current)) {
+      auto step = std::min<uint64_t>(count - discarded, std::size(current) - current_offset);
+      current_offset += step;
+      discarded += step;
+    } else if (frames_exhausted()) {
+      eof_ = true;
+    } else {
+      refill();
+    }
+  }
+  position += discarded;
+  return discarded;
+}
+
+bool champsim::parallel_zstd_istream::next_frame_is_parallel() const
+{
+  if (next_frame == end) {
+    return false;
+  }
+
+  auto frame_size = frame_compressed_size(next_frame, end);
+  auto content_size = ::ZSTD_getFrameContentSize(next_frame, frame_size);
+  return content_size != ZSTD_CONTENTSIZE_UNKNOWN && content_size != ZSTD_CONTENTSIZE_ERROR && content_size <= max_frame_size;
+}
+
+void champsim::parallel_zstd_istream::launch()
+{
+  // Frames are launched in order, stopping at the first that must be decoded on this thread
+  while (std::size(pending) < threads && next_frame_is_parallel()) {
+    auto frame_size = frame_compressed_size(next_frame, end);
+    auto content_size = static_cast<std::size_t>(::ZSTD_getFrameContentSize(next_frame, frame_size));
+    pending.push_back(std::async(std::launch::async, [frame = next_frame, frame_size, content_size] {
+      buffer_type decoded(content_size);
+      auto decoded_size = ::ZSTD_decompress(std::data(decoded), content_size, frame, frame_size);
+      if (::ZSTD_isError(decoded_size)) {
+        throw std::runtime_error{std::string{"Could not decode Zstandard frame: "} + ::ZSTD_getErrorName(decoded_size)};
+      }
+      decoded.resize(decoded_size);
+      return decoded;
+    }));
+    std::advance(next_frame, frame_size);
+  }
+}
+
+void champsim::parallel_zstd_istream::refill()
+{
+  current.clear();
+  current_offset = 0;
+
+  if (stream == nullptr && std::empty(pending)) {
+    launch();
+    if (std::empty(pending)) {
+      auto frame_size = frame_compressed_size(next_frame, end);
+      stream.reset(::ZSTD_createDCtx());
+      stream_input = ZSTD_inBuffer{next_frame, frame_size, 0};
+      std::advance(next_frame, frame_size);
+    }
+  }
+
+  if (!std::empty(pending)) {
+    current = pending.front().get();
+    pending.pop_front();
+    launch();
+    return;
+  }
+
+  current.resize(::ZSTD_DStreamOutSize());
+  ZSTD_outBuffer output{std::data(current), std::size(current), 0};
+  auto ret = ::ZSTD_decompressStream(stream.get(), &output, &stream_input);
+  if (::ZSTD_isError(ret)) {
+    throw std::runtime_error{std::string{"Could not decode Zstandard frame: "} + ::ZSTD_getErrorName(ret)};
+  }
+  current.resize(output.pos);
+
+  if (ret == 0) {
+    // The frame is complete, so the frames after it may be decoded in parallel
+    stream.reset();
+    launch();
+  }
+}
+
+auto champsim::parallel_zstd_istream::read(char* s, std::streamsize count) -> parallel_zstd_istream&
+{
+  gcount_ = 0;
+  while (gcount_ < count && !eof_) {
+    if (current_offset < std::size(current)) {
+      auto to_copy = std::min(static_cast<std::size_t>(count - gcount_), std::size(current) - current_offset);
+      std::memcpy(std::next(s, gcount_), std::next(std::data(current), static_cast<long>(current_offset)), to_copy);
+      current_offset += to_copy;
+      gcount_ += static_cast<std::streamsize>(to_copy);
+      position += to_copy;
+    } else if (frames_exhausted()) {
+      eof_ = true;
+    } else {
+      refill();
+    }
+  }
+  return *this;
+}
@@ -0,0 +1,136 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <istream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "cache.h"
+#include "dram_controller.h"
+#include "ooo_cpu.h"
+#include "phase_info.h"
+
+std::vector<champsim::region_info> champsim::read_regions(std::istream& stream)
+{
+  std::vector<region_info> regions;
+  std::string line;
+  for (long line_number = 1; std::getline(stream, line); ++line_number) {
+    std::istringstream line_stream{line};
+    std::string first;
+    if (!(line_stream >> first) || first.front() == '#') {
+      continue;
+    }
+
+    line_stream.str(line);
+    line_stream.clear();
+    region_info region{};
+    std::string trailing;
+    if (!(line_stream >> region.start >> region.length >> region.weight) || (line_stream >> trailing)) {
+      throw std::invalid_argument{fmt::format("Line {} of the region file is not of the form '<start> <length> <weight>'", line_number)};
+    }
+    if (region.start < 0 || region.length <= 0 || region.weight < 0) {
+      throw std::invalid_argument{fmt::format("Line {} of the region file has a negative start or weight, or a length that is not positive", line_number)};
+    }
+    regions.push_back(region);
+  }
+
+  std::sort(std::begin(regions), std::end(regions), [](const auto& lhs, const auto& rhs) { return lhs.start < rhs.start; });
+  auto overlap = std::adjacent_find(std::begin(regions), std::end(regions), [](const auto& lhs, const auto& rhs) { return lhs.start + lhs.length > rhs.start; });
+  if (overlap != std::end(regions)) {
+    throw std::invalid_argument{fmt::format("The region starting at instruction {} overlaps the one after it", overlap->start)};
+  }
+
+  return regions;
+}
+
+std::vector<champsim::phase_info> champsim::default_phases(long long warmup_instructions, long long simulation_instructions,
+                                                           const std::vector<std::string>& trace_names)
+{
+  std::vector<std::size_t> trace_index(std::size(trace_names));
+  std::iota(std::begin(trace_index), std::end(trace_index), 0);
+
+  return {phase_info{"Warmup", true, warmup_instructions, trace_index, trace_names},
+          phase_info{"Simulation", false, simulation_instructions, trace_index, trace_names}};
+}
+
+std::vector<champsim::phase_info> champsim::region_phases(const std::vector<region_info>& regions, long long warmup_instructions,
+                                                          const std::vector<std::string>& trace_names)
+{
+  std::vector<std::size_t> trace_index(std::size(trace_names));
+  std::iota(std::begin(trace_index), std::end(trace_index), 0);
+
+  std::vector<phase_info> phases;
+  long long position = 0;
+  for (std::size_t i = 0; i < std::size(regions); ++i) {
+    const auto& region = regions.at(i);
+
+    // The warmup may not reach back into the previous region
+    auto warmup_length = std::min(warmup_instructions, region.start - position);
+
+    // The instructions still in flight at the end of the previous region retire during the warmup. Without one, they would be
+    // counted in this region.
+    if (i > 0 && warmup_length == 0) {
+      throw std::invalid_argument{fmt::format("Region {} has no room for a warmup after region {}. Separate the regions, or give a longer warmup.", i, i - 1)};
+    }
+    phases.push_back(
+        phase_info{fmt::format("Warmup {}", i), true, warmup_length, trace_index, trace_names, region.start - warmup_length - position, region.weight});
+    phases.push_back(phase_info{fmt::format("Region {}", i), false, region.length, trace_index, trace_names, 0, region.weight});
+    position = region.start + region.length;
+  }
+
+  return phases;
+}
+
+champsim::phase_stats champsim::weighted_phase_stats(std::string name, const std::vector<phase_stats>& stats)
+{
+  phase_stats result;
+  result.name = std::move(name);
+  if (std::empty(stats)) {
+    return result;
+  }
+
+  result.trace_names = stats.front().trace_names;
+  const auto total_weight = std::accumulate(std::cbegin(stats), std::cend(stats), 0.0, [](auto acc, const auto& phase) { return acc + phase.weight; });
+  if (total_weight <= 0) {
+    throw std::invalid_argument{"The weights of the phases must not all be zero"};
+  }
+
+  // Each member is a vector with one element per component, which are combined element-wise
+  auto combine = [&](auto member) {
+    auto& combined = result.*member;
+    for (const auto& phase : stats) {
+      const auto& part = phase.*member;
+      combined.resize(std::size(part), typename std::decay_t<decltype(combined)>::value_type{});
+      for (std::size_t i = 0; i < std::size(part); ++i) {
+        auto scaled = part.at(i) * (phase.weight / total_weight);
+        combined.at(i) = (&phase == &stats.front()) ? scaled : combined.at(i) + scaled;
+      }
+    }
+  };
+
+  combine(&phase_stats::roi_cpu_stats);
+  combine(&phase_stats::sim_cpu_stats);
+  combine(&phase_stats::roi_cache_stats);
+  combine(&phase_stats::sim_cache_stats);
+  combine(&phase_stats::roi_dram_stats);
+  combine(&phase_stats::sim_dram_stats);
+
+  result.weight = total_weight;
+  return result;
+}
@@ -36,6 +36,17 @@ auto print_ratio(N num, D denom)
   }
   return std::string{"-"};
 }
+
+std::string print_size(long bytes)
+{
+  if (bytes % champsim::data::mebibytes::byte_multiple == 0) {
+    return fmt::format("{}", champsim::data::mebibytes{bytes / champsim::data::mebibytes::byte_multiple});
+  }
+  if (bytes % champsim::data::kibibytes::byte_multiple == 0) {
+    return fmt::format("{}", champsim::data::kibibytes{bytes / champsim::data::kibibytes::byte_multiple});
+  }
+  return fmt::format("{}", champsim::data::bytes{bytes});
+}
 } // namespace
 
 std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stats)
@@ -122,6 +133,23 @@ std::vector<std::string> champsim::plain_printer::format(CACHE::stats_type stats
     uint64_t total_downstream_demands = total_mshr_return - stats.mshr_return.value_or(std::pair{access_type::PREFETCH, cpu}, mshr_return_value_type{});
     lines.push_back(
         fmt::format("cpu{}->{} AVERAGE MISS LATENCY: {} cycles", cpu, stats.name, ::print_ratio(stats.total_miss_latency_cycles, total_downstream_demands)));
+
+    // An access misses at every size smaller than the one at which it would hit
+    std::vector<std::pair<long, long>> profile{};
+    for (auto [size, profiled_cpu] : stats.stack_distances.get_keys()) {
+      if (profiled_cpu == cpu) {
+        profile.emplace_back(size, stats.stack_distances.value_or(std::pair{size, profiled_cpu}, 0));
+      }
+    }
+    auto profiled_accesses = std::accumulate(std::begin(profile), std::end(profile), 0L, [](auto acc, auto next) { return acc + next.second; });
+    auto profiled_misses = profiled_accesses;
+    for (auto [size, count] : profile) {
+      profiled_misses -= count;
+      if (size != champsim::stack_distance_profiler::cold) {
+        lines.push_back(
+            fmt::format("cpu{}->{} LRU MISS RATIO AT {:>10}: {}", cpu, stats.name, ::print_size(size), ::print_ratio(profiled_misses, profiled_accesses)));
+      }
+    }
   }
 
   return lines;
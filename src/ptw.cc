@@ -16,7 +16,9 @@
 
 #include "ptw.h"
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <numeric>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
@@ -24,6 +26,7 @@
 #include "champsim.h"
 #include "deadlock.h"
 #include "instruction.h"
+#include "msl/checkpoint.h"
 #include "ptw_builder.h" // for ptw_builder
 #include "util/bits.h"   // for bitmask, lg2, splice_bits
 #include "util/span.h"
@@ -180,6 +183,25 @@ long PageTableWalker::operate()
   return progress;
 }
 
+champsim::chrono::clock::time_point PageTableWalker::next_event_time() const
+{
+  const auto next_cycle = current_time + clock_period;
+
+  // Returns and new requests are handled in the next cycle
+  if (!std::empty(lower_level->returned) || std::any_of(std::begin(upper_levels), std::end(upper_levels), [](const auto* ul) { return !std::empty(ul->RQ); })) {
+    return next_cycle;
+  }
+
+  auto next_event = champsim::chrono::clock::time_point::max();
+  for (const auto& q : {std::cref(completed), std::cref(finished)}) {
+    for (const auto& entry : q.get()) {
+      next_event = std::min(next_event, entry.data.ready_time());
+    }
+  }
+
+  return std::max(next_event, next_cycle);
+}
+
 void PageTableWalker::finish_packet(const response_type& packet)
 {
   auto finish_step = [this](auto mshr_entry) {
@@ -222,6 +244,47 @@ void PageTableWalker::finish_packet(const response_type& packet)
   MSHR.erase(std::begin(MSHR), last_finished);
 }
 
+champsim::address PageTableWalker::functional_translate(const request_type& handle_pkt, const champsim::functional_forward_type& forward)
+{
+  // The walk begins as in handle_read()
+  pscl_entry walk_init = {handle_pkt.v_address, CR3_addr, std::size(pscl)};
+  for (auto& pscl_level : pscl) {
+    if (auto hit = pscl_level.check_hit({handle_pkt.v_address, CR3_addr, std::size(pscl)}); hit.has_value()) {
+      walk_init = *hit;
+    }
+  }
+
+  champsim::address_slice walk_offset{
+      champsim::dynamic_extent{champsim::data::bits{LOG2_PAGE_SIZE}, champsim::data::bits{champsim::lg2(pte_entry::byte_multiple)}},
+      vmem->get_offset(handle_pkt.address, walk_init.level)};
+
+  request_type packet;
+  packet.address = champsim::address{champsim::splice(champsim::page_number{walk_init.ptw_addr}, champsim::page_offset{walk_offset})};
+  packet.v_address = handle_pkt.address;
+  packet.pf_metadata = handle_pkt.pf_metadata;
+  packet.cpu = handle_pkt.cpu;
+  packet.asid[0] = handle_pkt.asid[0];
+  packet.asid[1] = handle_pkt.asid[1];
+  packet.is_translated = true;
+  packet.type = access_type::TRANSLATION;
+  forward(lower_level, packet);
+
+  // Each level is then read as in finish_packet() and handle_fill()
+  for (auto level = walk_init.level; level > 0; --level) {
+    auto next_address = vmem->get_pte_pa(packet.cpu, champsim::page_number{packet.v_address}, level).first;
+    pscl.at(std::size(pscl) - level).fill({packet.v_address, next_address, level});
+
+    packet.address = next_address;
+    forward(lower_level, packet);
+  }
+
+  return champsim::address{vmem->va_to_pa(packet.cpu, champsim::page_number{packet.v_address}).first};
+}
+
+void PageTableWalker::checkpoint(std::ostream& stream) const { champsim::msl::checkpoint(stream, pscl); }
+
+void PageTableWalker::restore(std::istream& stream) { champsim::msl::restore(stream, pscl); }
+
 void PageTableWalker::begin_phase()
 {
   for (auto* ul : upper_levels) {
@@ -0,0 +1,181 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "shared_trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fmt/core.h>
+
+champsim::shared_trace_source::shared_trace_source(std::string name_, opener_type opener, bool repeat_, uint64_t max_lag_)
+    : name(std::move(name_)), open(std::move(opener)), file(open()), repeat(repeat_), max_lag(max_lag_)
+{
+}
+
+auto champsim::shared_trace_source::join(const std::shared_ptr<shared_trace_source>& source) -> std::optional<reader>
+{
+  std::lock_guard lock{source->mutex};
+  if (source->first_chunk != 0) {
+    return std::nullopt;
+  }
+
+  source->reader_positions.push_back(0);
+  return reader{source, std::size(source->reader_positions) - 1};
+}
+
+auto champsim::shared_trace_source::get(std::size_t slot, uint64_t index) -> std::shared_ptr<const chunk_type>
+{
+  std::lock_guard lock{mutex};
+  if (reader_positions.at(slot) == detached) {
+    return nullptr;
+  }
+  reader_positions.at(slot) = index;
+
+  // Readers that have fallen too far behind no longer hold the chunks they have yet to read
+  if (index >= first_chunk + std::size(chunks)) {
+    for (auto& position : reader_positions) {
+      if (position < detached && position + max_lag < index) {
+        position = detached;
+      }
+    }
+  }
+
+  auto release = [this]() {
+    // Release the chunks that every reader has passed
+    auto oldest = *std::min_element(std::begin(reader_positions), std::end(reader_positions));
+    while (!std::empty(chunks) && first_chunk < oldest) {
+      chunks.pop_front();
+      ++first_chunk;
+    }
+  };
+  release();
+
+  // Decompress until the requested chunk is available
+  while (index >= first_chunk + std::size(chunks) && !at_end) {
+    auto next = std::make_shared<chunk_type>(chunk_type{file_offset, std::vector<char>(chunk_size)});
+    auto bytes_read = file->read(std::data(next->bytes), chunk_size);
+    if (bytes_read == 0 && repeat) {
+      fmt::print("*** Reached end of trace: {}\n", name);
+      file = open();
+      file_offset = 0;
+      next->offset = 0;
+      bytes_read = file->read(std::data(next->bytes), chunk_size);
+    }
+
+    if (bytes_read == 0) {
+      at_end = true;
+    } else {
+      next->bytes.resize(bytes_read);
+      file_offset += bytes_read;
+      chunks.push_back(std::move(next));
+      release();
+    }
+  }
+
+  if (index < first_chunk + std::size(chunks)) {
+    return chunks.at(index - first_chunk);
+  }
+  return nullptr;
+}
+
+bool champsim::shared_trace_source::is_detached(std::size_t slot)
+{
+  std::lock_guard lock{mutex};
+  return reader_positions.at(slot) == detached;
+}
+
+auto champsim::shared_trace_source::detach(uint64_t offset) const -> std::shared_ptr<shared_trace_source>
+{
+  // The new source begins where the reader left off, and is read by a single reader
+  auto retval = std::make_shared<shared_trace_source>(name, open, repeat, max_lag);
+  if (retval->file->skip(offset) != offset) {
+    throw std::runtime_error{fmt::format("The trace {} ended before byte {}, where a detached reader resumes", name, offset)};
+  }
+  retval->file_offset = offset;
+  retval->reader_positions.push_back(0);
+  return retval;
+}
+
+void champsim::shared_trace_source::leave(std::size_t slot)
+{
+  std::lock_guard lock{mutex};
+  reader_positions.at(slot) = finished;
+}
+
+champsim::shared_trace_source::reader::reader(std::shared_ptr<shared_trace_source> source_, std::size_t slot_) : source(std::move(source_)), slot(slot_) {}
+
+champsim::shared_trace_source::reader::~reader()
+{
+  if (source != nullptr) {
+    source->leave(slot);
+  }
+}
+
+champsim::shared_trace_source::reader::reader(reader&& other) noexcept
+    : source(std::move(other.source)), slot(other.slot), chunk_index(other.chunk_index), chunk_offset(other.chunk_offset), chunk(std::move(other.chunk)),
+      gcount_(other.gcount_), eof_(other.eof_)
+{
+  other.source = nullptr;
+}
+
+auto champsim::shared_trace_source::reader::operator=(reader&& other) noexcept -> reader&
+{
+  if (source != nullptr) {
+    source->leave(slot);
+  }
+
+  source = std::exchange(other.source, nullptr);
+  slot = other.slot;
+  chunk_index = other.chunk_index;
+  chunk_offset = other.chunk_offset;
+  chunk = std::move(other.chunk);
+  gcount_ = other.gcount_;
+  eof_ = other.eof_;
+  return *this;
+}
+
+auto champsim::shared_trace_source::reader::read(char* s, std::streamsize count) -> reader&
+{
+  gcount_ = 0;
+  while (gcount_ < count && !eof_) {
+    if (chunk == nullptr || chunk_offset == std::size(chunk->bytes)) {
+      // The position in the file of the first byte this reader has yet to see
+      uint64_t resume_offset = 0;
+      if (chunk != nullptr) {
+        resume_offset = chunk->offset + std::size(chunk->bytes);
+        ++chunk_index;
+        chunk_offset = 0;
+      }
+      chunk = source->get(slot, chunk_index);
+      if (chunk == nullptr && source->is_detached(slot)) {
+        // Continue alone, from this reader's position in the file
+        source = source->detach(resume_offset);
+        slot = 0;
+        chunk_index = 0;
+        chunk = source->get(slot, chunk_index);
+      }
+      eof_ = (chunk == nullptr);
+    } else {
+      auto to_copy = std::min(static_cast<std::size_t>(count - gcount_), std::size(chunk->bytes) - chunk_offset);
+      std::memcpy(std::next(s, gcount_), std::next(std::data(chunk->bytes), static_cast<long>(chunk_offset)), to_copy);
+      chunk_offset += to_copy;
+      gcount_ += static_cast<std::streamsize>(to_copy);
+    }
+  }
+  return *this;
+}
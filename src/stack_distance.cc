@@ -0,0 +1,119 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_distance.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+constexpr unsigned sample_bits = 24;
+
+uint64_t mix(uint64_t x)
+{
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+} // namespace
+
+champsim::stack_distance_profiler::stack_distance_profiler(double sample_rate)
+    : threshold(static_cast<uint64_t>(std::llround(sample_rate * (1ULL << sample_bits)))), rate(sample_rate)
+{
+  assert(sample_rate > 0 && sample_rate <= 1);
+}
+
+void champsim::stack_distance_profiler::mark(uint64_t timestamp, long delta)
+{
+  for (auto i = timestamp + 1; i <= std::size(marks); i += i & (~i + 1)) {
+    marks[i - 1] += delta;
+  }
+}
+
+long champsim::stack_distance_profiler::marked_before(uint64_t timestamp) const
+{
+  long count = 0;
+  for (auto i = timestamp; i > 0; i -= i & (~i + 1)) {
+    count += marks[i - 1];
+  }
+  return count;
+}
+
+void champsim::stack_distance_profiler::compact()
+{
+  // Renumber the live timestamps in order, so that the tree only needs to span the sampled footprint
+  std::vector<std::pair<uint64_t, uint64_t>> live;
+  live.reserve(std::size(last_access));
+  std::transform(std::begin(last_access), std::end(last_access), std::back_inserter(live), [](const auto& entry) { return std::pair{entry.second, entry.first}; });
+  std::sort(std::begin(live), std::end(live));
+
+  next_timestamp = 0;
+  for (auto [timestamp, block] : live) {
+    last_access[block] = next_timestamp++;
+  }
+
+  marks.assign(std::max<std::size_t>(2 * std::size(live), 1024), 0);
+  for (std::size_t i = 1; i <= std::size(marks); ++i) {
+    if (i <= std::size(live)) {
+      marks[i - 1] += 1;
+    }
+    if (auto parent = i + (i & (~i + 1)); parent <= std::size(marks)) {
+      marks[parent - 1] += marks[i - 1];
+    }
+  }
+}
+
+std::optional<long> champsim::stack_distance_profiler::access(uint64_t block)
+{
+  if ((mix(block) & ((1ULL << sample_bits) - 1)) >= threshold) {
+    return std::nullopt;
+  }
+
+  if (next_timestamp == std::size(marks)) {
+    compact();
+  }
+
+  auto now = next_timestamp++;
+  auto [entry, inserted] = last_access.try_emplace(block, now);
+  mark(now, 1);
+  if (inserted) {
+    return cold;
+  }
+
+  auto previous = std::exchange(entry->second, now);
+  auto distance = marked_before(now) - marked_before(previous + 1);
+  mark(previous, -1);
+  return std::lround(static_cast<double>(distance) / rate);
+}
+
+long champsim::stack_distance_profiler::hitting_size(long distance)
+{
+  if (distance == cold) {
+    return cold;
+  }
+
+  for (long size = 1;; size *= 2) {
+    if (size > distance) {
+      return size;
+    }
+    if (size > 1 && size + size / 2 > distance) {
+      return size + size / 2;
+    }
+  }
+}
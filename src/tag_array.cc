@@ -0,0 +1,172 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tag_array.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CHAMPSIM_TAG_MATCH_DISPATCH
+#include <immintrin.h>
+#endif
+
+#include "util/bits.h"
+
+namespace
+{
+// Each set's tags are padded to a whole number of vectors, so that no comparison reads into the next set
+constexpr std::size_t ways_per_vector = 4;
+
+using match_function = uint64_t (*)(const uint64_t* tags, std::size_t count, uint64_t tag);
+
+uint64_t match_scalar(const uint64_t* tags, std::size_t count, uint64_t tag)
+{
+  uint64_t matches = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    matches |= static_cast<uint64_t>(tags[i] == tag) << i;
+  }
+  return matches;
+}
+
+#ifdef CHAMPSIM_TAG_MATCH_DISPATCH
+__attribute__((target("sse4.1"))) uint64_t match_sse41(const uint64_t* tags, std::size_t count, uint64_t tag)
+{
+  const auto key = _mm_set1_epi64x(static_cast<long long>(tag));
+  uint64_t matches = 0;
+  for (std::size_t i = 0; i < count; i += 2) {
+    auto equal = _mm_cmpeq_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tags + i)), key);
+    matches |= static_cast<uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(equal))) << i;
+  }
+  return matches;
+}
+
+__attribute__((target("avx2"))) uint64_t match_avx2(const uint64_t* tags, std::size_t count, uint64_t tag)
+{
+  const auto key = _mm256_set1_epi64x(static_cast<long long>(tag));
+  uint64_t matches = 0;
+  for (std::size_t i = 0; i < count; i += 4) {
+    auto equal = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(tags + i)), key);
+    matches |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(equal))) << i;
+  }
+  return matches;
+}
+#endif
+
+// Use the widest comparison that the host supports, whatever the target of the build
+match_function select_match()
+{
+#ifdef CHAMPSIM_TAG_MATCH_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return match_avx2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return match_sse41;
+  }
+#endif
+  return match_scalar;
+}
+} // namespace
+
+champsim::tag_array::tag_array(std::size_t sets, std::size_t ways)
+    : num_way(ways), words_per_set((ways + ways_per_word - 1) / ways_per_word),
+      tag_stride((ways + ways_per_vector - 1) / ways_per_vector * ways_per_vector), tags(sets * tag_stride), valid_bits(sets * words_per_set),
+      dirty_bits(sets * words_per_set), prefetch_bits(sets * words_per_set)
+{
+}
+
+uint64_t champsim::tag_array::match_word(long set, std::size_t word, uint64_t tag) const
+{
+  const auto first_way = word * ways_per_word;
+  const auto* set_tags = std::data(tags) + static_cast<std::size_t>(set) * tag_stride + first_way;
+  const auto count = std::min(ways_per_word, tag_stride - first_way);
+
+  static const match_function match = select_match();
+  const auto matches = match(set_tags, count, tag);
+
+  // Ignore the padding
+  const auto real_ways = std::min(ways_per_word, num_way - first_way);
+  return real_ways == ways_per_word ? matches : matches & ((uint64_t{1} << real_ways) - 1);
+}
+
+bool champsim::tag_array::test(const std::vector<uint64_t>& bits, long set, long way) const
+{
+  const auto idx = static_cast<std::size_t>(way);
+  return (bits[static_cast<std::size_t>(set) * words_per_set + idx / ways_per_word] >> (idx % ways_per_word)) & 1;
+}
+
+void champsim::tag_array::assign(std::vector<uint64_t>& bits, long set, long way, bool value)
+{
+  const auto idx = static_cast<std::size_t>(way);
+  auto& word = bits[static_cast<std::size_t>(set) * words_per_set + idx / ways_per_word];
+  const auto mask = uint64_t{1} << (idx % ways_per_word);
+  word = value ? (word | mask) : (word & ~mask);
+}
+
+long champsim::tag_array::find(long set, uint64_t tag) const
+{
+  const auto* set_valid = std::data(valid_bits) + static_cast<std::size_t>(set) * words_per_set;
+  for (std::size_t word = 0; word < words_per_set; ++word) {
+    if (auto matches = match_word(set, word, tag) & set_valid[word]; matches != 0) {
+      return static_cast<long>(word * ways_per_word) + champsim::countr_zero(matches);
+    }
+  }
+  return static_cast<long>(num_way);
+}
+
+long champsim::tag_array::find_any(long set, uint64_t tag) const
+{
+  for (std::size_t word = 0; word < words_per_set; ++word) {
+    if (auto matches = match_word(set, word, tag); matches != 0) {
+      return static_cast<long>(word * ways_per_word) + champsim::countr_zero(matches);
+    }
+  }
+  return static_cast<long>(num_way);
+}
+
+long champsim::tag_array::find_invalid(long set) const
+{
+  const auto* set_valid = std::data(valid_bits) + static_cast<std::size_t>(set) * words_per_set;
+  for (std::size_t word = 0; word < words_per_set; ++word) {
+    if (auto invalid = ~set_valid[word]; invalid != 0) {
+      return std::min(static_cast<long>(word * ways_per_word) + champsim::countr_zero(invalid), static_cast<long>(num_way));
+    }
+  }
+  return static_cast<long>(num_way);
+}
+
+bool champsim::tag_array::is_valid(long set, long way) const { return test(valid_bits, set, way); }
+
+bool champsim::tag_array::is_dirty(long set, long way) const { return test(dirty_bits, set, way); }
+
+bool champsim::tag_array::is_prefetch(long set, long way) const { return test(prefetch_bits, set, way); }
+
+bool champsim::tag_array::matches(long set, long way, uint64_t tag, const cache_block& block) const
+{
+  assert(static_cast<std::size_t>(way) < num_way);
+  return tags[static_cast<std::size_t>(set) * tag_stride + static_cast<std::size_t>(way)] == tag && is_valid(set, way) == block.valid
+         && is_dirty(set, way) == block.dirty && is_prefetch(set, way) == block.prefetch;
+}
+
+void champsim::tag_array::update(long set, long way, uint64_t tag, const cache_block& block)
+{
+  assert(static_cast<std::size_t>(way) < num_way);
+  tags[static_cast<std::size_t>(set) * tag_stride + static_cast<std::size_t>(way)] = tag;
+  assign(valid_bits, set, way, block.valid);
+  assign(dirty_bits, set, way, block.dirty);
+  assign(prefetch_bits, set, way, block.prefetch);
+}
@@ -16,57 +16,133 @@
 
 #include "tracereader.h"
 
-#include <fstream>
 #include <string>
+#include <type_traits>
 
+#include "async_tracereader.h"
+#include "champsim.h"
+#include "compact_trace.h"
 #include "inf_stream.h"
+#include "mapped_trace.h"
+#include "parallel_zstd.h"
 #include "repeatable.h"
 
 namespace champsim
 {
-uint64_t tracereader::instr_unique_id = 0; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
-
 ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_instr& target)
 {
   branch.branch_target = (branch.is_branch && branch.branch_taken) ? target.ip : champsim::address{};
   return branch;
 }
 
-template <template <class, class> typename R, typename T>
-champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
+template <typename F>
+struct trace_stream_tag {
+  using type = F;
+};
+
+/**
+ * Call the function with a tag holding the type of stream that reads the file, chosen by the file's suffix.
+ */
+template <typename Func>
+auto with_trace_stream_type(const std::string& fname, Func&& func)
 {
   if (bool is_gzip_compressed = (fname.substr(std::size(fname) - 2) == "gz"); is_gzip_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>(cpu, fname)};
+    return func(trace_stream_tag<champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>>{});
   }
 
   if (bool is_lzma_compressed = (fname.substr(std::size(fname) - 2) == "xz"); is_lzma_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>(cpu, fname)};
+    return func(trace_stream_tag<champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>>{});
   }
 
   if (bool is_bzip2_compressed = (fname.substr(std::size(fname) - 3) == "bz2"); is_bzip2_compressed) {
-    return champsim::tracereader{R<T, champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>(cpu, fname)};
+    return func(trace_stream_tag<champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>>{});
+  }
+
+  if (bool is_zstd_compressed = (fname.substr(std::size(fname) - 3) == "zst"); is_zstd_compressed) {
+    return func(trace_stream_tag<champsim::parallel_zstd_istream>{});
   }
 
-  return champsim::tracereader{R<T, std::ifstream>(cpu, fname)};
+  // Uncompressed traces are mapped into memory and decoded in place
+  return func(trace_stream_tag<champsim::mapped_trace>{});
+}
+
+template <template <class, class> typename R, typename T>
+champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu, unsigned decoder_threads)
+{
+  // Each cpu numbers its instructions apart from the others, and decompresses its trace on a thread of its own
+  return with_trace_stream_type(fname, [&](auto tag) {
+    using stream_type = typename decltype(tag)::type;
+
+    // Compact traces are recognized by their contents, under any compression
+    using reader_type = std::conditional_t<std::is_same_v<T, input_instr>, R<T, champsim::compact_istream<stream_type>>, R<T, stream_type>>;
+
+    // A mapped trace has nothing to decompress, so it is not worth a thread
+    if constexpr (std::is_same_v<stream_type, champsim::mapped_trace>) {
+      return champsim::tracereader{reader_type(cpu, fname, decoder_threads), cpu, NUM_CPUS};
+    } else {
+      return champsim::tracereader{champsim::async_tracereader{reader_type(cpu, fname, decoder_threads)}, cpu, NUM_CPUS};
+    }
+  });
 }
 } // namespace champsim
 
+std::shared_ptr<champsim::shared_trace_source> champsim::open_shared_trace(const std::string& fname, bool is_cloudsuite, bool repeat,
+                                                                           unsigned decoder_threads)
+{
+  auto opener = [fname, is_cloudsuite, decoder_threads]() {
+    return with_trace_stream_type(fname, [&](auto tag) -> std::unique_ptr<shared_trace_source::stream_concept> {
+      auto open_stream = [&](auto stream_tag) -> std::unique_ptr<shared_trace_source::stream_concept> {
+        using stream_type = typename decltype(stream_tag)::type;
+        if constexpr (std::is_constructible_v<stream_type, std::string, unsigned>) {
+          return std::make_unique<shared_trace_source::stream_model<stream_type>>(stream_type{fname, decoder_threads});
+        } else {
+          return std::make_unique<shared_trace_source::stream_model<stream_type>>(stream_type{fname});
+        }
+      };
+
+      // Compact traces are decoded once, for all of the readers. There is no compact form of a cloudsuite trace.
+      using stream_type = typename decltype(tag)::type;
+      if (is_cloudsuite) {
+        return open_stream(trace_stream_tag<stream_type>{});
+      }
+      return open_stream(trace_stream_tag<champsim::compact_istream<stream_type>>{});
+    });
+  };
+  return std::make_shared<shared_trace_source>(fname, opener, repeat);
+}
+
+bool champsim::reads_asynchronously(const std::string& fname)
+{
+  return with_trace_stream_type(fname, [](auto tag) { return !std::is_same_v<typename decltype(tag)::type, champsim::mapped_trace>; });
+}
+
 template <typename T, typename S>
-using repeatable_reader_t = champsim::repeatable<champsim::bulk_tracereader<T, S>, uint8_t, std::string>;
+using repeatable_reader_t = champsim::repeatable<champsim::bulk_tracereader<T, S>, uint8_t, std::string, unsigned>;
 
-champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat)
+champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat, unsigned decoder_threads)
 {
   if (is_cloudsuite && repeat) {
-    return champsim::get_tracereader_for_type<repeatable_reader_t, cloudsuite_instr>(fname, cpu);
+    return champsim::get_tracereader_for_type<repeatable_reader_t, cloudsuite_instr>(fname, cpu, decoder_threads);
   }
 
   if (is_cloudsuite && !repeat) {
-    return champsim::get_tracereader_for_type<champsim::bulk_tracereader, cloudsuite_instr>(fname, cpu);
+    return champsim::get_tracereader_for_type<champsim::bulk_tracereader, cloudsuite_instr>(fname, cpu, decoder_threads);
   }
 
   if (!is_cloudsuite && repeat) {
-    return champsim::get_tracereader_for_type<repeatable_reader_t, input_instr>(fname, cpu);
+    return champsim::get_tracereader_for_type<repeatable_reader_t, input_instr>(fname, cpu, decoder_threads);
+  }
+
+  return champsim::get_tracereader_for_type<champsim::bulk_tracereader, input_instr>(fname, cpu, decoder_threads);
+}
+
+champsim::tracereader get_tracereader(champsim::shared_trace_source::reader stream, uint8_t cpu, bool is_cloudsuite)
+{
+  // The reader that is furthest ahead decompresses for the others, so each has a thread of its own
+  using stream_type = champsim::shared_trace_source::reader;
+  if (is_cloudsuite) {
+    return champsim::tracereader{champsim::async_tracereader{champsim::bulk_tracereader<cloudsuite_instr, stream_type>(cpu, std::move(stream))}, cpu, NUM_CPUS};
   }
 
-  return champsim::get_tracereader_for_type<champsim::bulk_tracereader, input_instr>(fname, cpu);
+  return champsim::tracereader{champsim::async_tracereader{champsim::bulk_tracereader<input_instr, stream_type>(cpu, std::move(stream))}, cpu, NUM_CPUS};
 }
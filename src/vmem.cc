@@ -17,10 +17,12 @@
 #include "vmem.h"
 
 #include <cassert>
+#include <tuple>
 #include <fmt/core.h>
 
 #include "champsim.h"
 #include "dram_controller.h"
+#include "msl/checkpoint.h"
 #include "util/bits.h"
 
 using namespace champsim::data::data_literals;
@@ -95,6 +97,7 @@ champsim::page_number VirtualMemory::ppage_front() const
 void VirtualMemory::ppage_pop()
 {
   ppage_free_list.pop_front();
+  ++ppages_allocated;
   if (available_ppages() == 0) {
     fmt::print("[VMEM] WARNING: Out of physical memory, freeing ppages\n");
     populate_pages();
@@ -154,3 +157,48 @@ std::pair<champsim::address, champsim::chrono::clock::duration> VirtualMemory::g
 
   return {paddr, penalty};
 }
+
+void VirtualMemory::checkpoint(std::ostream& stream) const
+{
+  champsim::msl::checkpoint(stream, vpage_to_ppage_map);
+
+  // The extent of each page table entry is determined by its level, so only the value of the slice is written
+  champsim::msl::checkpoint(stream, static_cast<uint64_t>(std::size(page_table)));
+  for (const auto& [key, pte_paddr] : page_table) {
+    const auto& [cpu_num, level, vaddr] = key;
+    champsim::msl::checkpoint(stream, std::tuple{cpu_num, level, vaddr.to<uint64_t>(), pte_paddr});
+  }
+
+  champsim::msl::checkpoint(stream, ppages_allocated);
+  champsim::msl::checkpoint(stream, active_pte_page);
+  champsim::msl::checkpoint(stream, next_pte_page);
+}
+
+void VirtualMemory::restore(std::istream& stream)
+{
+  champsim::msl::restore(stream, vpage_to_ppage_map);
+
+  uint64_t num_entries{};
+  champsim::msl::restore(stream, num_entries);
+  page_table.clear();
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    std::tuple<uint32_t, uint32_t, uint64_t, champsim::address> entry{};
+    champsim::msl::restore(stream, entry);
+    auto [cpu_num, level, vaddr, pte_paddr] = entry;
+    champsim::dynamic_extent pte_table_entry_extent{champsim::address::bits, shamt(level)};
+    page_table.try_emplace({cpu_num, level, champsim::address_slice{pte_table_entry_extent, vaddr}}, pte_paddr);
+  }
+
+  // The order of the free list is determined by the configuration, so it is rebuilt by replaying the allocations
+  std::size_t num_allocated{};
+  champsim::msl::restore(stream, num_allocated);
+  populate_pages();
+  shuffle_pages();
+  ppages_allocated = 0;
+  while (ppages_allocated < num_allocated) {
+    ppage_pop();
+  }
+
+  champsim::msl::restore(stream, active_pte_page);
+  champsim::msl::restore(stream, next_pte_page);
+}
@@ -1,5 +1,9 @@
 #include <catch.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include "operable.h"
 
 namespace
@@ -60,3 +64,102 @@ TEST_CASE("An operable with a scale greater than 2 skips multiple cycles")
 
   REQUIRE(uut.count == num_cycles / 4);
 }
+
+TEST_CASE("An operable that does not report its events may not be skipped")
+{
+  champsim::chrono::clock::duration period{100};
+  mock_operable uut{period};
+
+  REQUIRE(uut.next_event_time() == uut.current_time + period);
+}
+
+TEST_CASE("Skipping an operable leaves its clock where operating would have")
+{
+  auto [period, tick] = GENERATE(table<long, long>({std::pair{100, 100}, std::pair{150, 100}, std::pair{400, 100}}));
+  constexpr int num_cycles = 100;
+
+  champsim::chrono::clock operated_clock{};
+  mock_operable operated{champsim::chrono::picoseconds{period}};
+  for (int i = 0; i < num_cycles; ++i) {
+    operated_clock.tick(champsim::chrono::picoseconds{tick});
+    operated.operate_on(operated_clock);
+  }
+
+  champsim::chrono::clock skipped_clock{};
+  mock_operable skipped{champsim::chrono::picoseconds{period}};
+  skipped_clock.tick(num_cycles * champsim::chrono::picoseconds{tick});
+  skipped.skip_on(skipped_clock);
+
+  REQUIRE(skipped.current_time == operated.current_time);
+  REQUIRE(skipped.count == 0);
+}
+
+TEST_CASE("An operable schedule orders operables by their local time")
+{
+  champsim::chrono::clock global_clock{};
+  mock_operable fast_a{champsim::chrono::picoseconds{100}};
+  mock_operable slow{champsim::chrono::picoseconds{300}};
+  mock_operable fast_b{champsim::chrono::picoseconds{100}};
+  std::vector<std::reference_wrapper<champsim::operable>> operables{{fast_a, slow, fast_b}};
+
+  champsim::operable_schedule uut{operables};
+
+  auto addresses_of = [](const auto& ops) {
+    std::vector<const champsim::operable*> retval{};
+    for (const champsim::operable& op : ops) {
+      retval.push_back(&op);
+    }
+    return retval;
+  };
+
+  // All operables begin at the same time, so the original order is kept
+  REQUIRE(addresses_of(uut.sorted()) == std::vector<const champsim::operable*>{&fast_a, &slow, &fast_b});
+
+  global_clock.tick(champsim::chrono::picoseconds{100});
+  for (champsim::operable& op : uut.sorted()) {
+    op.operate_on(global_clock);
+  }
+
+  // The fast operables are now behind the slow one
+  REQUIRE(addresses_of(uut.sorted()) == std::vector<const champsim::operable*>{&fast_a, &fast_b, &slow});
+
+  global_clock.tick(champsim::chrono::picoseconds{200});
+  for (champsim::operable& op : uut.sorted()) {
+    op.operate_on(global_clock);
+  }
+
+  // All operables are at the same time again
+  REQUIRE(addresses_of(uut.sorted()) == std::vector<const champsim::operable*>{&fast_a, &slow, &fast_b});
+}
+
+TEST_CASE("An operable schedule of a large system keeps operables with the same local time in their original order")
+{
+  champsim::chrono::clock global_clock{};
+  std::vector<mock_operable> storage{};
+  for (int i = 0; i < 40; ++i) {
+    storage.emplace_back(champsim::chrono::picoseconds{100 * (1 + i % 3)});
+  }
+  std::vector<std::reference_wrapper<champsim::operable>> operables{std::begin(storage), std::end(storage)};
+
+  champsim::operable_schedule uut{operables};
+
+  auto addresses_of = [](const auto& ops) {
+    std::vector<const champsim::operable*> retval{};
+    for (const champsim::operable& op : ops) {
+      retval.push_back(&op);
+    }
+    return retval;
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    auto expected = operables;
+    std::stable_sort(std::begin(expected), std::end(expected),
+                     [](const champsim::operable& lhs, const champsim::operable& rhs) { return lhs.current_time < rhs.current_time; });
+    REQUIRE(addresses_of(uut.sorted()) == addresses_of(expected));
+
+    global_clock.tick(champsim::chrono::picoseconds{100});
+    for (champsim::operable& op : uut.sorted()) {
+      op.operate_on(global_clock);
+    }
+  }
+}
@@ -0,0 +1,50 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.h"
+
+TEST_CASE("A worker pool runs each job exactly once")
+{
+  auto num_threads = GENERATE(std::size_t{1}, std::size_t{2}, std::size_t{4});
+  champsim::worker_pool pool{num_threads};
+
+  std::vector<std::atomic<int>> counts(16);
+  for (int batch = 0; batch < 10; ++batch) {
+    pool.run(std::size(counts), [&](std::size_t i) { ++counts.at(i); });
+  }
+
+  for (const auto& count : counts) {
+    REQUIRE(count.load() == 10);
+  }
+}
+
+TEST_CASE("A worker pool can run an empty batch")
+{
+  champsim::worker_pool pool{2};
+  bool ran = false;
+  pool.run(0, [&](std::size_t) { ran = true; });
+  REQUIRE_FALSE(ran);
+}
+
+TEST_CASE("A worker pool rethrows exceptions from its jobs")
+{
+  champsim::worker_pool pool{2};
+  std::atomic<int> completed{0};
+
+  REQUIRE_THROWS_AS(pool.run(4,
+                             [&](std::size_t i) {
+                               if (i == 2) {
+                                 throw std::runtime_error{"job failed"};
+                               }
+                               ++completed;
+                             }),
+                    std::runtime_error);
+  REQUIRE(completed.load() == 3);
+
+  // The pool remains usable afterward
+  pool.run(4, [&](std::size_t) { ++completed; });
+  REQUIRE(completed.load() == 7);
+}
@@ -0,0 +1,260 @@
+#include <catch.hpp>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "cache.h"
+#include "checkpoint.h"
+#include "defaults.hpp"
+#include "dram_controller.h"
+#include "environment.h"
+#include "instr.h"
+#include "ooo_cpu.h"
+#include "parallel.h"
+#include "phase_info.h"
+#include "ptw.h"
+#include "tracereader.h"
+#include "vmem.h"
+
+namespace champsim
+{
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const parallel_options& options,
+                              const checkpoint_options& checkpoints);
+}
+
+namespace
+{
+constexpr std::size_t num_cores = 2;
+
+/*
+ * Two cores, each with an L1I, an L1D, and a TLB, that share an LLC and DRAM.
+ * As in a generated environment, each core's page table walker sends its walks to that core's L1D.
+ */
+struct two_core_environment final : champsim::environment {
+  const champsim::chrono::picoseconds clock_period{250};
+
+  struct core_channels {
+    champsim::channel fetch{32, 0, 32, champsim::data::bits{champsim::lg2(64)}, 0};
+    champsim::channel data{32, 0, 32, champsim::data::bits{champsim::lg2(64)}, 0};
+    champsim::channel walk{16, 0, 16, champsim::data::bits{champsim::lg2(64)}, 1};
+    champsim::channel l1i_translate{32, 0, 32, champsim::data::bits{champsim::lg2(4096)}, 0};
+    champsim::channel l1d_translate{32, 0, 32, champsim::data::bits{champsim::lg2(4096)}, 0};
+    champsim::channel tlb_miss{16, 0, 0, champsim::data::bits{champsim::lg2(4096)}, 0};
+    champsim::channel l1i_miss{32, 16, 32, champsim::data::bits{champsim::lg2(64)}, 0};
+    champsim::channel l1d_miss{32, 16, 32, champsim::data::bits{champsim::lg2(64)}, 0};
+  };
+
+  std::array<core_channels, num_cores> channels{};
+  champsim::channel llc_miss{64, 32, 64, champsim::data::bits{champsim::lg2(64)}, 1};
+
+  MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{312},
+                         champsim::chrono::picoseconds{625},
+                         std::size_t{24},
+                         std::size_t{24},
+                         std::size_t{24},
+                         std::size_t{52},
+                         champsim::chrono::microseconds{32000},
+                         {&llc_miss},
+                         64,
+                         64,
+                         1,
+                         champsim::data::bytes{8},
+                         65536,
+                         1024,
+                         1,
+                         8,
+                         4,
+                         8192};
+  VirtualMemory vmem{champsim::data::bytes{4096}, 5, champsim::chrono::nanoseconds{50}, dram};
+
+  std::deque<PageTableWalker> ptws{};
+  std::deque<CACHE> caches{};
+  std::deque<O3_CPU> cores{};
+
+  two_core_environment()
+  {
+    caches.emplace_back(champsim::cache_builder{champsim::defaults::default_llc}
+                            .name("LLC")
+                            .upper_levels({&channels[0].l1i_miss, &channels[0].l1d_miss, &channels[1].l1i_miss, &channels[1].l1d_miss})
+                            .lower_level(&llc_miss)
+                            .clock_period(clock_period));
+
+    for (std::size_t i = 0; i < num_cores; ++i) {
+      auto& chans = channels[i];
+      ptws.emplace_back(champsim::ptw_builder{champsim::defaults::default_ptw}
+                            .name("PTW")
+                            .cpu(static_cast<uint32_t>(i))
+                            .upper_levels({&chans.tlb_miss})
+                            .lower_level(&chans.walk)
+                            .virtual_memory(&vmem)
+                            .clock_period(clock_period));
+      caches.emplace_back(champsim::cache_builder{champsim::defaults::default_dtlb}
+                              .name("TLB")
+                              .upper_levels({&chans.l1i_translate, &chans.l1d_translate})
+                              .lower_level(&chans.tlb_miss)
+                              .clock_period(clock_period));
+      auto& l1i = caches.emplace_back(champsim::cache_builder{champsim::defaults::default_l1i}
+                                          .name("L1I")
+                                          .upper_levels({&chans.fetch})
+                                          .lower_translate(&chans.l1i_translate)
+                                          .lower_level(&chans.l1i_miss)
+                                          .clock_period(clock_period));
+      caches.emplace_back(champsim::cache_builder{champsim::defaults::default_l1d}
+                              .name("L1D")
+                              .upper_levels({&chans.data, &chans.walk})
+                              .lower_translate(&chans.l1d_translate)
+                              .lower_level(&chans.l1d_miss)
+                              .clock_period(clock_period));
+      cores.emplace_back(champsim::core_builder{champsim::defaults::default_core}
+                             .index(static_cast<uint32_t>(i))
+                             .l1i(&l1i)
+                             .fetch_queues(&chans.fetch)
+                             .data_queues(&chans.data)
+                             .clock_period(clock_period));
+    }
+  }
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {std::begin(cores), std::end(cores)}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {std::begin(caches), std::end(caches)}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {std::begin(ptws), std::end(ptws)}; }
+  MEMORY_CONTROLLER& dram_view() final { return dram; }
+  VirtualMemory& vmem_view() final { return vmem; }
+
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() final
+  {
+    std::vector<std::reference_wrapper<champsim::operable>> retval{};
+    retval.insert(std::end(retval), std::begin(cores), std::end(cores));
+    retval.insert(std::end(retval), std::begin(caches), std::end(caches));
+    retval.insert(std::end(retval), std::begin(ptws), std::end(ptws));
+    retval.push_back(dram);
+    return retval;
+  }
+};
+
+/*
+ * An endless trace of loads that miss in the private caches, interleaved with register operations
+ */
+struct generated_trace {
+  uint64_t cpu;
+  uint64_t count = 0;
+
+  ooo_model_instr operator()()
+  {
+    auto ip = champsim::address{0x400000 + 4 * (count % 256)};
+    auto retval = (count % 2 == 0) ? champsim::test::instruction_with_ip_and_source_memory(ip, champsim::address{((cpu + 1) << 32) + 0x240 * count})
+                                   : champsim::test::instruction_with_ip(ip);
+    ++count;
+    return retval;
+  }
+};
+
+template <typename T>
+std::vector<const void*> addresses_of(const std::vector<std::reference_wrapper<T>>& view)
+{
+  std::vector<const void*> retval{};
+  for (const T& x : view) {
+    retval.push_back(&x);
+  }
+  return retval;
+}
+
+std::vector<champsim::phase_stats> run_parallel(std::size_t threads)
+{
+  two_core_environment env{};
+  std::vector<champsim::tracereader> traces{};
+  for (std::size_t i = 0; i < num_cores; ++i) {
+    traces.emplace_back(generated_trace{i}, i, num_cores);
+  }
+  std::vector<champsim::phase_info> phases{{"Simulation", false, 2000, {0, 1}, {"generated", "generated"}}};
+
+  champsim::parallel_options options{};
+  options.threads = threads;
+  options.sync_cycles = 50;
+  return champsim::main(env, phases, traces, options, champsim::checkpoint_options{});
+}
+} // namespace
+
+TEST_CASE("The operables are partitioned into a private group for each core and a shared group")
+{
+  two_core_environment env{};
+  auto uut = champsim::partition_operables(env);
+
+  REQUIRE(std::size(uut.private_groups) == num_cores);
+  for (std::size_t i = 0; i < num_cores; ++i) {
+    // The core, its TLB, its L1I, and its L1D, in the order of the operable view
+    auto caches = std::next(std::begin(env.caches), static_cast<long>(1 + 3 * i));
+    std::vector<std::reference_wrapper<champsim::operable>> expected{env.cores.at(i), *caches, *std::next(caches), *std::next(caches, 2)};
+    REQUIRE(addresses_of(uut.private_groups.at(i)) == addresses_of(expected));
+  }
+
+  // The LLC and DRAM are reached by both cores, and the walkers are always shared
+  std::vector<std::reference_wrapper<champsim::operable>> expected_shared{env.caches.front(), env.ptws.at(0), env.ptws.at(1), env.dram};
+  REQUIRE(addresses_of(uut.shared) == addresses_of(expected_shared));
+}
+
+TEST_CASE("A parallel simulation gives the same results in every run")
+{
+  auto first = run_parallel(2);
+  auto second = run_parallel(2);
+  auto oversubscribed = run_parallel(8);
+
+  for (const auto& other : {second, oversubscribed}) {
+    REQUIRE(std::size(first) == 1);
+    REQUIRE(std::size(other) == 1);
+
+    for (std::size_t i = 0; i < num_cores; ++i) {
+      CHECK(first.front().sim_cpu_stats.at(i).instrs() >= 2000);
+      CHECK(first.front().sim_cpu_stats.at(i).instrs() == other.front().sim_cpu_stats.at(i).instrs());
+      CHECK(first.front().sim_cpu_stats.at(i).cycles() == other.front().sim_cpu_stats.at(i).cycles());
+    }
+
+    REQUIRE(std::size(first.front().sim_cache_stats) == std::size(other.front().sim_cache_stats));
+    for (std::size_t i = 0; i < std::size(first.front().sim_cache_stats); ++i) {
+      const auto& lhs = first.front().sim_cache_stats.at(i);
+      const auto& rhs = other.front().sim_cache_stats.at(i);
+      CHECK(lhs.total_miss_latency_cycles == rhs.total_miss_latency_cycles);
+      for (std::size_t cpu = 0; cpu < num_cores; ++cpu) {
+        CHECK(lhs.hits.value_or({access_type::LOAD, cpu}, 0) == rhs.hits.value_or({access_type::LOAD, cpu}, 0));
+        CHECK(lhs.misses.value_or({access_type::LOAD, cpu}, 0) == rhs.misses.value_or({access_type::LOAD, cpu}, 0));
+      }
+    }
+
+    CHECK(first.front().sim_dram_stats.at(0).RQ_ROW_BUFFER_HIT == other.front().sim_dram_stats.at(0).RQ_ROW_BUFFER_HIT);
+    CHECK(first.front().sim_dram_stats.at(0).RQ_ROW_BUFFER_MISS == other.front().sim_dram_stats.at(0).RQ_ROW_BUFFER_MISS);
+  }
+}
+
+TEST_CASE("A functional warmup between timed regions is rejected")
+{
+  two_core_environment env{};
+  std::vector<champsim::tracereader> traces{};
+  for (std::size_t i = 0; i < num_cores; ++i) {
+    traces.emplace_back(generated_trace{i}, i, num_cores);
+  }
+
+  // As with --functional-warmup and --regions
+  auto phases = champsim::region_phases({{1000, 500, 1}, {3000, 500, 1}}, 1000, {"generated", "generated"});
+  for (auto& phase : phases) {
+    phase.functional = phase.is_warmup;
+  }
+
+  REQUIRE_THROWS_AS(champsim::main(env, phases, traces, champsim::parallel_options{}, champsim::checkpoint_options{}), std::invalid_argument);
+}
+
+TEST_CASE("A parallel simulation rejects a synchronization period as long as the deadlock threshold")
+{
+  two_core_environment env{};
+  std::vector<champsim::tracereader> traces{};
+  for (std::size_t i = 0; i < num_cores; ++i) {
+    traces.emplace_back(generated_trace{i}, i, num_cores);
+  }
+  std::vector<champsim::phase_info> phases{{"Simulation", false, 100, {0, 1}, {"generated", "generated"}}};
+
+  champsim::parallel_options options{};
+  options.threads = 2;
+  options.sync_cycles = champsim::deadlock_cycles;
+  REQUIRE_THROWS_AS(champsim::main(env, phases, traces, options, champsim::checkpoint_options{}), std::invalid_argument);
+}
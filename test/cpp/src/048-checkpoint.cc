@@ -0,0 +1,172 @@
+#include <catch.hpp>
+#include <array>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "checkpoint.h"
+#include "dram_controller.h"
+#include "environment.h"
+#include "msl/checkpoint.h"
+#include "msl/lru_table.h"
+#include "vmem.h"
+
+namespace
+{
+struct type_with_getters {
+  unsigned int value;
+
+  auto index() const { return value; }
+
+  auto tag() const { return value; }
+};
+
+/*
+ * An environment with no cores or caches, whose only component is the memory controller
+ */
+struct dram_only_environment final : champsim::environment {
+  MEMORY_CONTROLLER dram{champsim::chrono::picoseconds{312},
+                         champsim::chrono::picoseconds{625},
+                         std::size_t{24},
+                         std::size_t{24},
+                         std::size_t{24},
+                         std::size_t{52},
+                         champsim::chrono::microseconds{32000},
+                         {},
+                         64,
+                         64,
+                         1,
+                         champsim::data::bytes{8},
+                         65536,
+                         1024,
+                         1,
+                         8,
+                         4,
+                         8192};
+  VirtualMemory vmem{champsim::data::bytes{4096}, 5, champsim::chrono::nanoseconds{50}, dram};
+
+  std::vector<std::reference_wrapper<O3_CPU>> cpu_view() final { return {}; }
+  std::vector<std::reference_wrapper<CACHE>> cache_view() final { return {}; }
+  std::vector<std::reference_wrapper<PageTableWalker>> ptw_view() final { return {}; }
+  MEMORY_CONTROLLER& dram_view() final { return dram; }
+  VirtualMemory& vmem_view() final { return vmem; }
+  std::vector<std::reference_wrapper<champsim::operable>> operable_view() final { return {dram}; }
+};
+
+template <typename T>
+T round_trip(const T& value, T result)
+{
+  std::stringstream stream;
+  champsim::msl::checkpoint(stream, value);
+  champsim::msl::restore(stream, result);
+  return result;
+}
+} // namespace
+
+TEST_CASE("Trivially copyable values can be checkpointed")
+{
+  REQUIRE(::round_trip(0xdeadbeefu, 0u) == 0xdeadbeefu);
+  REQUIRE(::round_trip(std::array<int, 3>{1, 2, 3}, {}) == std::array<int, 3>{1, 2, 3});
+}
+
+TEST_CASE("Containers can be checkpointed")
+{
+  std::vector<int> vec{1, 2, 3, 4};
+  REQUIRE(::round_trip(vec, {}) == vec);
+
+  std::vector<std::string> strings{"a", "bc", ""};
+  REQUIRE(::round_trip(strings, {"leftover"}) == strings);
+
+  std::map<int, std::pair<long, std::string>> map{{1, {2, "two"}}, {3, {4, "four"}}};
+  REQUIRE(::round_trip(map, {{5, {6, "six"}}}) == map);
+}
+
+TEST_CASE("An lru_table can be checkpointed")
+{
+  champsim::msl::lru_table<::type_with_getters> table{2, 2};
+  for (unsigned int i : {0u, 1u, 2u, 3u}) {
+    table.fill({i});
+  }
+
+  champsim::msl::lru_table<::type_with_getters> restored{2, 2};
+  std::stringstream stream;
+  champsim::msl::checkpoint(stream, table);
+  champsim::msl::restore(stream, restored);
+
+  for (unsigned int i : {0u, 1u, 2u, 3u}) {
+    REQUIRE(restored.check_hit({i}).has_value());
+  }
+  REQUIRE_FALSE(restored.check_hit({4u}).has_value());
+}
+
+TEST_CASE("An lru_table cannot be restored into a table of a different shape")
+{
+  champsim::msl::lru_table<::type_with_getters> table{2, 2};
+  champsim::msl::lru_table<::type_with_getters> restored{4, 2};
+  std::stringstream stream;
+  champsim::msl::checkpoint(stream, table);
+  REQUIRE_THROWS_AS(champsim::msl::restore(stream, restored), std::runtime_error);
+}
+
+TEST_CASE("A truncated checkpoint is detected")
+{
+  std::stringstream stream;
+  champsim::msl::checkpoint(stream, std::vector<int>{1, 2, 3, 4});
+  std::stringstream truncated{stream.str().substr(0, 12)};
+
+  std::vector<int> result;
+  REQUIRE_THROWS_AS(champsim::msl::restore(truncated, result), std::runtime_error);
+}
+
+TEST_CASE("Checkpoint blocks with a different label are skipped")
+{
+  std::stringstream stream;
+  champsim::msl::checkpoint_block(stream, "first", [](std::ostream& block) { champsim::msl::checkpoint(block, 1); });
+  champsim::msl::checkpoint_block(stream, "second", [](std::ostream& block) { champsim::msl::checkpoint(block, 2); });
+
+  int value = 0;
+  REQUIRE_FALSE(champsim::msl::restore_block(stream, "other", [&](std::istream& block) { champsim::msl::restore(block, value); }));
+  REQUIRE(champsim::msl::restore_block(stream, "second", [&](std::istream& block) { champsim::msl::restore(block, value); }));
+  REQUIRE(value == 2);
+  REQUIRE_FALSE(champsim::msl::restore_block(stream, "third", [&](std::istream& block) { champsim::msl::restore(block, value); }));
+}
+
+TEST_CASE("A checkpoint can only be restored after skipping the same number of instructions")
+{
+  ::dram_only_environment saved;
+  std::stringstream stream;
+  champsim::save_checkpoint(stream, saved, 1000);
+
+  std::vector<champsim::tracereader> traces{};
+  ::dram_only_environment same_skip;
+  std::stringstream same_skip_stream{stream.str()};
+  REQUIRE_NOTHROW(champsim::restore_checkpoint(same_skip_stream, same_skip, traces, {}, 1000));
+
+  ::dram_only_environment other_skip;
+  std::stringstream other_skip_stream{stream.str()};
+  REQUIRE_THROWS_AS(champsim::restore_checkpoint(other_skip_stream, other_skip, traces, {}, 2000), std::runtime_error);
+}
+
+TEST_CASE("A checkpoint whose component state is missing is not restored")
+{
+  ::dram_only_environment saved;
+  std::stringstream stream;
+  champsim::save_checkpoint(stream, saved, 0);
+
+  // Relabel the block of the only component, as if the blocks were out of order
+  std::stringstream first_label;
+  champsim::msl::checkpoint(first_label, std::string{"0"});
+  std::stringstream other_label;
+  champsim::msl::checkpoint(other_label, std::string{"1"});
+  auto contents = stream.str();
+  auto label_pos = contents.find(first_label.str());
+  REQUIRE(label_pos != std::string::npos);
+  contents.replace(label_pos, std::size(first_label.str()), other_label.str());
+
+  std::vector<champsim::tracereader> traces{};
+  ::dram_only_environment restored;
+  std::stringstream relabelled{contents};
+  REQUIRE_THROWS_AS(champsim::restore_checkpoint(relabelled, restored, traces, {}, 0), std::runtime_error);
+}
@@ -0,0 +1,68 @@
+#include <catch.hpp>
+
+#include "stack_distance.h"
+
+TEST_CASE("The first access to a block has an infinite stack distance")
+{
+  champsim::stack_distance_profiler uut{1};
+  REQUIRE(uut.access(0xdead) == champsim::stack_distance_profiler::cold);
+  REQUIRE(uut.access(0xbeef) == champsim::stack_distance_profiler::cold);
+}
+
+TEST_CASE("The stack distance counts the distinct blocks accessed since the last access")
+{
+  champsim::stack_distance_profiler uut{1};
+  uut.access(1);
+  uut.access(2);
+  uut.access(3);
+  uut.access(2);
+  REQUIRE(uut.access(1) == 2);
+  REQUIRE(uut.access(1) == 0);
+  REQUIRE(uut.access(3) == 2);
+}
+
+TEST_CASE("The stack distance is exact over many accesses")
+{
+  constexpr uint64_t footprint = 5000;
+  champsim::stack_distance_profiler uut{1};
+  for (uint64_t i = 0; i < footprint; ++i) {
+    uut.access(i);
+  }
+
+  // A cyclic sweep has the distance of the whole footprint, less the block itself
+  for (int pass = 0; pass < 3; ++pass) {
+    for (uint64_t i = 0; i < footprint; ++i) {
+      REQUIRE(uut.access(i) == static_cast<long>(footprint - 1));
+    }
+  }
+}
+
+TEST_CASE("The stack distance profiler samples a fraction of the blocks")
+{
+  constexpr uint64_t footprint = 100000;
+  champsim::stack_distance_profiler uut{0.1};
+
+  long sampled = 0;
+  for (uint64_t i = 0; i < footprint; ++i) {
+    if (uut.access(i).has_value()) {
+      ++sampled;
+    }
+  }
+  CHECK(sampled > 9000);
+  CHECK(sampled < 11000);
+
+  // Sampling is by block, so every access to a sampled block is sampled, and distances are scaled back up
+  for (uint64_t i = 0; i < footprint; ++i) {
+    if (auto distance = uut.access(i); distance.has_value()) {
+      CHECK(distance.value() > static_cast<long>(9 * footprint / 10));
+      CHECK(distance.value() < static_cast<long>(11 * footprint / 10));
+    }
+  }
+}
+
+TEST_CASE("Stack distances are rounded up to the next size at which they hit")
+{
+  auto [distance, size] = GENERATE(table<long, long>({{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 6}, {5, 6}, {6, 8}, {8, 12}, {12, 16}, {1000, 1024}, {1024, 1536}}));
+  REQUIRE(champsim::stack_distance_profiler::hitting_size(distance) == size);
+  REQUIRE(champsim::stack_distance_profiler::hitting_size(champsim::stack_distance_profiler::cold) == champsim::stack_distance_profiler::cold);
+}
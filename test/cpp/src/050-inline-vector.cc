@@ -0,0 +1,49 @@
+#include <catch.hpp>
+#include <iterator>
+#include <stdexcept>
+
+#include "util/inline_vector.h"
+
+TEST_CASE("An inline vector holds the elements added to it in order")
+{
+  champsim::inline_vector<int, 4> uut;
+  REQUIRE(std::empty(uut));
+
+  uut.push_back(3);
+  uut.emplace_back(5);
+  std::fill_n(std::back_inserter(uut), 2, 7);
+  REQUIRE(std::size(uut) == 4);
+  REQUIRE(uut == champsim::inline_vector<int, 4>{3, 5, 7, 7});
+  REQUIRE(uut.front() == 3);
+  REQUIRE(uut.back() == 7);
+}
+
+TEST_CASE("An inline vector cannot grow past its capacity")
+{
+  champsim::inline_vector<int, 2> uut{1, 2};
+  REQUIRE_THROWS_AS(uut.push_back(3), std::length_error);
+  REQUIRE_THROWS_AS(uut.at(2), std::out_of_range);
+  REQUIRE(std::size(uut) == 2);
+}
+
+TEST_CASE("An inline vector can erase a range of its elements")
+{
+  champsim::inline_vector<int, 4> uut{1, 2, 3, 4};
+  auto it = uut.erase(std::next(std::begin(uut)), std::next(std::begin(uut), 3));
+  REQUIRE(*it == 4);
+  REQUIRE(uut == champsim::inline_vector<int, 4>{1, 4});
+
+  uut.clear();
+  REQUIRE(std::empty(uut));
+  REQUIRE(std::begin(uut) == std::end(uut));
+}
+
+TEST_CASE("Copies of an inline vector are independent")
+{
+  champsim::inline_vector<int, 4> first{1, 2};
+  auto second = first;
+  second.push_back(3);
+  second.at(0) = 9;
+  REQUIRE(first == champsim::inline_vector<int, 4>{1, 2});
+  REQUIRE(second == champsim::inline_vector<int, 4>{9, 2, 3});
+}
@@ -0,0 +1,94 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "util/circular_buffer.h"
+
+TEST_CASE("A circular buffer holds the elements added to it in order")
+{
+  champsim::circular_buffer<int> uut{4};
+  REQUIRE(std::empty(uut));
+
+  uut.push_back(3);
+  uut.emplace_back(5);
+  std::fill_n(std::back_inserter(uut), 2, 7);
+  REQUIRE(std::size(uut) == 4);
+  REQUIRE(std::vector<int>(std::begin(uut), std::end(uut)) == std::vector<int>{3, 5, 7, 7});
+  REQUIRE(uut.front() == 3);
+  REQUIRE(uut.back() == 7);
+  REQUIRE(uut[1] == 5);
+  REQUIRE_THROWS_AS(uut.at(4), std::out_of_range);
+}
+
+TEST_CASE("A circular buffer reuses the slots freed at its front")
+{
+  champsim::circular_buffer<int> uut{4};
+  REQUIRE(uut.capacity() == 4);
+
+  for (int i = 0; i < 100; ++i) {
+    uut.push_back(i);
+    if (std::size(uut) == 4) {
+      uut.pop_front();
+    }
+  }
+
+  REQUIRE(uut.capacity() == 4);
+  REQUIRE(std::vector<int>(std::begin(uut), std::end(uut)) == std::vector<int>{97, 98, 99});
+}
+
+TEST_CASE("A circular buffer grows past its capacity without reordering its elements")
+{
+  champsim::circular_buffer<int> uut{2};
+  uut.push_back(1);
+  uut.push_back(2);
+  uut.pop_front();
+  uut.push_back(3);
+  uut.push_back(4);
+  uut.push_back(5);
+
+  REQUIRE(uut.capacity() >= 4);
+  REQUIRE(std::vector<int>(std::begin(uut), std::end(uut)) == std::vector<int>{2, 3, 4, 5});
+}
+
+TEST_CASE("A circular buffer can erase and insert ranges of its elements")
+{
+  champsim::circular_buffer<int> uut{8};
+  std::vector<int> init{1, 2, 3, 4, 5};
+  uut.insert(std::end(uut), std::begin(init), std::end(init));
+
+  auto it = uut.erase(std::next(std::cbegin(uut)), std::next(std::cbegin(uut), 3));
+  REQUIRE(*it == 4);
+  REQUIRE(std::vector<int>(std::begin(uut), std::end(uut)) == std::vector<int>{1, 4, 5});
+
+  it = uut.erase(std::cbegin(uut), std::next(std::cbegin(uut)));
+  REQUIRE(*it == 4);
+
+  std::vector<int> middle{8, 9};
+  uut.insert(std::next(std::cbegin(uut)), std::begin(middle), std::end(middle));
+  REQUIRE(std::vector<int>(std::begin(uut), std::end(uut)) == std::vector<int>{4, 8, 9, 5});
+
+  uut.clear();
+  REQUIRE(std::empty(uut));
+  REQUIRE(std::begin(uut) == std::end(uut));
+}
+
+TEST_CASE("An element of a circular buffer can be found again by its position")
+{
+  champsim::circular_buffer<int> uut{2};
+  uut.push_back(10);
+  uut.push_back(11);
+  auto position = uut.position_of(std::next(std::cbegin(uut)));
+
+  uut.pop_front();
+  uut.push_back(12);
+  uut.push_back(13); // grows the buffer
+
+  auto found = uut.find_position(position);
+  REQUIRE(found != std::end(uut));
+  REQUIRE(*found == 11);
+
+  uut.pop_front();
+  REQUIRE(uut.find_position(position) == std::end(uut));
+}
@@ -0,0 +1,91 @@
+#include <catch.hpp>
+
+#include "tag_array.h"
+
+namespace
+{
+champsim::cache_block make_block(bool valid, bool dirty = false, bool prefetch = false)
+{
+  champsim::cache_block block;
+  block.valid = valid;
+  block.dirty = dirty;
+  block.prefetch = prefetch;
+  return block;
+}
+} // namespace
+
+TEST_CASE("A tag array finds the valid way that holds a tag")
+{
+  auto num_way = GENERATE(as<std::size_t>{}, 1, 3, 4, 16, 70);
+  champsim::tag_array uut{4, num_way};
+  const auto last_way = static_cast<long>(num_way) - 1;
+
+  REQUIRE(uut.find(2, 0xdead) == static_cast<long>(num_way));
+
+  uut.update(2, last_way, 0xdead, make_block(true));
+  REQUIRE(uut.find(2, 0xdead) == last_way);
+  REQUIRE(uut.find(1, 0xdead) == static_cast<long>(num_way));
+  REQUIRE(uut.find(3, 0xdead) == static_cast<long>(num_way));
+  REQUIRE(uut.find(2, 0xbeef) == static_cast<long>(num_way));
+
+  uut.update(2, 0, 0xdead, make_block(true));
+  REQUIRE(uut.find(2, 0xdead) == 0);
+}
+
+TEST_CASE("A tag array does not find invalid ways in a lookup")
+{
+  auto num_way = GENERATE(as<std::size_t>{}, 1, 5, 16, 70);
+  champsim::tag_array uut{2, num_way};
+  const auto last_way = static_cast<long>(num_way) - 1;
+
+  uut.update(1, last_way, 0xdead, make_block(false));
+  REQUIRE(uut.find(1, 0xdead) == static_cast<long>(num_way));
+  REQUIRE(uut.find_any(1, 0xdead) == last_way);
+}
+
+TEST_CASE("A tag array finds the first invalid way")
+{
+  auto num_way = GENERATE(as<std::size_t>{}, 1, 6, 16, 70);
+  champsim::tag_array uut{2, num_way};
+
+  for (long way = 0; way < static_cast<long>(num_way); ++way) {
+    REQUIRE(uut.find_invalid(0) == way);
+    uut.update(0, way, 0, make_block(true));
+  }
+  REQUIRE(uut.find_invalid(0) == static_cast<long>(num_way));
+  REQUIRE(uut.find_invalid(1) == 0);
+}
+
+TEST_CASE("A tag array holds the state bits of each way")
+{
+  champsim::tag_array uut{2, 8};
+
+  uut.update(1, 3, 0xdead, make_block(true, true, false));
+  uut.update(1, 4, 0xbeef, make_block(true, false, true));
+
+  CHECK(uut.is_valid(1, 3));
+  CHECK(uut.is_dirty(1, 3));
+  CHECK_FALSE(uut.is_prefetch(1, 3));
+  CHECK(uut.is_valid(1, 4));
+  CHECK_FALSE(uut.is_dirty(1, 4));
+  CHECK(uut.is_prefetch(1, 4));
+  CHECK_FALSE(uut.is_valid(0, 3));
+
+  uut.update(1, 3, 0xdead, make_block(false));
+  CHECK_FALSE(uut.is_valid(1, 3));
+  CHECK_FALSE(uut.is_dirty(1, 3));
+}
+
+TEST_CASE("A tag array matches the block it was last updated with")
+{
+  champsim::tag_array uut{2, 4};
+  const auto block = make_block(true, true, false);
+  uut.update(1, 2, 0xdead, block);
+
+  REQUIRE(uut.matches(1, 2, 0xdead, block));
+  REQUIRE_FALSE(uut.matches(1, 2, 0xbeef, block));
+  REQUIRE_FALSE(uut.matches(1, 2, 0xdead, make_block(true, false, false)));
+  REQUIRE_FALSE(uut.matches(1, 2, 0xdead, make_block(false, true, false)));
+  REQUIRE_FALSE(uut.matches(1, 2, 0xdead, make_block(true, true, true)));
+  REQUIRE_FALSE(uut.matches(0, 2, 0xdead, block));
+}
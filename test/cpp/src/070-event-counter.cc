@@ -69,3 +69,27 @@ TEST_CASE("Two event counters can be subtracted")
   rhs.set(key, rhs_value);
   REQUIRE((lhs - rhs).at(key) == lhs_value - rhs_value);
 }
+
+TEST_CASE("Adding event counters includes keys from both")
+{
+  champsim::stats::event_counter<int> lhs{};
+  champsim::stats::event_counter<int> rhs{};
+  lhs.set(1, 10);
+  rhs.set(1, 5);
+  rhs.set(2, 7);
+
+  auto sum = lhs + rhs;
+  REQUIRE(sum.at(1) == 15);
+  REQUIRE(sum.at(2) == 7);
+}
+
+TEST_CASE("An event counter can be scaled")
+{
+  champsim::stats::event_counter<int> uut{};
+  uut.set(1, 10);
+  uut.set(2, 3);
+
+  auto scaled = uut * 0.5;
+  REQUIRE(scaled.at(1) == 5);
+  REQUIRE(scaled.at(2) == 2);
+}
@@ -0,0 +1,108 @@
+#include <catch.hpp>
+#include <sstream>
+#include <stdexcept>
+
+#include "cache.h"
+#include "dram_controller.h"
+#include "ooo_cpu.h"
+#include "phase_info.h"
+
+TEST_CASE("A region file is read in order of the starting instruction")
+{
+  std::istringstream region_file{"# start length weight\n500 100 0.25\n\n100 200 0.75\n"};
+  auto regions = champsim::read_regions(region_file);
+
+  REQUIRE(std::size(regions) == 2);
+  CHECK(regions.at(0).start == 100);
+  CHECK(regions.at(0).length == 200);
+  CHECK(regions.at(0).weight == 0.75);
+  CHECK(regions.at(1).start == 500);
+  CHECK(regions.at(1).length == 100);
+  CHECK(regions.at(1).weight == 0.25);
+}
+
+TEST_CASE("A malformed region file is rejected")
+{
+  auto contents = GENERATE(as<std::string>{}, "100 200\n", "100 200 0.5 extra\n", "100 0 0.5\n", "100 200 0.5\n250 100 0.5\n");
+  std::istringstream region_file{contents};
+  REQUIRE_THROWS_AS(champsim::read_regions(region_file), std::invalid_argument);
+}
+
+TEST_CASE("Each region is warmed up and fast-forwarded to")
+{
+  std::vector<champsim::region_info> regions{{1000, 200, 0.25}, {1250, 100, 0.75}};
+  auto phases = champsim::region_phases(regions, 100, {"trace.xz"});
+
+  REQUIRE(std::size(phases) == 4);
+
+  CHECK(phases.at(0).is_warmup);
+  CHECK(phases.at(0).fast_forward == 900);
+  CHECK(phases.at(0).length == 100);
+
+  CHECK_FALSE(phases.at(1).is_warmup);
+  CHECK(phases.at(1).fast_forward == 0);
+  CHECK(phases.at(1).length == 200);
+  CHECK(phases.at(1).weight == 0.25);
+
+  // The second warmup cannot begin until the first region ends
+  CHECK(phases.at(2).is_warmup);
+  CHECK(phases.at(2).fast_forward == 0);
+  CHECK(phases.at(2).length == 50);
+
+  CHECK_FALSE(phases.at(3).is_warmup);
+  CHECK(phases.at(3).length == 100);
+  CHECK(phases.at(3).weight == 0.75);
+}
+
+TEST_CASE("A region that would have no warmup after the previous region is rejected")
+{
+  SECTION("The regions are adjacent")
+  {
+    std::vector<champsim::region_info> regions{{1000, 200, 0.5}, {1200, 100, 0.5}};
+    REQUIRE_THROWS_AS(champsim::region_phases(regions, 100, {"trace.xz"}), std::invalid_argument);
+  }
+
+  SECTION("The warmup length is zero")
+  {
+    std::vector<champsim::region_info> regions{{1000, 200, 0.5}, {2000, 100, 0.5}};
+    REQUIRE_THROWS_AS(champsim::region_phases(regions, 0, {"trace.xz"}), std::invalid_argument);
+  }
+}
+
+TEST_CASE("The first region may begin without a warmup")
+{
+  std::vector<champsim::region_info> regions{{0, 200, 0.5}, {1000, 100, 0.5}};
+  auto phases = champsim::region_phases(regions, 100, {"trace.xz"});
+
+  REQUIRE(std::size(phases) == 4);
+  CHECK(phases.at(0).length == 0);
+  CHECK(phases.at(2).length == 100);
+}
+
+TEST_CASE("Phase statistics are combined by their relative weights")
+{
+  champsim::phase_stats first;
+  first.weight = 1;
+  first.sim_cpu_stats.push_back(O3_CPU::stats_type{});
+  first.sim_cpu_stats.back().end_instrs = 1000;
+  first.sim_cpu_stats.back().end_cycles = 4000;
+  first.sim_cache_stats.push_back(CACHE::stats_type{});
+  first.sim_cache_stats.back().pf_issued = 100;
+
+  champsim::phase_stats second;
+  second.weight = 3;
+  second.sim_cpu_stats.push_back(O3_CPU::stats_type{});
+  second.sim_cpu_stats.back().begin_instrs = 5000;
+  second.sim_cpu_stats.back().end_instrs = 7000;
+  second.sim_cpu_stats.back().end_cycles = 2000;
+  second.sim_cache_stats.push_back(CACHE::stats_type{});
+  second.sim_cache_stats.back().pf_issued = 20;
+
+  auto combined = champsim::weighted_phase_stats("Weighted", {first, second});
+  CHECK(combined.name == "Weighted");
+  REQUIRE(std::size(combined.sim_cpu_stats) == 1);
+  CHECK(combined.sim_cpu_stats.at(0).instrs() == 1750);
+  CHECK(combined.sim_cpu_stats.at(0).cycles() == 2500);
+  REQUIRE(std::size(combined.sim_cache_stats) == 1);
+  CHECK(combined.sim_cache_stats.at(0).pf_issued == 40);
+}
@@ -21,20 +21,28 @@ TEST_CASE("A single tracereader produces monotonically increasing instruction ID
   REQUIRE_THAT(ids, champsim::test::MonotonicallyIncreasingMatcher{});
 }
 
-TEST_CASE("Two tracereaders produce monotonically increasing instruction IDs")
+TEST_CASE("Two tracereaders produce disjoint, monotonically increasing instruction IDs")
 {
   champsim::tracereader uuta{[]() {
     return ooo_model_instr{0, input_instr{}};
-  }};
+  }, 0, 2};
   champsim::tracereader uutb{[]() {
     return ooo_model_instr{0, input_instr{}};
-  }};
+  }, 1, 2};
 
-  std::vector<std::invoke_result_t<decltype(uuta)>> generated_instrs{};
-  std::generate_n(std::back_inserter(generated_instrs), 10, std::ref(uuta));
-  std::generate_n(std::back_inserter(generated_instrs), 10, std::ref(uutb));
-  std::vector<uint64_t> ids{};
-  std::transform(std::begin(generated_instrs), std::end(generated_instrs), std::back_inserter(ids), [](const auto& x) { return x.instr_id; });
+  std::vector<std::invoke_result_t<decltype(uuta)>> generated_instrs_a{};
+  std::vector<std::invoke_result_t<decltype(uutb)>> generated_instrs_b{};
+  std::generate_n(std::back_inserter(generated_instrs_a), 10, std::ref(uuta));
+  std::generate_n(std::back_inserter(generated_instrs_b), 10, std::ref(uutb));
+  std::vector<uint64_t> ids_a{};
+  std::vector<uint64_t> ids_b{};
+  std::transform(std::begin(generated_instrs_a), std::end(generated_instrs_a), std::back_inserter(ids_a), [](const auto& x) { return x.instr_id; });
+  std::transform(std::begin(generated_instrs_b), std::end(generated_instrs_b), std::back_inserter(ids_b), [](const auto& x) { return x.instr_id; });
 
-  REQUIRE_THAT(ids, champsim::test::MonotonicallyIncreasingMatcher{});
+  REQUIRE_THAT(ids_a, champsim::test::MonotonicallyIncreasingMatcher{});
+  REQUIRE_THAT(ids_b, champsim::test::MonotonicallyIncreasingMatcher{});
+
+  std::vector<uint64_t> common{};
+  std::set_intersection(std::begin(ids_a), std::end(ids_a), std::begin(ids_b), std::end(ids_b), std::back_inserter(common));
+  REQUIRE(std::empty(common));
 }
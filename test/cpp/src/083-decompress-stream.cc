@@ -108,3 +108,37 @@ TEST_CASE("An inf_stream can inflate a bz2-compressed text")
   comp_stream.read(inflated, static_cast<std::streamsize>(std::size(plaintext)));
   REQUIRE_THAT(std::string{inflated}, Catch::Matchers::Equals(plaintext));
 }
+
+TEST_CASE("An inf_stream can inflate a multi-block xz text with several threads")
+{
+  std::string longtext;
+  for (int i = 0; i < 200; ++i) {
+    longtext += plaintext;
+  }
+
+  // Compress in small blocks, as xz -T does for large files
+  lzma_mt encoder_options{};
+  encoder_options.threads = 2;
+  encoder_options.block_size = 4096;
+  encoder_options.preset = LZMA_PRESET_DEFAULT;
+  encoder_options.check = LZMA_CHECK_CRC64;
+  lzma_stream encoder = LZMA_STREAM_INIT;
+  REQUIRE(::lzma_stream_encoder_mt(&encoder, &encoder_options) == LZMA_OK);
+
+  std::string cyphertext(std::size(longtext) + 4096, '\0');
+  encoder.next_in = reinterpret_cast<const uint8_t*>(std::data(longtext));
+  encoder.avail_in = std::size(longtext);
+  encoder.next_out = reinterpret_cast<uint8_t*>(std::data(cyphertext));
+  encoder.avail_out = std::size(cyphertext);
+  REQUIRE(::lzma_code(&encoder, LZMA_FINISH) == LZMA_STREAM_END);
+  cyphertext.resize(encoder.total_out);
+  ::lzma_end(&encoder);
+
+  auto threads = GENERATE(1u, 4u);
+  champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>, std::istringstream> comp_stream{std::istringstream{cyphertext}, threads};
+
+  std::string inflated(std::size(longtext), '\0');
+  comp_stream.read(std::data(inflated), static_cast<std::streamsize>(std::size(inflated)));
+  REQUIRE(comp_stream.gcount() == static_cast<std::streamsize>(std::size(longtext)));
+  REQUIRE(inflated == longtext);
+}
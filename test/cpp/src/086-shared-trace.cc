@@ -0,0 +1,283 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "batch.h"
+#include "compact_trace.h"
+#include "shared_trace.h"
+#include "tracereader.h"
+
+namespace
+{
+auto make_source(std::string contents, bool repeat, uint64_t max_lag = champsim::shared_trace_source::default_max_lag,
+                 std::shared_ptr<int> opened = std::make_shared<int>(0))
+{
+  auto opener = [contents, opened]() -> std::unique_ptr<champsim::shared_trace_source::stream_concept> {
+    ++(*opened);
+    return std::make_unique<champsim::shared_trace_source::stream_model<std::istringstream>>(std::istringstream{contents});
+  };
+  return std::make_shared<champsim::shared_trace_source>("test", opener, repeat, max_lag);
+}
+
+std::string make_contents(std::size_t size)
+{
+  std::string contents(size, '\0');
+  for (std::size_t i = 0; i < std::size(contents); ++i) {
+    contents.at(i) = static_cast<char>(i % 251);
+  }
+  return contents;
+}
+
+// A stream of bytes that are computed rather than stored, so that a test can read hundreds of MiB. Like a file with a seek table,
+// it skips without producing the bytes it passes over.
+struct generated_stream {
+  uint64_t size;
+  std::shared_ptr<uint64_t> bytes_produced;
+  uint64_t position = 0;
+  std::streamsize gcount_ = 0;
+  bool eof_ = false;
+
+  generated_stream& read(char* s, std::streamsize count)
+  {
+    gcount_ = static_cast<std::streamsize>(std::min<uint64_t>(static_cast<uint64_t>(count), size - position));
+    for (std::streamsize i = 0; i < gcount_; ++i) {
+      *std::next(s, i) = static_cast<char>((position + static_cast<uint64_t>(i)) % 251);
+    }
+    position += static_cast<uint64_t>(gcount_);
+    *bytes_produced += static_cast<uint64_t>(gcount_);
+    eof_ = (gcount_ < count);
+    return *this;
+  }
+
+  uint64_t skip(uint64_t count)
+  {
+    auto skipped = std::min(count, size - position);
+    position += skipped;
+    eof_ = (skipped < count);
+    return skipped;
+  }
+
+  [[nodiscard]] std::streamsize gcount() const { return gcount_; }
+  [[nodiscard]] bool eof() const { return eof_; }
+};
+
+struct temporary_file {
+  std::string name = "/tmp/champsim-shared-trace-XXXXXX";
+  explicit temporary_file(const std::string& contents)
+  {
+    ::close(::mkstemp(std::data(name)));
+    std::ofstream{name, std::ios::binary} << contents;
+  }
+  ~temporary_file() { std::remove(name.c_str()); }
+};
+
+std::string make_trace(std::size_t count)
+{
+  std::string contents(count * sizeof(input_instr), '\0');
+  for (std::size_t i = 0; i < count; ++i) {
+    input_instr record{};
+    record.ip = 0x1000 + 4 * i;
+    record.is_branch = (i % 3 == 0);
+    record.branch_taken = (i % 6 == 0);
+    record.source_memory[0] = 0x80000 + 8 * i;
+    std::memcpy(std::next(std::data(contents), static_cast<long>(i * sizeof(input_instr))), &record, sizeof(input_instr));
+  }
+  return contents;
+}
+
+std::string make_cloudsuite_trace(std::size_t count)
+{
+  std::string contents(count * sizeof(cloudsuite_instr), '\0');
+  for (std::size_t i = 0; i < count; ++i) {
+    cloudsuite_instr record{};
+    record.ip = 0x1000 + 4 * i;
+    record.source_memory[0] = 0x80000 + 8 * i;
+    std::memcpy(std::next(std::data(contents), static_cast<long>(i * sizeof(cloudsuite_instr))), &record, sizeof(cloudsuite_instr));
+  }
+  return contents;
+}
+
+std::string read_all(champsim::shared_trace_source::reader& stream, std::size_t count)
+{
+  std::string result(count, '\0');
+  stream.read(std::data(result), static_cast<std::streamsize>(count));
+  result.resize(static_cast<std::size_t>(stream.gcount()));
+  return result;
+}
+} // namespace
+
+TEST_CASE("Readers of a shared trace each see all of its bytes")
+{
+  auto contents = make_contents(3 * champsim::shared_trace_source::chunk_size + 17);
+  auto opened = std::make_shared<int>(0);
+  auto source = make_source(contents, false, champsim::shared_trace_source::default_max_lag, opened);
+  auto first = champsim::shared_trace_source::join(source);
+  auto second = champsim::shared_trace_source::join(source);
+  REQUIRE(first.has_value());
+  REQUIRE(second.has_value());
+
+  REQUIRE(read_all(first.value(), 1000) == contents.substr(0, 1000));
+  REQUIRE(read_all(second.value(), std::size(contents)) == contents);
+  REQUIRE(read_all(first.value(), std::size(contents)) == contents.substr(1000));
+
+  CHECK(read_all(first.value(), 1).empty());
+  CHECK(first->eof());
+
+  // Neither reader fell far enough behind to need its own decompression
+  CHECK(*opened == 1);
+}
+
+TEST_CASE("A reader that falls too far behind a shared trace continues on its own")
+{
+  auto contents = make_contents(5 * champsim::shared_trace_source::chunk_size + 17);
+  auto opened = std::make_shared<int>(0);
+  auto source = make_source(contents, false, 1, opened);
+  auto leader = champsim::shared_trace_source::join(source);
+  auto lagging = champsim::shared_trace_source::join(source);
+  REQUIRE(leader.has_value());
+  REQUIRE(lagging.has_value());
+
+  REQUIRE(read_all(lagging.value(), 1000) == contents.substr(0, 1000));
+  REQUIRE(read_all(leader.value(), std::size(contents)) == contents);
+  REQUIRE(*opened == 1);
+
+  // The lagging reader decompresses the trace again, and sees the same bytes
+  REQUIRE(read_all(lagging.value(), std::size(contents)) == contents.substr(1000));
+  CHECK(*opened == 2);
+  CHECK(lagging->eof());
+}
+
+TEST_CASE("A reader that falls hundreds of MiB behind a shared trace resumes where it left off")
+{
+  constexpr uint64_t chunk_size = champsim::shared_trace_source::chunk_size;
+  constexpr uint64_t size = 300 * chunk_size + 17;
+  auto opened = std::make_shared<int>(0);
+  auto bytes_produced = std::make_shared<uint64_t>(0);
+  auto opener = [opened, bytes_produced]() -> std::unique_ptr<champsim::shared_trace_source::stream_concept> {
+    ++(*opened);
+    return std::make_unique<champsim::shared_trace_source::stream_model<generated_stream>>(generated_stream{size, bytes_produced});
+  };
+  auto source = std::make_shared<champsim::shared_trace_source>("test", opener, false);
+  auto leader = champsim::shared_trace_source::join(source);
+  auto lagging = champsim::shared_trace_source::join(source);
+  REQUIRE(leader.has_value());
+  REQUIRE(lagging.has_value());
+
+  auto matches_file = [](const std::string& bytes, uint64_t offset) {
+    for (std::size_t i = 0; i < std::size(bytes); ++i) {
+      if (bytes.at(i) != static_cast<char>((offset + i) % 251)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  REQUIRE(read_all(lagging.value(), 1000) == make_contents(1000));
+
+  uint64_t leader_position = 0;
+  while (!leader->eof()) {
+    auto bytes = read_all(leader.value(), chunk_size);
+    REQUIRE(matches_file(bytes, leader_position));
+    leader_position += std::size(bytes);
+  }
+  REQUIRE(leader_position == size);
+  REQUIRE(*bytes_produced == size);
+
+  // The lagging reader is detached, and its own stream begins at the end of the chunk it holds, not at the start of the file
+  auto resumed = read_all(lagging.value(), chunk_size);
+  REQUIRE(matches_file(resumed, 1000));
+  CHECK(*opened == 2);
+  CHECK(*bytes_produced == size + chunk_size);
+
+  uint64_t lagging_position = 1000 + std::size(resumed);
+  while (!lagging->eof()) {
+    auto bytes = read_all(lagging.value(), chunk_size);
+    REQUIRE(matches_file(bytes, lagging_position));
+    lagging_position += std::size(bytes);
+  }
+  CHECK(lagging_position == size);
+  CHECK(*bytes_produced == 2 * size - chunk_size);
+}
+
+TEST_CASE("A reader cannot join a shared trace after its beginning is released")
+{
+  auto source = make_source(std::string(2 * champsim::shared_trace_source::chunk_size, 'x'), false);
+  auto first = champsim::shared_trace_source::join(source);
+  REQUIRE(first.has_value());
+
+  (void)read_all(first.value(), champsim::shared_trace_source::chunk_size + 1);
+  REQUIRE_FALSE(champsim::shared_trace_source::join(source).has_value());
+}
+
+TEST_CASE("A repeating shared trace restarts at its end")
+{
+  auto source = make_source("abc", true);
+  auto uut = champsim::shared_trace_source::join(source);
+  REQUIRE(uut.has_value());
+
+  REQUIRE(read_all(uut.value(), 3) == "abc");
+  REQUIRE(read_all(uut.value(), 7) == "abcabca");
+  CHECK_FALSE(uut->eof());
+}
+
+TEST_CASE("Cores that run copies of one trace file read the same instructions as unshared readers")
+{
+  constexpr std::size_t count = 40000;
+  constexpr uint64_t skip = 1000;
+  temporary_file file{make_trace(count)};
+
+  // As in a rate-mode run, each core reads the file through the registry
+  champsim::shared_trace_registry registry;
+  std::vector<champsim::tracereader> shared{};
+  shared.push_back(get_tracereader(registry.join(file.name, false, false), 0, false));
+  shared.push_back(get_tracereader(registry.join(file.name, false, false), 1, false));
+  auto expected = get_tracereader(file.name, 0, false, false);
+
+  for (auto& trace : shared) {
+    REQUIRE(trace.skip(skip) == skip);
+  }
+  REQUIRE(expected.skip(skip) == skip);
+
+  while (!expected.eof()) {
+    auto expected_instr = expected();
+    for (auto& trace : shared) {
+      REQUIRE_FALSE(trace.eof());
+      auto instr = trace();
+      REQUIRE(instr.ip == expected_instr.ip);
+      REQUIRE(instr.branch_taken == expected_instr.branch_taken);
+      REQUIRE(instr.source_memory == expected_instr.source_memory);
+    }
+  }
+}
+
+TEST_CASE("Cores that share a cloudsuite trace do not read it as a compact trace")
+{
+  constexpr std::size_t count = 1000;
+  auto contents = make_cloudsuite_trace(count);
+
+  // The first instruction pointer happens to spell the marker of a compact trace
+  std::memcpy(std::data(contents), std::data(champsim::compact_trace::magic), std::size(champsim::compact_trace::magic));
+  temporary_file file{contents};
+
+  champsim::shared_trace_registry registry;
+  std::vector<champsim::tracereader> shared{};
+  shared.push_back(get_tracereader(registry.join(file.name, true, false), 0, true));
+  shared.push_back(get_tracereader(registry.join(file.name, true, false), 1, true));
+  auto expected = get_tracereader(file.name, 0, true, false);
+
+  while (!expected.eof()) {
+    auto expected_instr = expected();
+    for (auto& trace : shared) {
+      REQUIRE_FALSE(trace.eof());
+      auto instr = trace();
+      REQUIRE(instr.ip == expected_instr.ip);
+      REQUIRE(instr.source_memory == expected_instr.source_memory);
+    }
+  }
+}
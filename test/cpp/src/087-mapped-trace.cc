@@ -0,0 +1,91 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "mapped_trace.h"
+#include "tracereader.h"
+
+namespace
+{
+struct temporary_file {
+  std::string name = "/tmp/champsim-mapped-trace-XXXXXX";
+  explicit temporary_file(const std::string& contents)
+  {
+    ::close(::mkstemp(std::data(name)));
+    std::ofstream{name, std::ios::binary} << contents;
+  }
+  ~temporary_file() { std::remove(name.c_str()); }
+};
+
+std::string make_trace(std::size_t count)
+{
+  std::string contents(count * sizeof(input_instr), '\0');
+  for (std::size_t i = 0; i < count; ++i) {
+    input_instr record{};
+    record.ip = 0x1000 + 4 * i;
+    record.is_branch = (i % 3 == 0);
+    record.branch_taken = (i % 6 == 0);
+    record.destination_registers[0] = static_cast<unsigned char>(i % 32 + 1);
+    record.source_memory[0] = 0x80000 + 8 * i;
+    std::memcpy(std::next(std::data(contents), static_cast<long>(i * sizeof(input_instr))), &record, sizeof(input_instr));
+  }
+  return contents;
+}
+} // namespace
+
+TEST_CASE("A mapped trace gives the bytes of its file in order")
+{
+  temporary_file file{"abcdefghij"};
+  champsim::mapped_trace uut{file.name};
+
+  auto [first, last] = uut.take(4);
+  REQUIRE(std::string(first, last) == "abcd");
+  REQUIRE_FALSE(uut.eof());
+
+  std::string buf(10, '\0');
+  uut.read(std::data(buf), 10);
+  REQUIRE(uut.gcount() == 6);
+  REQUIRE(buf.substr(0, 6) == "efghij");
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A mapped trace of an empty file is at its end")
+{
+  temporary_file file{""};
+  champsim::mapped_trace uut{file.name};
+
+  auto [first, last] = uut.take(64);
+  REQUIRE(first == last);
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A missing trace cannot be mapped")
+{
+  REQUIRE_THROWS_AS(champsim::mapped_trace{"/nonexistent/trace.champsimtrace"}, std::system_error);
+}
+
+TEST_CASE("A tracereader decodes the same instructions from a mapped trace as from a stream")
+{
+  constexpr std::size_t count = 1000;
+  auto contents = make_trace(count);
+  temporary_file file{contents};
+
+  champsim::bulk_tracereader<input_instr, champsim::mapped_trace> uut{0, champsim::mapped_trace{file.name}};
+  champsim::bulk_tracereader<input_instr, std::istringstream> expected{0, std::istringstream{contents}};
+
+  for (std::size_t i = 0; i < count - 1; ++i) {
+    auto instr = uut();
+    auto expected_instr = expected();
+    REQUIRE(instr.ip == expected_instr.ip);
+    REQUIRE(instr.is_branch == expected_instr.is_branch);
+    REQUIRE(instr.branch_taken == expected_instr.branch_taken);
+    REQUIRE(instr.branch_target == expected_instr.branch_target);
+    REQUIRE(instr.destination_registers == expected_instr.destination_registers);
+    REQUIRE(instr.source_memory == expected_instr.source_memory);
+  }
+  REQUIRE(uut.eof());
+}
@@ -0,0 +1,106 @@
+#include <catch.hpp>
+#include <stdexcept>
+
+#include "async_tracereader.h"
+#include "tracereader.h"
+
+namespace
+{
+struct counting_reader {
+  uint64_t next = 0;
+  uint64_t length;
+
+  explicit counting_reader(uint64_t len) : length(len) {}
+
+  ooo_model_instr operator()()
+  {
+    input_instr record{};
+    record.ip = next++;
+    return ooo_model_instr{0, record};
+  }
+
+  bool eof() const { return next == length; }
+};
+
+struct endless_reader {
+  ooo_model_instr operator()() { return ooo_model_instr{0, input_instr{}}; }
+};
+
+struct failing_reader {
+  uint64_t remaining = 10;
+  ooo_model_instr operator()()
+  {
+    if (remaining == 0) {
+      throw std::runtime_error{"trace is corrupt"};
+    }
+    --remaining;
+    return ooo_model_instr{0, input_instr{}};
+  }
+};
+} // namespace
+
+TEST_CASE("An asynchronous reader produces the instructions of its reader in order")
+{
+  constexpr uint64_t length = 5000;
+  champsim::async_tracereader uut{counting_reader{length}};
+
+  for (uint64_t i = 0; i < length; ++i) {
+    REQUIRE_FALSE(uut.eof());
+    REQUIRE(uut().ip == champsim::address{i});
+  }
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("An asynchronous reader of an empty trace is at its end")
+{
+  champsim::async_tracereader uut{counting_reader{0}};
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("An asynchronous reader can be moved")
+{
+  champsim::async_tracereader first{counting_reader{300}};
+  REQUIRE(first().ip == champsim::address{0});
+
+  auto second = std::move(first);
+  REQUIRE(second().ip == champsim::address{1});
+}
+
+TEST_CASE("An asynchronous reader can be destroyed while its producer is blocked")
+{
+  champsim::async_tracereader uut{endless_reader{}};
+  (void)uut();
+  REQUIRE_FALSE(uut.eof());
+}
+
+TEST_CASE("An asynchronous reader rethrows the failures of its reader")
+{
+  champsim::async_tracereader uut{failing_reader{}};
+  for (int i = 0; i < 10; ++i) {
+    (void)uut();
+  }
+  REQUIRE_THROWS_AS(uut(), std::runtime_error);
+}
+
+TEST_CASE("An asynchronous reader skips instructions in order")
+{
+  constexpr uint64_t length = 5000;
+  champsim::async_tracereader uut{counting_reader{length}};
+
+  REQUIRE(uut().ip == champsim::address{0});
+  REQUIRE(uut.skip(10) == 10);
+  REQUIRE(uut().ip == champsim::address{11});
+  REQUIRE(uut.skip(3000) == 3000);
+  REQUIRE(uut().ip == champsim::address{3012});
+  REQUIRE(uut.skip(length) == length - 3013);
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("Only traces that must be decompressed are read asynchronously")
+{
+  CHECK(champsim::reads_asynchronously("trace.champsimtrace.xz"));
+  CHECK(champsim::reads_asynchronously("trace.champsimtrace.gz"));
+  CHECK(champsim::reads_asynchronously("trace.champsimtrace.bz2"));
+  CHECK(champsim::reads_asynchronously("trace.champsimtrace.zst"));
+  CHECK_FALSE(champsim::reads_asynchronously("trace.champsimtrace"));
+}
@@ -0,0 +1,179 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+#include "inf_stream.h"
+#include "parallel_zstd.h"
+#include "seekable_zstd.h"
+
+namespace
+{
+struct temporary_file {
+  std::string name = "/tmp/champsim-zstd-XXXXXX";
+  explicit temporary_file(const std::string& contents)
+  {
+    ::close(::mkstemp(std::data(name)));
+    std::ofstream{name, std::ios::binary} << contents;
+  }
+  ~temporary_file() { std::remove(name.c_str()); }
+};
+
+std::string make_text(std::size_t length, unsigned seed)
+{
+  std::string text(length, '\0');
+  for (std::size_t i = 0; i < length; ++i) {
+    text.at(i) = static_cast<char>('a' + (i * seed + i / 7) % 26);
+  }
+  return text;
+}
+
+// Compress with the frame's decoded size recorded in its header
+std::string compress_frame(const std::string& text)
+{
+  std::string frame(::ZSTD_compressBound(std::size(text)), '\0');
+  frame.resize(::ZSTD_compress(std::data(frame), std::size(frame), std::data(text), std::size(text), 1));
+  return frame;
+}
+
+// Compress as a stream, without the frame's decoded size
+std::string deflate_frame(std::string text)
+{
+  using tag = champsim::decomp_tags::zstd_tag_t<>;
+  auto strm = tag::new_deflate_state();
+  std::string frame(::ZSTD_compressBound(std::size(text)) + 1024, '\0');
+  strm->next_in = reinterpret_cast<const unsigned char*>(std::data(text));
+  strm->avail_in = std::size(text);
+  strm->next_out = reinterpret_cast<unsigned char*>(std::data(frame));
+  strm->avail_out = std::size(frame);
+
+  REQUIRE(tag::deflate(strm, false) == champsim::decomp_tags::status_t::CAN_CONTINUE);
+  REQUIRE(tag::deflate(strm, true) == champsim::decomp_tags::status_t::END);
+  frame.resize(strm->total_out);
+  return frame;
+}
+
+std::string read_all(champsim::parallel_zstd_istream& stream)
+{
+  std::string result;
+  std::string buf(1000, '\0');
+  while (!stream.eof()) {
+    stream.read(std::data(buf), static_cast<std::streamsize>(std::size(buf)));
+    result.append(std::data(buf), static_cast<std::size_t>(stream.gcount()));
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("An inf_stream can inflate a zstd-compressed text")
+{
+  auto plaintext = make_text(100000, 3);
+  champsim::inf_istream<champsim::decomp_tags::zstd_tag_t<>, std::istringstream> comp_stream{std::istringstream{deflate_frame(plaintext)}};
+
+  STATIC_REQUIRE(std::is_move_constructible<decltype(comp_stream)>::value);
+  STATIC_REQUIRE(std::is_move_assignable<decltype(comp_stream)>::value);
+
+  std::string inflated(std::size(plaintext), '\0');
+  comp_stream.read(std::data(inflated), static_cast<std::streamsize>(std::size(plaintext)));
+  REQUIRE(comp_stream.gcount() == static_cast<std::streamsize>(std::size(plaintext)));
+  REQUIRE(inflated == plaintext);
+}
+
+TEST_CASE("An inf_stream inflates concatenated zstd frames in order")
+{
+  auto first = make_text(5000, 3);
+  auto second = make_text(7000, 5);
+  champsim::inf_istream<champsim::decomp_tags::zstd_tag_t<>, std::istringstream> comp_stream{
+      std::istringstream{compress_frame(first) + compress_frame(second)}};
+
+  std::string inflated(std::size(first) + std::size(second), '\0');
+  comp_stream.read(std::data(inflated), static_cast<std::streamsize>(std::size(inflated)));
+  REQUIRE(inflated == first + second);
+}
+
+TEST_CASE("A parallel zstd stream decodes every frame in order")
+{
+  auto threads = GENERATE(as<std::size_t>{}, 1, 2, 4);
+
+  std::string plaintext;
+  std::string compressed;
+  for (unsigned i = 0; i < 10; ++i) {
+    auto text = make_text(20000 + 1000 * i, i + 1);
+    plaintext += text;
+    // Frames without their decoded sizes are decoded on the reading thread, between the others
+    compressed += (i % 4 == 3) ? deflate_frame(text) : compress_frame(text);
+  }
+  temporary_file file{compressed};
+
+  champsim::parallel_zstd_istream uut{file.name, threads};
+  REQUIRE(read_all(uut) == plaintext);
+}
+
+TEST_CASE("A parallel zstd stream of an empty file is at its end")
+{
+  temporary_file file{""};
+  champsim::parallel_zstd_istream uut{file.name};
+  REQUIRE(read_all(uut).empty());
+}
+
+TEST_CASE("A seekable zstd trace can be read from any offset")
+{
+  auto plaintext = make_text(100000, 7);
+  std::ostringstream compressed;
+  champsim::seekable_zstd::writer writer{compressed, 4096};
+  writer.write(std::data(plaintext), std::size(plaintext));
+  writer.close();
+  temporary_file file{compressed.str()};
+
+  auto threads = GENERATE(as<std::size_t>{}, 1, 3);
+  champsim::parallel_zstd_istream uut{file.name, threads};
+  REQUIRE(uut.seekable());
+
+  auto offset = GENERATE(as<uint64_t>{}, 0, 1, 4095, 4096, 50000, 99999, 100000);
+  uut.seek(offset);
+  REQUIRE(read_all(uut) == plaintext.substr(offset));
+}
+
+TEST_CASE("A seekable zstd trace has one frame for each block of the input")
+{
+  auto plaintext = make_text(10000, 7);
+  std::ostringstream compressed;
+  champsim::seekable_zstd::writer writer{compressed, 4096};
+  writer.write(std::data(plaintext), std::size(plaintext));
+  writer.close();
+
+  auto contents = compressed.str();
+  auto frames = champsim::seekable_zstd::read_seek_table(std::data(contents), std::next(std::data(contents), static_cast<long>(std::size(contents))));
+  REQUIRE(std::size(frames) == 4);
+  REQUIRE(frames.at(1).decompressed_offset == 4096);
+  REQUIRE(frames.at(2).decompressed_offset == 8192);
+  REQUIRE(frames.at(3).decompressed_offset == 10000);
+}
+
+TEST_CASE("A zstd trace without a seek table cannot seek")
+{
+  temporary_file file{compress_frame(make_text(1000, 3))};
+  champsim::parallel_zstd_istream uut{file.name};
+  REQUIRE_FALSE(uut.seekable());
+  REQUIRE_THROWS_AS(uut.seek(10), std::logic_error);
+}
+
+TEST_CASE("A zstd trace can skip forward, with or without a seek table")
+{
+  auto plaintext = make_text(100000, 7);
+  std::ostringstream compressed;
+  champsim::seekable_zstd::writer writer{compressed, 4096};
+  writer.write(std::data(plaintext), std::size(plaintext));
+  writer.close();
+  temporary_file file{GENERATE(as<bool>{}, false, true) ? compressed.str() : compress_frame(plaintext)};
+  champsim::parallel_zstd_istream uut{file.name};
+
+  std::string buf(10, '\0');
+  uut.read(std::data(buf), 10);
+  REQUIRE(uut.skip(50000) == 50000);
+  REQUIRE(read_all(uut) == plaintext.substr(50010));
+  REQUIRE(uut.skip(10) == 0);
+}
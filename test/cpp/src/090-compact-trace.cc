@@ -0,0 +1,128 @@
+#include <catch.hpp>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "compact_trace.h"
+#include "tracereader.h"
+
+namespace
+{
+std::vector<input_instr> make_instructions(std::size_t count)
+{
+  std::vector<input_instr> retval;
+  for (std::size_t i = 0; i < count; ++i) {
+    input_instr record{};
+    record.ip = (i % 7 == 0) ? 0xffff'8000'0000'0000 - 4 * i : 0x401000 + 4 * i;
+    record.is_branch = (i % 3 == 0);
+    record.branch_taken = (i % 6 == 0);
+    record.destination_registers[0] = static_cast<unsigned char>(i % 5 + 1);
+    record.source_registers[1] = static_cast<unsigned char>(i % 300);
+    if (i % 2 == 0) {
+      record.source_memory[2] = 0x80000 + 8 * i;
+    }
+    if (i % 5 == 0) {
+      record.destination_memory[1] = 0x7fff'0000 - 64 * i;
+    }
+    retval.push_back(record);
+  }
+  return retval;
+}
+
+std::string encode(const std::vector<input_instr>& instrs)
+{
+  std::ostringstream out;
+  champsim::compact_trace::encoder encoder{out};
+  for (const auto& instr : instrs) {
+    encoder.write(instr);
+  }
+  return out.str();
+}
+
+std::string raw_bytes(const std::vector<input_instr>& instrs)
+{
+  std::string retval(std::size(instrs) * sizeof(input_instr), '\0');
+  std::memcpy(std::data(retval), std::data(instrs), std::size(retval));
+  return retval;
+}
+} // namespace
+
+TEST_CASE("A compact stream decodes the records that were encoded")
+{
+  auto instrs = make_instructions(1000);
+  auto encoded = encode(instrs);
+  REQUIRE(std::size(encoded) < std::size(instrs) * sizeof(input_instr) / 4);
+
+  champsim::compact_istream<std::istringstream> uut{std::istringstream{encoded}};
+  std::string decoded(std::size(instrs) * sizeof(input_instr) + 1, '\0');
+  uut.read(std::data(decoded), static_cast<std::streamsize>(std::size(decoded)));
+  REQUIRE(uut.gcount() == static_cast<std::streamsize>(std::size(instrs) * sizeof(input_instr)));
+  REQUIRE(uut.eof());
+  REQUIRE(decoded.substr(0, std::size(decoded) - 1) == raw_bytes(instrs));
+}
+
+TEST_CASE("A compact stream gives only whole records to each read")
+{
+  auto instrs = make_instructions(10);
+  champsim::compact_istream<std::istringstream> uut{std::istringstream{encode(instrs)}};
+
+  std::string decoded;
+  std::string buf(3 * sizeof(input_instr) + 7, '\0');
+  do {
+    uut.read(std::data(buf), static_cast<std::streamsize>(std::size(buf)));
+    REQUIRE(uut.gcount() % static_cast<std::streamsize>(sizeof(input_instr)) == 0);
+    decoded += buf.substr(0, static_cast<std::size_t>(uut.gcount()));
+  } while (uut.gcount() > 0);
+  REQUIRE(decoded == raw_bytes(instrs));
+}
+
+TEST_CASE("The compact encoding refers to repeated register sets by their index")
+{
+  std::vector<input_instr> instrs(2);
+  instrs.at(0).destination_registers[0] = 1;
+  instrs.at(1).destination_registers[0] = 1;
+  auto encoded = encode(instrs);
+
+  // Each record is a flags byte, a presence byte, and a one-byte delta, before its registers
+  REQUIRE(std::size(encoded) == std::size(champsim::compact_trace::magic) + (3 + 6) + (3 + 1));
+}
+
+TEST_CASE("A compact stream passes through a trace that is not compact")
+{
+  auto instrs = make_instructions(100);
+  auto contents = raw_bytes(instrs);
+
+  champsim::bulk_tracereader<input_instr, champsim::compact_istream<std::istringstream>> uut{
+      0, champsim::compact_istream<std::istringstream>{std::istringstream{contents}}};
+  champsim::bulk_tracereader<input_instr, std::istringstream> expected{0, std::istringstream{contents}};
+
+  for (std::size_t i = 0; i < std::size(instrs) - 1; ++i) {
+    auto instr = uut();
+    auto expected_instr = expected();
+    REQUIRE(instr.ip == expected_instr.ip);
+    REQUIRE(instr.branch_target == expected_instr.branch_target);
+    REQUIRE(instr.source_memory == expected_instr.source_memory);
+  }
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A compact stream passes through a trace shorter than the magic number")
+{
+  champsim::compact_istream<std::istringstream> uut{std::istringstream{"abc"}};
+  std::string buf(8, '\0');
+  uut.read(std::data(buf), 8);
+  REQUIRE(uut.gcount() == 3);
+  REQUIRE(buf.substr(0, 3) == "abc");
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A truncated compact trace is an error")
+{
+  auto encoded = encode(make_instructions(10));
+  encoded.pop_back();
+  champsim::compact_istream<std::istringstream> uut{std::istringstream{encoded}};
+
+  std::string buf(10 * sizeof(input_instr), '\0');
+  REQUIRE_THROWS_AS(uut.read(std::data(buf), static_cast<std::streamsize>(std::size(buf))), std::runtime_error);
+}
@@ -0,0 +1,109 @@
+#include <catch.hpp>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "repeatable.h"
+#include "tracereader.h"
+
+namespace
+{
+std::string make_trace(std::size_t count)
+{
+  std::string contents(count * sizeof(input_instr), '\0');
+  for (std::size_t i = 0; i < count; ++i) {
+    input_instr record{};
+    record.ip = 0x1000 + 4 * i;
+    record.is_branch = (i % 3 == 0);
+    record.branch_taken = (i % 6 == 0);
+    std::memcpy(std::next(std::data(contents), static_cast<long>(i * sizeof(input_instr))), &record, sizeof(input_instr));
+  }
+  return contents;
+}
+
+struct counting_reader {
+  uint64_t next = 0;
+  uint64_t length = 100;
+
+  ooo_model_instr operator()()
+  {
+    input_instr record{};
+    record.ip = next++;
+    return ooo_model_instr{0, record};
+  }
+
+  bool eof() const { return next == length; }
+};
+} // namespace
+
+TEST_CASE("A bulk tracereader resumes after a skip with the instructions that follow")
+{
+  constexpr std::size_t count = 1000;
+  auto contents = make_trace(count);
+  champsim::bulk_tracereader<input_instr, std::istringstream> uut{0, std::istringstream{contents}};
+  champsim::bulk_tracereader<input_instr, std::istringstream> expected{0, std::istringstream{contents}};
+
+  auto before = GENERATE(as<std::size_t>{}, 0, 1, 50, 127, 128);
+  auto skip = GENERATE(as<uint64_t>{}, 1, 5, 126, 127, 500);
+  for (std::size_t i = 0; i < before; ++i) {
+    (void)uut();
+    (void)expected();
+  }
+  REQUIRE(uut.skip(skip) == skip);
+  for (uint64_t i = 0; i < skip; ++i) {
+    (void)expected();
+  }
+
+  while (!expected.eof()) {
+    REQUIRE_FALSE(uut.eof());
+    auto instr = uut();
+    auto expected_instr = expected();
+    REQUIRE(instr.ip == expected_instr.ip);
+    REQUIRE(instr.branch_target == expected_instr.branch_target);
+  }
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A bulk tracereader stops skipping at the end of its trace")
+{
+  champsim::bulk_tracereader<input_instr, std::istringstream> uut{0, std::istringstream{make_trace(100)}};
+  (void)uut();
+
+  // As when reading, the last instruction is never given, because its branch target is unknown
+  REQUIRE(uut.skip(1000) == 99);
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A tracereader reads through the instructions of a reader that cannot skip")
+{
+  champsim::tracereader uut{counting_reader{}};
+  REQUIRE(uut.skip(10) == 10);
+
+  auto instr = uut();
+  REQUIRE(instr.ip == champsim::address{10});
+  REQUIRE(instr.instr_id == 0);
+  REQUIRE(uut.skip(1000) == 89);
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A repeatable reader restarts its trace while skipping")
+{
+  auto contents = make_trace(100);
+  champsim::repeatable<champsim::bulk_tracereader<input_instr, std::istringstream>, uint8_t, std::string> uut{0, contents};
+
+  // Each pass over the trace gives 99 instructions
+  REQUIRE(uut.skip(150) == 150);
+  REQUIRE(uut().ip == champsim::address{0x1000 + 4 * 51});
+}
+
+TEST_CASE("A tracereader numbers the instructions after a fast-forward as if they had been read")
+{
+  champsim::tracereader uut{counting_reader{}, 1, 2};
+  REQUIRE(uut.fast_forward(10) == 10);
+
+  auto instr = uut();
+  REQUIRE(instr.ip == champsim::address{10});
+  REQUIRE(instr.instr_id == 21);
+  REQUIRE(uut.fast_forward(1000) == 89);
+  REQUIRE(uut.eof());
+}
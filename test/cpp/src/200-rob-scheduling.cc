@@ -291,6 +291,64 @@ SCENARIO("The scheduler handles WAW hazards")
   }
 }
 
+SCENARIO("The scheduler wakes instructions when their producers complete")
+{
+  GIVEN("A ROB with a chain of three dependent instructions")
+  {
+    constexpr unsigned schedule_width = 128;
+    constexpr unsigned execute_width = 3;
+
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .schedule_width(champsim::bandwidth::maximum_type{schedule_width})
+                   .register_file_size(128)
+                   .execute_width(champsim::bandwidth::maximum_type{execute_width})
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)};
+
+    for (uint64_t id = 1; id <= 3; ++id) {
+      uut.ROB.push_back(champsim::test::instruction_with_ip(id));
+      uut.ROB.back().instr_id = id;
+      uut.ROB.back().destination_registers.push_back(static_cast<int16_t>(5 + id));
+      if (id > 1) {
+        uut.ROB.back().source_registers.push_back(static_cast<int16_t>(4 + id));
+      }
+      uut.ROB.back().ready_time = champsim::chrono::clock::time_point{};
+    }
+
+    WHEN("The instructions are scheduled")
+    {
+      for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("Each instruction is waiting on the one before it")
+      {
+        REQUIRE(uut.ROB.at(0).num_reg_dependent == 0);
+        REQUIRE(uut.ROB.at(1).num_reg_dependent == 1);
+        REQUIRE(uut.ROB.at(2).num_reg_dependent == 1);
+        REQUIRE(uut.ROB.at(0).registers_instrs_depend_on_me == std::vector<uint64_t>{uut.ROB.position_of(std::next(std::cbegin(uut.ROB), 1))});
+        REQUIRE(uut.ROB.at(1).registers_instrs_depend_on_me == std::vector<uint64_t>{uut.ROB.position_of(std::next(std::cbegin(uut.ROB), 2))});
+      }
+
+      AND_WHEN("The core runs until the last instruction executes")
+      {
+        for (int i = 0; i < 100 && !uut.ROB.back().executed; ++i) {
+          for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+            op->_operate();
+        }
+
+        THEN("The last instruction executed after its producers completed")
+        {
+          REQUIRE(uut.ROB.back().instr_id == 3);
+          REQUIRE(uut.ROB.back().executed);
+          REQUIRE(uut.ROB.back().num_reg_dependent == 0);
+          REQUIRE(std::all_of(std::begin(uut.ROB), std::prev(std::end(uut.ROB)), [](const auto& x) { return x.completed; }));
+        }
+      }
+    }
+  }
+}
+
 TEST_CASE("ooo_cpu Benchmarks") {
   BENCHMARK_ADVANCED("ooo_cpu::operate()")(Catch::Benchmark::Chronometer meter){
     constexpr unsigned schedule_width = 128;
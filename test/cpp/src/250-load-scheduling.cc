@@ -66,3 +66,141 @@ SCENARIO("The core issues loads only after its registers are finished")
     }
   }
 }
+
+SCENARIO("The core reuses a load queue entry after its load returns")
+{
+  GIVEN("Two independent loads and a load queue with one entry")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{2})
+                   .register_file_size(16)
+                   .rob_size(2)
+                   .lq_size(1)};
+
+    auto first = champsim::test::instruction_with_ip_and_source_memory(champsim::address{2000}, champsim::address{0xcafe0000});
+    first.instr_id = 1;
+    auto second = champsim::test::instruction_with_ip_and_source_memory(champsim::address{2004}, champsim::address{0xbeef0000});
+    second.instr_id = 2;
+
+    uut.DISPATCH_BUFFER.push_back(first);
+    uut.DISPATCH_BUFFER.push_back(second);
+    for (auto& instr : uut.DISPATCH_BUFFER)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The core runs until both instructions retire")
+    {
+      for (int i = 0; i < 10000 && uut.num_retired < 2; ++i) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("Both loads were issued through the same entry, which is now free")
+      {
+        REQUIRE(uut.num_retired == 2);
+        REQUIRE(mock_L1D.packet_count() == 2);
+        REQUIRE_FALSE(uut.LQ.at(0).has_value());
+      }
+    }
+  }
+}
+
+SCENARIO("A load forwards from the youngest prior store to its address")
+{
+  GIVEN("Two stores to the same address and a load from it")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{3})
+                   .register_file_size(16)
+                   .rob_size(3)
+                   .lq_size(1)
+                   .sq_size(2)};
+
+    auto first_store = champsim::test::instruction_with_ip(champsim::address{2000});
+    first_store.destination_memory.push_back(champsim::address{0xcafe0000});
+    first_store.instr_id = 1;
+    auto second_store = champsim::test::instruction_with_ip(champsim::address{2004});
+    second_store.destination_memory.push_back(champsim::address{0xcafe0000});
+    second_store.instr_id = 2;
+    auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{2008}, champsim::address{0xcafe0000});
+    load.instr_id = 3;
+
+    uut.DISPATCH_BUFFER.push_back(first_store);
+    uut.DISPATCH_BUFFER.push_back(second_store);
+    uut.DISPATCH_BUFFER.push_back(load);
+    for (auto& instr : uut.DISPATCH_BUFFER)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The load is dispatched")
+    {
+      for (int i = 0; i < 100 && !uut.LQ.at(0).has_value(); ++i) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("The load waits on the younger store")
+      {
+        REQUIRE(uut.LQ.at(0).has_value());
+        REQUIRE(uut.LQ.at(0)->producer_id == 2);
+      }
+    }
+
+    WHEN("The core runs until all instructions retire")
+    {
+      for (int i = 0; i < 10000 && uut.num_retired < 3; ++i) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("Only the stores are issued to the cache")
+      {
+        REQUIRE(uut.num_retired == 3);
+        REQUIRE(std::count(std::begin(mock_L1D.addresses), std::end(mock_L1D.addresses), champsim::address{0xcafe0000}) == 2);
+      }
+    }
+  }
+
+  GIVEN("A store and a load to different addresses in the same word")
+  {
+    do_nothing_MRC mock_L1I, mock_L1D;
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&mock_L1I.queues)
+                   .data_queues(&mock_L1D.queues)
+                   .dispatch_width(champsim::bandwidth::maximum_type{2})
+                   .register_file_size(16)
+                   .rob_size(2)
+                   .lq_size(1)
+                   .sq_size(1)};
+
+    auto store = champsim::test::instruction_with_ip(champsim::address{2000});
+    store.destination_memory.push_back(champsim::address{0xcafe0004});
+    store.instr_id = 1;
+    auto load = champsim::test::instruction_with_ip_and_source_memory(champsim::address{2004}, champsim::address{0xcafe0000});
+    load.instr_id = 2;
+
+    uut.DISPATCH_BUFFER.push_back(store);
+    uut.DISPATCH_BUFFER.push_back(load);
+    for (auto& instr : uut.DISPATCH_BUFFER)
+      instr.ready_time = champsim::chrono::clock::time_point{};
+
+    WHEN("The core runs until all instructions retire")
+    {
+      for (int i = 0; i < 10000 && uut.num_retired < 2; ++i) {
+        for (auto op : std::array<champsim::operable*, 3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("The load does not overlap the store, and is issued to the cache")
+      {
+        REQUIRE(uut.num_retired == 2);
+        REQUIRE(std::count(std::begin(mock_L1D.addresses), std::end(mock_L1D.addresses), champsim::address{0xcafe0000}) == 1);
+        REQUIRE(std::count(std::begin(mock_L1D.addresses), std::end(mock_L1D.addresses), champsim::address{0xcafe0004}) == 1);
+      }
+    }
+  }
+}
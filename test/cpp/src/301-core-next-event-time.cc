@@ -0,0 +1,108 @@
+#include <catch.hpp>
+
+#include "defaults.hpp"
+#include "instr.h"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+
+namespace
+{
+std::vector<ooo_model_instr> mixed_instructions(std::size_t count)
+{
+  std::vector<ooo_model_instr> retval{};
+  for (std::size_t i = 0; i < count; ++i) {
+    switch (i % 3) {
+    case 0:
+      retval.push_back(champsim::test::instruction_with_ip_and_source_memory(champsim::address{0x1000 + 4 * i}, champsim::address{0xcafe0000 + 0x1000 * i}));
+      break;
+    case 1:
+      retval.push_back(champsim::test::instruction_with_registers(static_cast<uint8_t>(20 + i % 2)));
+      break;
+    default:
+      retval.push_back(champsim::test::instruction_with_ip(0x1000 + 4 * i));
+    }
+    retval.back().instr_id = i;
+  }
+  return retval;
+}
+
+auto core_with_latency(do_nothing_MRC& mock_L1I, do_nothing_MRC& mock_L1D, unsigned latency)
+{
+  return champsim::core_builder{champsim::defaults::default_core}
+      .fetch_queues(&mock_L1I.queues)
+      .data_queues(&mock_L1D.queues)
+      .decode_latency(latency)
+      .dispatch_latency(latency)
+      .schedule_latency(latency)
+      .execute_latency(latency);
+}
+} // namespace
+
+SCENARIO("Skipping the cycles in which a core has no event does not change its results")
+{
+  GIVEN("Two identical cores with slow caches")
+  {
+    const auto latency = GENERATE(1u, 10u);
+    const auto memory_latency = GENERATE(1, 50);
+    do_nothing_MRC stepped_L1I{memory_latency}, stepped_L1D{memory_latency}, skipped_L1I{memory_latency}, skipped_L1D{memory_latency};
+    O3_CPU stepped{core_with_latency(stepped_L1I, stepped_L1D, latency)};
+    O3_CPU skipped{core_with_latency(skipped_L1I, skipped_L1D, latency)};
+
+    std::vector<champsim::operable*> stepped_elements{{&stepped, &stepped_L1I, &stepped_L1D}};
+    std::vector<champsim::operable*> skipped_elements{{&skipped, &skipped_L1I, &skipped_L1D}};
+
+    for (auto elem : {&stepped, &skipped}) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("The same instructions are run through each, and one is skipped when it reports no event")
+    {
+      auto instructions = mixed_instructions(64);
+      for (auto& instr : instructions) {
+        stepped.input_queue.push_back(instr);
+        skipped.input_queue.push_back(instr);
+      }
+
+      std::vector<long long> stepped_retired{};
+      std::vector<long long> skipped_retired{};
+      long skip_count = 0;
+      for (int i = 0; i < 10000; ++i) {
+        for (auto elem : stepped_elements) {
+          elem->_operate();
+        }
+        if (operate_or_skip(skipped, skipped_elements)) {
+          ++skip_count;
+        }
+
+        stepped_retired.push_back(stepped.num_retired);
+        skipped_retired.push_back(skipped.num_retired);
+      }
+
+      stepped.end_phase(0);
+      skipped.end_phase(0);
+
+      THEN("Some cycles were skipped") { REQUIRE(skip_count > 0); }
+
+      THEN("Every instruction retires in the same cycle")
+      {
+        REQUIRE(stepped.num_retired == std::size(instructions));
+        REQUIRE(stepped_retired == skipped_retired);
+      }
+
+      THEN("The same memory accesses are made")
+      {
+        REQUIRE(stepped_L1I.addresses == skipped_L1I.addresses);
+        REQUIRE(stepped_L1D.addresses == skipped_L1D.addresses);
+      }
+
+      THEN("The statistics are the same")
+      {
+        REQUIRE(stepped.sim_stats.instrs() == skipped.sim_stats.instrs());
+        REQUIRE(stepped.sim_stats.cycles() == skipped.sim_stats.cycles());
+        REQUIRE(stepped.sim_stats.total_rob_occupancy_at_branch_mispredict == skipped.sim_stats.total_rob_occupancy_at_branch_mispredict);
+      }
+    }
+  }
+}
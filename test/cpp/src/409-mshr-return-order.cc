@@ -0,0 +1,91 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A cache fills misses in the order their data returns")
+{
+  GIVEN("A cache with three misses outstanding")
+  {
+    constexpr auto hit_latency = 2;
+    constexpr auto fill_latency = 1;
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("409-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .hit_latency(hit_latency)
+                  .fill_latency(fill_latency)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    std::array<champsim::address, 3> addresses{{champsim::address{0xdeadbeef}, champsim::address{0xcafebabe}, champsim::address{0xfeedf00d}}};
+    uint64_t id = 1;
+    for (auto addr : addresses) {
+      decltype(mock_ul)::request_type test;
+      test.address = addr;
+      test.cpu = 0;
+      test.instr_id = id++;
+      test.type = access_type::LOAD;
+      mock_ul.issue(test);
+    }
+
+    for (uint64_t i = 0; i < 2 * hit_latency + 4; ++i)
+      for (auto elem : elements)
+        elem->_operate();
+
+    REQUIRE(uut.get_mshr_occupancy() == 3);
+
+    // The upper level reorders its packets as they return
+    auto return_time = [&](champsim::address addr) {
+      return std::find_if(std::begin(mock_ul.packets), std::end(mock_ul.packets), [addr](const auto& x) { return x.pkt.address == addr; })->return_time;
+    };
+
+    WHEN("The last and first misses return, in that order")
+    {
+      mock_ll.release(addresses.at(2));
+      for (auto elem : elements)
+        elem->_operate();
+      mock_ll.release(addresses.at(0));
+
+      for (uint64_t i = 0; i < 2 * fill_latency + 4; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("They are filled in the order they returned")
+      {
+        REQUIRE(return_time(addresses.at(2)) > 0);
+        REQUIRE(return_time(addresses.at(0)) > return_time(addresses.at(2)));
+      }
+
+      THEN("Only the remaining miss is held in the MSHR")
+      {
+        REQUIRE(uut.get_mshr_occupancy() == 1);
+        REQUIRE(return_time(addresses.at(1)) == 0);
+      }
+
+      AND_WHEN("The remaining miss returns")
+      {
+        mock_ll.release(addresses.at(1));
+
+        for (uint64_t i = 0; i < 2 * fill_latency + 4; ++i)
+          for (auto elem : elements)
+            elem->_operate();
+
+        THEN("It is filled, and the MSHR is empty")
+        {
+          REQUIRE(return_time(addresses.at(1)) > return_time(addresses.at(0)));
+          REQUIRE(uut.get_mshr_occupancy() == 0);
+        }
+      }
+    }
+  }
+}
@@ -321,3 +321,46 @@ SCENARIO("Translating cache queues forward RQ virtual to physical RQ")
     }
   }
 }
+
+SCENARIO("Cache queues merge with packets checked in an earlier cycle")
+{
+  GIVEN("A read queue with two checked packets")
+  {
+    champsim::address address{0xdeadbeef};
+    champsim::address other_address{0xcafebabe};
+    champsim::channel uut{32, 32, 32, champsim::data::bits{LOG2_BLOCK_SIZE}, false};
+
+    issue(uut, other_address, issue_rq<decltype(uut)>);
+    issue(uut, address, issue_rq<decltype(uut)>);
+    uut.check_collision();
+
+    WHEN("A packet with the same address as the second is sent")
+    {
+      issue(uut, address, issue_rq<decltype(uut)>);
+      uut.check_collision();
+
+      THEN("The packet is merged with the second")
+      {
+        CHECK(uut.rq_occupancy() == 2);
+        CHECK(uut.RQ.back().address == address);
+        REQUIRE(uut.sim_stats.RQ_MERGED == 1);
+      }
+    }
+
+    WHEN("The first packet leaves the queue, and packets with both addresses are sent")
+    {
+      uut.RQ.erase(std::begin(uut.RQ));
+      issue(uut, other_address, issue_rq<decltype(uut)>);
+      issue(uut, address, issue_rq<decltype(uut)>);
+      uut.check_collision();
+
+      THEN("Only the packet whose match remains is merged")
+      {
+        CHECK(uut.rq_occupancy() == 2);
+        CHECK(uut.RQ.front().address == address);
+        CHECK(uut.RQ.back().address == other_address);
+        REQUIRE(uut.sim_stats.RQ_MERGED == 1);
+      }
+    }
+  }
+}
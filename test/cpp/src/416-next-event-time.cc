@@ -0,0 +1,117 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A cache reports when its next event will occur")
+{
+  GIVEN("An empty cache")
+  {
+    constexpr auto hit_latency = 7;
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("416-uut")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .hit_latency(hit_latency)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    THEN("The cache has no pending event") { REQUIRE(uut.next_event_time() == champsim::chrono::clock::time_point::max()); }
+
+    WHEN("A packet is issued")
+    {
+      decltype(mock_ul)::request_type seed;
+      seed.address = champsim::address{0xdeadbeef};
+      seed.is_translated = true;
+      seed.instr_id = 1;
+      seed.cpu = 0;
+      seed.type = access_type::LOAD;
+
+      auto seed_result = mock_ul.issue(seed);
+      THEN("This issue is received") { REQUIRE(seed_result); }
+
+      THEN("The cache must operate in the next cycle") { REQUIRE(uut.next_event_time() == uut.current_time + uut.clock_period); }
+
+      AND_WHEN("The packet begins its tag check")
+      {
+        for (auto elem : elements) {
+          elem->_operate();
+        }
+
+        THEN("The next event is the end of the tag check")
+        {
+          REQUIRE(uut.next_event_time() == uut.current_time + hit_latency * uut.clock_period);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A cache whose MSHR is full retries its tag check in every cycle")
+{
+  GIVEN("A cache with a single MSHR")
+  {
+    constexpr auto hit_latency = 3;
+    release_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("416-uut-mshr")
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)
+                  .hit_latency(hit_latency)
+                  .mshr_size(1)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Two misses to different blocks are issued")
+    {
+      for (auto addr : {0xdeadbeef, 0xcafebabe}) {
+        decltype(mock_ul)::request_type seed;
+        seed.address = champsim::address{addr};
+        seed.is_translated = true;
+        seed.instr_id = 1;
+        seed.cpu = 0;
+        seed.type = access_type::LOAD;
+        REQUIRE(mock_ul.issue(seed));
+      }
+
+      for (auto i = 0; i < 2 * hit_latency + 10; ++i) {
+        for (auto elem : elements)
+          elem->_operate();
+      }
+
+      THEN("Only the first miss is sent to the lower level") { REQUIRE(mock_ll.packet_count() == 1); }
+
+      THEN("The cache must operate in the next cycle") { REQUIRE(uut.next_event_time() == uut.current_time + uut.clock_period); }
+
+      AND_WHEN("The first miss returns")
+      {
+        mock_ll.release_all();
+
+        THEN("The cache must operate in the next cycle") { REQUIRE(uut.next_event_time() == uut.current_time + uut.clock_period); }
+
+        for (auto i = 0; i < 2 * hit_latency + 10; ++i) {
+          for (auto elem : elements)
+            elem->_operate();
+        }
+
+        THEN("The second miss is sent to the lower level") { REQUIRE(mock_ll.packet_count() == 2); }
+      }
+    }
+  }
+}
@@ -0,0 +1,96 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A functional access fills the cache without advancing time")
+{
+  GIVEN("An empty cache")
+  {
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("417-uut")
+                  .sets(1)
+                  .ways(1)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = true;
+      elem->begin_phase();
+    }
+
+    std::vector<champsim::channel::request_type> forwarded{};
+    champsim::functional_forward_type forward = [&](champsim::channel* ch, const champsim::channel::request_type& pkt) {
+      CHECK(ch == &mock_ll.queues);
+      forwarded.push_back(pkt);
+      return champsim::address{0xfeed};
+    };
+
+    WHEN("A load is accessed functionally")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      test.type = access_type::LOAD;
+
+      auto data = uut.functional_access(test, forward);
+
+      THEN("The miss is forwarded to the lower level")
+      {
+        REQUIRE(std::size(forwarded) == 1);
+        CHECK(forwarded.front().address == champsim::address{0xdeadbeef});
+        CHECK(data == champsim::address{0xfeed});
+        CHECK(uut.sim_stats.misses.value_or(std::pair{test.type, test.cpu}, 0) == 1);
+      }
+
+      THEN("Nothing is placed in the queues")
+      {
+        CHECK(mock_ll.packet_count() == 0);
+        CHECK(uut.get_mshr_occupancy() == 0);
+      }
+
+      AND_WHEN("The same address is accessed again")
+      {
+        auto second_data = uut.functional_access(test, forward);
+
+        THEN("The access hits and returns the filled data")
+        {
+          CHECK(std::size(forwarded) == 1);
+          CHECK(second_data == champsim::address{0xfeed});
+          CHECK(uut.sim_stats.hits.value_or(std::pair{test.type, test.cpu}, 0) == 1);
+        }
+      }
+    }
+
+    WHEN("A dirty block is evicted by a functional access")
+    {
+      decltype(mock_ul)::request_type seed;
+      seed.address = champsim::address{0xdeadbeef};
+      seed.cpu = 0;
+      seed.type = access_type::WRITE;
+      uut.functional_access(seed, forward);
+
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xcafebabe};
+      test.cpu = 0;
+      test.type = access_type::LOAD;
+      uut.functional_access(test, forward);
+
+      THEN("The writeback is forwarded to the lower level")
+      {
+        REQUIRE(std::size(forwarded) == 2);
+        CHECK(forwarded.front().address == champsim::address{0xcafebabe});
+        CHECK(forwarded.back().type == access_type::WRITE);
+        CHECK(forwarded.back().address == champsim::address{0xdeadbeef});
+      }
+    }
+  }
+}
@@ -0,0 +1,129 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <sstream>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+
+SCENARIO("A shadow cache sees the accesses of its parent")
+{
+  GIVEN("A one-way cache with a two-way shadow")
+  {
+    constexpr auto hit_latency = 4;
+    do_nothing_MRC mock_ll;
+    to_rq_MRP mock_ul;
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                  .name("418-uut")
+                  .sets(1)
+                  .ways(1)
+                  .hit_latency(hit_latency)
+                  .upper_levels({&mock_ul.queues})
+                  .lower_level(&mock_ll.queues)};
+    CACHE shadow{champsim::cache_builder{champsim::defaults::default_l2c}.name("418-shadow").sets(1).ways(2)};
+    uut.add_shadow(shadow);
+
+    std::array<champsim::operable*, 3> elements{{&uut, &mock_ll, &mock_ul}};
+
+    for (auto elem : elements) {
+      elem->initialize();
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("A packet is issued")
+    {
+      decltype(mock_ul)::request_type test;
+      test.address = champsim::address{0xdeadbeef};
+      test.cpu = 0;
+      test.type = access_type::LOAD;
+
+      auto test_result = mock_ul.issue(test);
+      THEN("This issue is received") { REQUIRE(test_result); }
+
+      for (uint64_t i = 0; i < hit_latency + 1; ++i)
+        for (auto elem : elements)
+          elem->_operate();
+
+      THEN("Both the parent and the shadow record a miss")
+      {
+        CHECK(uut.sim_stats.misses.value_or(std::pair{test.type, test.cpu}, 0) == 1);
+        CHECK(shadow.sim_stats.misses.value_or(std::pair{test.type, test.cpu}, 0) == 1);
+      }
+
+      THEN("Only the parent sends the miss to the lower level") { CHECK(mock_ll.packet_count() == 1); }
+    }
+
+    WHEN("Two addresses are accessed alternately")
+    {
+      champsim::functional_forward_type forward = [](champsim::channel*, const champsim::channel::request_type& pkt) { return pkt.address; };
+
+      for (auto addr : {0xdeadbeef, 0xcafebabe, 0xdeadbeef}) {
+        decltype(mock_ul)::request_type test;
+        test.address = champsim::address{addr};
+        test.cpu = 0;
+        test.type = access_type::LOAD;
+        uut.functional_access(test, forward);
+      }
+
+      THEN("The parent misses on every access")
+      {
+        CHECK(uut.sim_stats.misses.value_or(std::pair{access_type::LOAD, 0}, 0) == 3);
+        CHECK(uut.sim_stats.hits.value_or(std::pair{access_type::LOAD, 0}, 0) == 0);
+      }
+
+      THEN("The larger shadow hits on the repeated address")
+      {
+        CHECK(shadow.sim_stats.misses.value_or(std::pair{access_type::LOAD, 0}, 0) == 2);
+        CHECK(shadow.sim_stats.hits.value_or(std::pair{access_type::LOAD, 0}, 0) == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("Shadow caches are restored from a checkpoint by name")
+{
+  GIVEN("A checkpoint of a cache with only the second of two shadows")
+  {
+    champsim::functional_forward_type forward = [](champsim::channel*, const champsim::channel::request_type& pkt) { return pkt.address; };
+    const champsim::address accessed{0xdeadbeef};
+
+    CACHE saved{champsim::cache_builder{champsim::defaults::default_l2c}.name("418-saved").sets(1).ways(1)};
+    CACHE saved_shadow{champsim::cache_builder{champsim::defaults::default_l2c}.name("418-second").sets(1).ways(2)};
+    saved.add_shadow(saved_shadow);
+    saved.initialize();
+
+    champsim::channel::request_type test;
+    test.address = accessed;
+    test.cpu = 0;
+    test.type = access_type::LOAD;
+    saved.functional_access(test, forward);
+
+    std::stringstream checkpoint;
+    saved.checkpoint(checkpoint);
+
+    WHEN("It is restored into a cache with both shadows")
+    {
+      CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}.name("418-restored").sets(1).ways(1)};
+      CACHE first{champsim::cache_builder{champsim::defaults::default_l2c}.name("418-first").sets(1).ways(2)};
+      CACHE second{champsim::cache_builder{champsim::defaults::default_l2c}.name("418-second").sets(1).ways(2)};
+      uut.add_shadow(first);
+      uut.add_shadow(second);
+      uut.initialize();
+      uut.restore(checkpoint);
+
+      auto holds_accessed = [&](const CACHE& cache) {
+        const auto& blocks = cache.get_blocks();
+        return std::any_of(std::begin(blocks), std::end(blocks), [&](const auto& block) {
+          return block.valid && champsim::block_number{block.address} == champsim::block_number{accessed};
+        });
+      };
+
+      THEN("The shadow in the checkpoint is restored, and the other starts cold")
+      {
+        CHECK(holds_accessed(second));
+        CHECK_FALSE(holds_accessed(first));
+      }
+    }
+  }
+}
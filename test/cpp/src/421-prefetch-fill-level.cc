@@ -85,7 +85,7 @@ SCENARIO("A prefetch can be issued without creating an MSHR")
 
       THEN("The packet is forwarded without an MSHR being created")
       {
-        REQUIRE(std::empty(uut.MSHR));
+        REQUIRE(std::empty(uut.get_mshr()));
         REQUIRE(mock_ll.packet_count() == 1);
       }
     }
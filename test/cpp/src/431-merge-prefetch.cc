@@ -62,9 +62,9 @@ SCENARIO("A prefetch that hits an MSHR is dropped")
 
     THEN("An MSHR is created")
     {
-      REQUIRE_THAT(testbed.uut.MSHR, Catch::Matchers::SizeIs(1));
-      CHECK(testbed.uut.MSHR.front().instr_id == 0);
-      CHECK_THAT(testbed.uut.MSHR.front().to_return, Catch::Matchers::SizeIs(1));
+      REQUIRE_THAT(testbed.uut.get_mshr(), Catch::Matchers::SizeIs(1));
+      CHECK(testbed.uut.get_mshr().front().instr_id == 0);
+      CHECK_THAT(testbed.uut.get_mshr().front().to_return, Catch::Matchers::SizeIs(1));
     }
 
     WHEN("A prefetch is issued")
@@ -73,9 +73,9 @@ SCENARIO("A prefetch that hits an MSHR is dropped")
 
       THEN("The " + std::string{str} + " is in the MSHR")
       {
-        REQUIRE_THAT(testbed.uut.MSHR, Catch::Matchers::SizeIs(1));
-        CHECK(testbed.uut.MSHR.front().instr_id == 0);
-        CHECK_THAT(testbed.uut.MSHR.front().to_return, Catch::Matchers::SizeIs(2));
+        REQUIRE_THAT(testbed.uut.get_mshr(), Catch::Matchers::SizeIs(1));
+        CHECK(testbed.uut.get_mshr().front().instr_id == 0);
+        CHECK_THAT(testbed.uut.get_mshr().front().to_return, Catch::Matchers::SizeIs(2));
       }
     }
   }
@@ -93,29 +93,29 @@ SCENARIO("A prefetch MSHR that gets hit is promoted")
 
     THEN("An MSHR is created")
     {
-      REQUIRE_THAT(testbed.uut.MSHR, Catch::Matchers::SizeIs(1));
-      CHECK(testbed.uut.MSHR.front().instr_id == 0);
-      CHECK_THAT(testbed.uut.MSHR.front().to_return, Catch::Matchers::SizeIs(1));
+      REQUIRE_THAT(testbed.uut.get_mshr(), Catch::Matchers::SizeIs(1));
+      CHECK(testbed.uut.get_mshr().front().instr_id == 0);
+      CHECK_THAT(testbed.uut.get_mshr().front().to_return, Catch::Matchers::SizeIs(1));
     }
 
     WHEN("A " + std::string{str} + " is issued")
     {
-      auto old_time_enqueued = testbed.uut.MSHR.front().time_enqueued;
+      auto old_time_enqueued = testbed.uut.get_mshr().front().time_enqueued;
 
       testbed.issue_type(type);
 
       THEN("The " + std::string{str} + " is in the MSHR")
       {
-        REQUIRE_THAT(testbed.uut.MSHR, Catch::Matchers::SizeIs(1));
-        CHECK(testbed.uut.MSHR.front().time_enqueued > old_time_enqueued);
-        // CHECK(testbed.uut.MSHR.front().instr_id == 1);
-        CHECK_THAT(testbed.uut.MSHR.front().to_return, Catch::Matchers::SizeIs(2));
+        REQUIRE_THAT(testbed.uut.get_mshr(), Catch::Matchers::SizeIs(1));
+        CHECK(testbed.uut.get_mshr().front().time_enqueued > old_time_enqueued);
+        // CHECK(testbed.uut.get_mshr().front().instr_id == 1);
+        CHECK_THAT(testbed.uut.get_mshr().front().to_return, Catch::Matchers::SizeIs(2));
       }
 
       AND_WHEN("The MSHR is closed")
       {
-        champsim::channel::response_type response{testbed.uut.MSHR.front().address, testbed.uut.MSHR.front().v_address,
-                                                  testbed.uut.MSHR.front().data_promise->data, 0, testbed.uut.MSHR.front().instr_depend_on_me};
+        champsim::channel::response_type response{testbed.uut.get_mshr().front().address, testbed.uut.get_mshr().front().v_address,
+                                                  testbed.uut.get_mshr().front().data_promise->data, 0, testbed.uut.get_mshr().front().instr_depend_on_me};
 
         testbed.uut.lower_level->returned.push_back(response);
         for (uint64_t i = 0; i < 8 * (testbed.hit_latency); ++i)
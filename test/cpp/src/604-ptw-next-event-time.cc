@@ -0,0 +1,106 @@
+#include <catch.hpp>
+
+#include "defaults.hpp"
+#include "dram_controller.h"
+#include "mocks.hpp"
+#include "ptw.h"
+#include "vmem.h"
+
+namespace
+{
+MEMORY_CONTROLLER make_dram()
+{
+  return MEMORY_CONTROLLER{champsim::chrono::picoseconds{3200},
+                           champsim::chrono::picoseconds{6400},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{18},
+                           std::size_t{38},
+                           champsim::chrono::microseconds{64000},
+                           {},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           1024,
+                           1024,
+                           4,
+                           4,
+                           4,
+                           8192};
+}
+} // namespace
+
+SCENARIO("A page table walker that skips idle cycles behaves as one that operates in every cycle")
+{
+  GIVEN("Two identical page table walkers")
+  {
+    constexpr std::size_t levels = 5;
+    auto dram_stepped = make_dram();
+    auto dram_skipped = make_dram();
+    VirtualMemory vmem_stepped{champsim::data::bytes{1 << 12}, levels, champsim::chrono::nanoseconds{640}, dram_stepped};
+    VirtualMemory vmem_skipped{champsim::data::bytes{1 << 12}, levels, champsim::chrono::nanoseconds{640}, dram_skipped};
+    do_nothing_MRC mock_ll_stepped{20};
+    do_nothing_MRC mock_ll_skipped{20};
+    to_rq_MRP mock_ul_stepped;
+    to_rq_MRP mock_ul_skipped;
+
+    auto builder = champsim::ptw_builder{champsim::defaults::default_ptw}
+                       .name("604-uut")
+                       .clock_period(champsim::chrono::picoseconds{3200})
+                       .tag_bandwidth(champsim::bandwidth::maximum_type{2})
+                       .fill_bandwidth(champsim::bandwidth::maximum_type{2});
+    PageTableWalker stepped{
+        champsim::ptw_builder{builder}.upper_levels({&mock_ul_stepped.queues}).lower_level(&mock_ll_stepped.queues).virtual_memory(&vmem_stepped)};
+    PageTableWalker skipped{
+        champsim::ptw_builder{builder}.upper_levels({&mock_ul_skipped.queues}).lower_level(&mock_ll_skipped.queues).virtual_memory(&vmem_skipped)};
+
+    std::vector<champsim::operable*> stepped_elements{{&mock_ul_stepped, &stepped, &mock_ll_stepped}};
+    std::vector<champsim::operable*> skipped_elements{{&mock_ul_skipped, &skipped, &mock_ll_skipped}};
+
+    for (auto elem : {&stepped, &skipped}) {
+      elem->warmup = false;
+      elem->begin_phase();
+    }
+
+    WHEN("Both receive the same requests")
+    {
+      long skip_count = 0;
+      for (auto i = 0; i < 10000; ++i) {
+        if (i % 300 == 0 && i < 3000) {
+          decltype(mock_ul_stepped)::request_type test;
+          test.address = champsim::address{0xdeadbeef0000 + static_cast<unsigned long long>(i) * 0x10'1000};
+          test.v_address = test.address;
+          test.cpu = 0;
+          REQUIRE(mock_ul_stepped.issue(test));
+          REQUIRE(mock_ul_skipped.issue(test));
+        }
+
+        for (auto elem : stepped_elements)
+          elem->_operate();
+        if (operate_or_skip(skipped, skipped_elements))
+          ++skip_count;
+      }
+
+      THEN("The skipped walker was idle for some cycles")
+      {
+        REQUIRE(skip_count > 0);
+      }
+
+      THEN("The walks are issued to the lower level identically")
+      {
+        REQUIRE(mock_ll_stepped.packet_count() == mock_ll_skipped.packet_count());
+        REQUIRE(mock_ll_stepped.addresses == mock_ll_skipped.addresses);
+      }
+
+      THEN("The translations return in the same cycles")
+      {
+        REQUIRE(std::size(mock_ul_stepped.packets) == std::size(mock_ul_skipped.packets));
+        for (std::size_t i = 0; i < std::size(mock_ul_stepped.packets); ++i) {
+          REQUIRE(mock_ul_stepped.packets.at(i).return_time > 0);
+          REQUIRE(mock_ul_stepped.packets.at(i).return_time == mock_ul_skipped.packets.at(i).return_time);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,101 @@
+#include <catch.hpp>
+
+#include "defaults.hpp"
+#include "dram_controller.h"
+#include "mocks.hpp"
+
+namespace
+{
+MEMORY_CONTROLLER make_controller(champsim::channel* ul)
+{
+  return MEMORY_CONTROLLER{champsim::chrono::picoseconds{312},
+                           champsim::chrono::picoseconds{624},
+                           std::size_t{24},
+                           std::size_t{24},
+                           std::size_t{24},
+                           std::size_t{52},
+                           champsim::chrono::microseconds{32000},
+                           {ul},
+                           64,
+                           64,
+                           1,
+                           champsim::data::bytes{8},
+                           65536,
+                           1024,
+                           1,
+                           8,
+                           4,
+                           16384};
+}
+} // namespace
+
+SCENARIO("A memory controller that skips idle cycles behaves as one that operates in every cycle")
+{
+  GIVEN("Two identical memory controllers")
+  {
+    to_rq_MRP mock_ul_stepped;
+    to_rq_MRP mock_ul_skipped;
+    auto stepped = make_controller(&mock_ul_stepped.queues);
+    auto skipped = make_controller(&mock_ul_skipped.queues);
+
+    std::vector<champsim::operable*> stepped_elements{{&mock_ul_stepped, &stepped}};
+    std::vector<champsim::operable*> skipped_elements{{&mock_ul_skipped, &skipped}};
+
+    for (auto* mc : {&stepped, &skipped}) {
+      mc->warmup = false;
+      for (auto& chan : mc->channels)
+        chan.warmup = false;
+      mc->initialize();
+      mc->begin_phase();
+    }
+
+    WHEN("Both receive the same sparse requests across several refresh intervals")
+    {
+      long skip_count = 0;
+      for (auto i = 0; i < 20000; ++i) {
+        if (i % 97 == 0 && i < 15000) {
+          decltype(mock_ul_stepped)::request_type test;
+          test.address = champsim::address{0x10000000 + static_cast<unsigned long long>(i) * 0x1'0040};
+          test.v_address = champsim::address{};
+          test.cpu = 0;
+          test.response_requested = true;
+          REQUIRE(mock_ul_stepped.issue(test));
+          REQUIRE(mock_ul_skipped.issue(test));
+        }
+
+        for (auto elem : stepped_elements)
+          elem->_operate();
+        if (operate_or_skip(skipped, skipped_elements))
+          ++skip_count;
+      }
+
+      THEN("The skipped controller was idle for some cycles")
+      {
+        REQUIRE(skip_count > 0);
+      }
+
+      THEN("The requests return in the same cycles")
+      {
+        REQUIRE(std::size(mock_ul_stepped.packets) == std::size(mock_ul_skipped.packets));
+        for (std::size_t i = 0; i < std::size(mock_ul_stepped.packets); ++i) {
+          REQUIRE(mock_ul_stepped.packets.at(i).return_time > 0);
+          REQUIRE(mock_ul_stepped.packets.at(i).return_time == mock_ul_skipped.packets.at(i).return_time);
+        }
+      }
+
+      THEN("The statistics are identical")
+      {
+        const auto& lhs = stepped.channels.at(0).sim_stats;
+        const auto& rhs = skipped.channels.at(0).sim_stats;
+        REQUIRE(lhs.refresh_cycles > 0);
+        CHECK(lhs.dbus_cycle_congested == rhs.dbus_cycle_congested);
+        CHECK(lhs.dbus_count_congested == rhs.dbus_count_congested);
+        CHECK(lhs.refresh_cycles == rhs.refresh_cycles);
+        CHECK(lhs.RQ_ROW_BUFFER_HIT == rhs.RQ_ROW_BUFFER_HIT);
+        CHECK(lhs.RQ_ROW_BUFFER_MISS == rhs.RQ_ROW_BUFFER_MISS);
+        CHECK(lhs.WQ_ROW_BUFFER_HIT == rhs.WQ_ROW_BUFFER_HIT);
+        CHECK(lhs.WQ_ROW_BUFFER_MISS == rhs.WQ_ROW_BUFFER_MISS);
+      }
+    }
+  }
+}
@@ -2,6 +2,7 @@
 #include <exception>
 #include <functional>
 #include <limits>
+#include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_templated.hpp>
 
@@ -279,3 +280,23 @@ struct to_pq_MRP final : public queue_issue_MRP {
     return queues.add_pq(pkt);
   }
 };
+
+/*
+ * Advance each of the elements by one cycle, in order. The unit under test is skipped instead of operated whenever it reports
+ * that it has no event in that cycle, so that its results can be compared against operating it in every cycle.
+ *
+ * Returns whether the unit was skipped.
+ */
+inline bool operate_or_skip(champsim::operable& uut, const std::vector<champsim::operable*>& elements)
+{
+  bool skipped = false;
+  for (auto elem : elements) {
+    if (elem == &uut && uut.next_event_time() > uut.current_time + uut.clock_period) {
+      uut._skip(1);
+      skipped = true;
+    } else {
+      elem->_operate();
+    }
+  }
+  return skipped;
+}
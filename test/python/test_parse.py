@@ -321,6 +321,49 @@ class ParseNormalizedTests(unittest.TestCase):
                 module_names = [c.get(module_key) for c in caches]
                 self.assertNotIn(None, module_names)
 
+    def test_mrc_flag_is_converted_to_a_sample_rate(self):
+        for given, expected in ((True, 0.01), (False, 0), (0.5, 0.5), (1, 1)):
+            with self.subTest(mrc=given):
+                test_config = config.parse.NormalizedConfiguration({ 'LLC': { 'mrc': given } })
+
+                result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+                caches = {c['name']: c for c in result[0]['caches']}
+
+                self.assertEqual(caches['LLC']['mrc'], expected)
+                self.assertIs(type(caches['LLC']['mrc']), type(expected))
+
+    def test_shadows_inherit_from_their_cache(self):
+        test_config = config.parse.NormalizedConfiguration({ 'LLC': { 'sets': 2048, 'ways': 16, 'shadows': [{ 'ways': 8 }, { 'replacement': 'srrip' }] } })
+
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        caches = {c['name']: c for c in result[0]['caches']}
+
+        self.assertEqual(caches['LLC_shadow0']['_shadow_of'], 'LLC')
+        self.assertEqual(caches['LLC_shadow0']['sets'], 2048)
+        self.assertEqual(caches['LLC_shadow0']['ways'], 8)
+        self.assertEqual(caches['LLC_shadow1']['ways'], 16)
+        self.assertEqual([d['name'] for d in caches['LLC_shadow1']['_replacement_data']], ['srrip'])
+
+    def test_shadows_have_no_lower_level(self):
+        test_config = config.parse.NormalizedConfiguration({ 'LLC': { 'shadows': [{}] } })
+
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        caches = {c['name']: c for c in result[0]['caches']}
+
+        self.assertIn('LLC_shadow0', caches)
+        self.assertNotIn('lower_level', caches['LLC_shadow0'])
+        self.assertNotIn('lower_translate', caches['LLC_shadow0'])
+
+    def test_shadows_with_a_size_do_not_inherit_sets(self):
+        test_config = config.parse.NormalizedConfiguration({ 'LLC': { 'sets': 2048, 'ways': 16, 'shadows': [{ 'size': '4MB' }] } })
+
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        caches = {c['name']: c for c in result[0]['caches']}
+
+        self.assertNotIn('sets', caches['LLC_shadow0'])
+        self.assertEqual(caches['LLC_shadow0']['size'], 4*1024*1024)
+        self.assertEqual(caches['LLC_shadow0']['ways'], 16)
+
 class NormalizeConfigTest(unittest.TestCase):
 
     def test_empty_config_creates_defaults(self):
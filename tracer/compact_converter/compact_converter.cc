@@ -0,0 +1,78 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../../inc/compact_trace.h"
+#include "../../inc/inf_stream.h"
+#include "../../inc/trace_instruction.h"
+
+namespace
+{
+template <typename Stream>
+void convert(Stream&& in, champsim::compact_trace::encoder& out)
+{
+  std::array<char, 1024 * sizeof(input_instr)> buffer;
+  do {
+    in.read(std::data(buffer), std::size(buffer));
+    for (std::size_t offset = 0; offset + sizeof(input_instr) <= static_cast<std::size_t>(in.gcount()); offset += sizeof(input_instr)) {
+      input_instr instr;
+      std::memcpy(&instr, std::next(std::data(buffer), static_cast<long>(offset)), sizeof(input_instr));
+      out.write(instr);
+    }
+  } while (in.gcount() > 0);
+}
+
+bool ends_with(const std::string& str, const std::string& suffix)
+{
+  return std::size(str) >= std::size(suffix) && str.compare(std::size(str) - std::size(suffix), std::size(suffix), suffix) == 0;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " INPUT_TRACE > OUTPUT_TRACE\n";
+    return 1;
+  }
+
+  std::string input_name{argv[1]};
+  if (!std::ifstream{input_name}) {
+    std::cerr << "Could not open " << input_name << "\n";
+    return 1;
+  }
+
+  champsim::compact_trace::encoder encoder{std::cout};
+
+  if (ends_with(input_name, "gz")) {
+    convert(champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>{input_name}, encoder);
+  } else if (ends_with(input_name, "xz")) {
+    convert(champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>{input_name}, encoder);
+  } else if (ends_with(input_name, "bz2")) {
+    convert(champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>{input_name}, encoder);
+  } else if (ends_with(input_name, "zst")) {
+    convert(champsim::inf_istream<champsim::decomp_tags::zstd_tag_t<>>{input_name}, encoder);
+  } else {
+    convert(std::ifstream{input_name, std::ios::binary}, encoder);
+  }
+
+  std::cout.flush();
+  return std::cout.good() ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../../inc/inf_stream.h"
+#include "../../inc/seekable_zstd.h"
+#include "../../inc/trace_instruction.h"
+
+namespace
+{
+template <typename Stream>
+void convert(Stream&& in, champsim::seekable_zstd::writer& out)
+{
+  std::array<char, 1 << 16> buffer;
+  do {
+    in.read(std::data(buffer), std::size(buffer));
+    out.write(std::data(buffer), static_cast<std::size_t>(in.gcount()));
+  } while (in.gcount() > 0);
+}
+
+bool ends_with(const std::string& str, const std::string& suffix)
+{
+  return std::size(str) >= std::size(suffix) && str.compare(std::size(str) - std::size(suffix), std::size(suffix), suffix) == 0;
+}
+
+void usage(const char* name)
+{
+  std::cerr << "Usage: " << name << " [-c] [-n INSTRUCTIONS_PER_FRAME] [-l LEVEL] INPUT_TRACE OUTPUT_TRACE.zst\n"
+            << "  -c  the trace is in the cloudsuite format\n"
+            << "  -n  the number of instructions in each independently compressed frame (default 65536)\n"
+            << "  -l  the Zstandard compression level (default " << ZSTD_CLEVEL_DEFAULT << ")\n";
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  bool cloudsuite = false;
+  std::size_t frame_instructions = 1 << 16;
+  int level = ZSTD_CLEVEL_DEFAULT;
+  std::array<std::string, 2> files;
+  std::size_t num_files = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg{argv[i]};
+    if (arg == "-c") {
+      cloudsuite = true;
+    } else if (arg == "-n" && i + 1 < argc) {
+      frame_instructions = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "-l" && i + 1 < argc) {
+      level = std::atoi(argv[++i]);
+    } else if (num_files < std::size(files)) {
+      files.at(num_files++) = arg;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (num_files != std::size(files) || frame_instructions == 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  const auto& [input_name, output_name] = files;
+  if (!std::ifstream{input_name}) {
+    std::cerr << "Could not open " << input_name << "\n";
+    return 1;
+  }
+
+  std::ofstream output{output_name, std::ios::binary};
+  champsim::seekable_zstd::writer writer{output, frame_instructions * (cloudsuite ? sizeof(cloudsuite_instr) : sizeof(input_instr)), level};
+
+  if (ends_with(input_name, "gz")) {
+    convert(champsim::inf_istream<champsim::decomp_tags::gzip_tag_t<>>{input_name}, writer);
+  } else if (ends_with(input_name, "xz")) {
+    convert(champsim::inf_istream<champsim::decomp_tags::lzma_tag_t<>>{input_name}, writer);
+  } else if (ends_with(input_name, "bz2")) {
+    convert(champsim::inf_istream<champsim::decomp_tags::bzip2_tag_t>{input_name}, writer);
+  } else if (ends_with(input_name, "zst")) {
+    convert(champsim::inf_istream<champsim::decomp_tags::zstd_tag_t<>>{input_name}, writer);
+  } else {
+    convert(std::ifstream{input_name, std::ios::binary}, writer);
+  }
+
+  writer.close();
+  return output.good() ? 0 : 1;
+}